@@ -0,0 +1,391 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file bench/innodb_aio_bench.cc
+A fio-like benchmark of the InnoDB asynchronous I/O subsystem.
+
+The program submits page sized requests through os_aio() and reaps
+them in I/O handler threads through os_aio_handler(), like the buffer
+pool does, without starting the rest of InnoDB. Every completed request
+is immediately replaced by a new one, so that the number of pending
+requests stays at --iodepth.
+
+Usage:
+innodb_aio_bench [--aio=simulated|native|io_uring] [--rw=randread|
+randwrite|read|write] [--bs=bytes] [--size=bytes] [--iodepth=n]
+[--runtime=seconds] [--read-threads=n] [--write-threads=n] [--direct]
+[--fixed] [--batch] --file=path
+*******************************************************/
+
+#include "univ.i"
+#include "os0file.h"
+#include "os0thread.h"
+#include "srv0conc.h"
+#include "srv0srv.h"
+#include "srv0start.h"
+#include "sync0debug.h"
+#include "ut0rnd.h"
+
+#include <my_sys.h>
+#include <my_atomic.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** list of temporary directories, used by innobase_mysql_tmpfile() */
+extern MY_TMPDIR	mysql_tmpdir_list;
+
+/** Number of slots in the synchronous I/O array, which is not used */
+static const ulint	BENCH_N_SYNC_SLOTS = 100;
+
+/** Workload parameters */
+static struct {
+	/** whether to read or write */
+	bool		write;
+	/** whether to access the file sequentially */
+	bool		sequential;
+	/** size of a request in bytes */
+	ulint		block_size;
+	/** size of the file in bytes */
+	os_offset_t	file_size;
+	/** number of pending requests */
+	ulint		iodepth;
+	/** duration of the measurement in seconds */
+	ulint		runtime;
+	/** whether to register the I/O buffers with io_uring */
+	bool		fixed;
+	/** whether to post the initial requests as one batch */
+	bool		batch;
+	/** name of the data file */
+	const char*	file_name;
+} bench = {
+	false, false, 16384, 1ULL << 30, 32, 10, false, false, NULL
+};
+
+/** A request that is being executed */
+struct bench_request_t {
+	/** I/O buffer */
+	byte*		buf;
+	/** my_interval_timer() at the time of submission */
+	ulonglong	start;
+	/** state of the pseudo random number generator */
+	ulint		rnd;
+	/** next file offset for sequential access */
+	os_offset_t	next;
+};
+
+/** The data file */
+static pfs_os_file_t	bench_file;
+
+/** Whether the measurement is over */
+static volatile bool	bench_stop;
+
+/** Number of pending requests */
+static volatile int32	bench_n_pending;
+
+/** Number of completed requests */
+static volatile int64	bench_n_completed;
+
+/** Total latency of the completed requests, in nanoseconds */
+static volatile int64	bench_latency;
+
+/** Submit a request.
+@param[in,out]	req	request
+@param[in]	wake	whether to submit the request immediately
+@return DB_SUCCESS or error code */
+static
+dberr_t
+bench_submit(bench_request_t* req, bool wake)
+{
+	os_offset_t	n_blocks = bench.file_size / bench.block_size;
+	os_offset_t	offset;
+
+	if (bench.sequential) {
+		offset = req->next;
+		req->next = (req->next + bench.iodepth * bench.block_size)
+			% (n_blocks * bench.block_size);
+	} else {
+		req->rnd = ut_rnd_gen_next_ulint(req->rnd);
+		offset = (req->rnd % n_blocks) * bench.block_size;
+	}
+
+	IORequest	type((bench.write ? IORequest::WRITE : IORequest::READ)
+			     | (wake ? 0 : IORequest::DO_NOT_WAKE));
+
+	req->start = my_interval_timer();
+
+	return(os_aio(type, OS_AIO_NORMAL, bench.file_name, bench_file,
+		      req->buf, offset, bench.block_size, false, NULL, req));
+}
+
+/** I/O handler thread.
+@param[in]	arg	pointer to the number of the segment
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(bench_io_handler_thread)(void* arg)
+{
+	ulint	segment = *static_cast<ulint*>(arg);
+
+	while (srv_shutdown_state != SRV_SHUTDOWN_EXIT_THREADS
+	       || !os_aio_all_slots_free()) {
+		fil_node_t*	m1;
+		void*		m2;
+		IORequest	type;
+
+		dberr_t	err = os_aio_handler(segment, &m1, &m2, &type);
+
+		if (m2 == NULL) {
+			continue;
+		}
+
+		if (err != DB_SUCCESS) {
+			ib::fatal() << "I/O failed: " << ut_strerr(err);
+		}
+
+		bench_request_t*	req = static_cast<bench_request_t*>(m2);
+
+		my_atomic_add64(&bench_n_completed, 1);
+		my_atomic_add64(&bench_latency, int64(my_interval_timer()
+						      - req->start));
+
+		if (bench_stop || bench_submit(req, true) != DB_SUCCESS) {
+			my_atomic_add32(&bench_n_pending, -1);
+		}
+	}
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Parse a size with an optional K, M or G suffix.
+@param[in]	s	string
+@return the size */
+static
+ulonglong
+bench_parse_size(const char* s)
+{
+	char*		end;
+	ulonglong	n = strtoull(s, &end, 10);
+
+	switch (*end) {
+	case 'g': case 'G':
+		n <<= 10;
+		/* fall through */
+	case 'm': case 'M':
+		n <<= 10;
+		/* fall through */
+	case 'k': case 'K':
+		n <<= 10;
+	}
+
+	return(n);
+}
+
+/** Print the usage and exit. */
+static
+void
+bench_usage()
+{
+	fprintf(stderr,
+		"Usage: innodb_aio_bench [--aio=simulated|native|io_uring]"
+		" [--rw=randread|randwrite|read|write] [--bs=bytes]"
+		" [--size=bytes] [--iodepth=n] [--runtime=seconds]"
+		" [--read-threads=n] [--write-threads=n] [--direct]"
+		" [--fixed] [--batch] --file=path\n");
+	exit(1);
+}
+
+int
+main(int argc, char** argv)
+{
+	ulint	n_readers = 4;
+	ulint	n_writers = 4;
+
+	MY_INIT(argv[0]);
+
+	srv_use_native_aio = FALSE;
+
+	for (int i = 1; i < argc; i++) {
+		const char*	arg = argv[i];
+		const char*	val = strchr(arg, '=');
+
+		val = val ? val + 1 : "";
+
+		if (!strncmp(arg, "--aio=", 6)) {
+			srv_use_native_aio = strcmp(val, "simulated") != 0;
+			srv_use_io_uring = !strcmp(val, "io_uring");
+		} else if (!strncmp(arg, "--rw=", 5)) {
+			bench.write = strstr(val, "write") != NULL;
+			bench.sequential = strncmp(val, "rand", 4) != 0;
+		} else if (!strncmp(arg, "--bs=", 5)) {
+			bench.block_size = ulint(bench_parse_size(val));
+		} else if (!strncmp(arg, "--size=", 7)) {
+			bench.file_size = bench_parse_size(val);
+		} else if (!strncmp(arg, "--iodepth=", 10)) {
+			bench.iodepth = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--runtime=", 10)) {
+			bench.runtime = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--read-threads=", 15)) {
+			n_readers = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--write-threads=", 16)) {
+			n_writers = strtoul(val, NULL, 10);
+		} else if (!strcmp(arg, "--direct")) {
+			srv_file_flush_method = SRV_O_DIRECT;
+		} else if (!strcmp(arg, "--fixed")) {
+			bench.fixed = true;
+		} else if (!strcmp(arg, "--batch")) {
+			bench.batch = true;
+		} else if (!strncmp(arg, "--file=", 7)) {
+			bench.file_name = val;
+		} else {
+			bench_usage();
+		}
+	}
+
+	if (!bench.file_name || !bench.iodepth || !n_readers || !n_writers
+	    || n_readers + n_writers + 2 > SRV_MAX_N_IO_THREADS
+	    || bench.block_size < OS_FILE_LOG_BLOCK_SIZE
+	    || bench.block_size % OS_FILE_LOG_BLOCK_SIZE
+	    || bench.file_size < bench.block_size * bench.iodepth) {
+		bench_usage();
+	}
+
+	srv_page_size_shift = UNIV_PAGE_SIZE_SHIFT_DEF;
+	srv_page_size = UNIV_PAGE_SIZE_DEF;
+	srv_max_n_threads = 1000;
+
+	if (init_tmpdir(&mysql_tmpdir_list, NULL)) {
+		return(1);
+	}
+
+	sync_check_init();
+
+	if (!os_aio_init(n_readers, n_writers, BENCH_N_SYNC_SLOTS)) {
+		return(1);
+	}
+
+	bool	success;
+
+	bench_file = os_file_create(
+		innodb_data_file_key, bench.file_name,
+		OS_FILE_OVERWRITE | OS_FILE_ON_ERROR_NO_EXIT,
+		OS_FILE_AIO, OS_DATA_FILE, false, &success);
+
+	if (!success
+	    || !os_file_set_size(bench.file_name, bench_file,
+				 bench.file_size)) {
+		return(1);
+	}
+
+	/* Allocate all I/O buffers in one block, so that they can be
+	registered with io_uring like a buffer pool chunk. */
+	byte*	mem = static_cast<byte*>(
+		ut_malloc_nokey((bench.iodepth + 1) * bench.block_size));
+	byte*	buf = static_cast<byte*>(ut_align(mem, srv_page_size));
+
+	memset(buf, 0, bench.iodepth * bench.block_size);
+
+#ifdef LINUX_IO_URING
+	if (bench.fixed) {
+		os_aio_buffer_t	area = { buf, bench.iodepth
+					 * bench.block_size };
+
+		os_aio_register_buffers(&area, 1);
+	}
+#endif /* LINUX_IO_URING */
+
+	ulint	n_segments = n_readers + n_writers + 2;
+	ulint*	segments = new ulint[n_segments];
+
+	for (ulint i = 0; i < n_segments; i++) {
+		segments[i] = i;
+		os_thread_create(bench_io_handler_thread, &segments[i], NULL);
+	}
+
+	bench_request_t*	reqs = new bench_request_t[bench.iodepth];
+
+	bench_n_pending = int32(bench.iodepth);
+
+	ulonglong	start = my_interval_timer();
+
+	for (ulint i = 0; i < bench.iodepth; i++) {
+		reqs[i].buf = buf + i * bench.block_size;
+		reqs[i].rnd = ut_rnd_gen_next_ulint(i + 1);
+		reqs[i].next = i * bench.block_size;
+
+		if (bench_submit(&reqs[i], !bench.batch) != DB_SUCCESS) {
+			return(1);
+		}
+	}
+
+	if (bench.batch) {
+		/* Like the read-ahead and the page flushing,
+		submit the requests that were posted with
+		IORequest::DO_NOT_WAKE. */
+		os_aio_simulated_wake_handler_threads();
+	}
+
+	os_thread_sleep(bench.runtime * 1000000);
+
+	int64	n_completed = my_atomic_load64(&bench_n_completed);
+	int64	latency = my_atomic_load64(&bench_latency);
+	double	elapsed = double(my_interval_timer() - start) / 1e9;
+
+	bench_stop = true;
+
+	while (my_atomic_load32(&bench_n_pending)) {
+		os_thread_sleep(10000);
+	}
+
+	srv_shutdown_state = SRV_SHUTDOWN_EXIT_THREADS;
+
+	while (os_thread_count) {
+		os_aio_wake_all_threads_at_shutdown();
+		os_thread_sleep(10000);
+	}
+
+	printf("%s: %s bs=" ULINTPF " iodepth=" ULINTPF "\n",
+	       srv_use_io_uring ? "io_uring"
+	       : srv_use_native_aio ? "native" : "simulated",
+	       bench.write
+	       ? (bench.sequential ? "write" : "randwrite")
+	       : (bench.sequential ? "read" : "randread"),
+	       bench.block_size, bench.iodepth);
+	printf("iops=%.0f bw=%.1fMiB/s lat=%.1fus\n",
+	       double(n_completed) / elapsed,
+	       double(n_completed) * double(bench.block_size)
+	       / elapsed / 1048576,
+	       n_completed ? double(latency) / double(n_completed) / 1e3
+	       : 0.0);
+
+	delete[] reqs;
+	delete[] segments;
+
+	os_file_close(bench_file);
+	ut_free(mem);
+
+	os_aio_free();
+	sync_check_close();
+	free_tmpdir(&mysql_tmpdir_list);
+	my_end(0);
+
+	return(0);
+}
@@ -0,0 +1,154 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file bench/innodb_checksum_bench.cc
+A benchmark of the page checksum functions.
+
+The program fills --pages pages of --page-size bytes with pseudo-random
+data and computes the checksums of all of them --rounds times with each
+innodb_checksum_algorithm, the way buf_page_is_corrupted() does when a
+page is read. It reports the throughput of each algorithm.
+
+Usage:
+innodb_checksum_bench [--pages=n] [--page-size=bytes] [--rounds=n]
+*******************************************************/
+
+#include "univ.i"
+#include "buf0checksum.h"
+#include "fil0fil.h"
+#include "ut0crc32.h"
+#include "ut0byte.h"
+#include "ut0new.h"
+#include "ut0rnd.h"
+
+#include <my_sys.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Pages to compute the checksums of */
+static byte*	bench_pages;
+/** Number of pages */
+static ulint	bench_n_pages = 1024;
+/** Number of times to compute the checksums */
+static ulint	bench_rounds = 100;
+
+/** Compute the checksums of all pages bench_rounds times.
+@param[in]	name		name of the algorithm
+@param[in]	checksum	checksum function */
+static
+void
+bench_run(
+	const char*	name,
+	uint32_t	(*checksum)(const byte*))
+{
+	uint32_t	sum = 0;
+	ulonglong	start = my_interval_timer();
+
+	for (ulint r = 0; r < bench_rounds; r++) {
+		for (ulint i = 0; i < bench_n_pages; i++) {
+			sum ^= checksum(bench_pages + i * srv_page_size);
+		}
+	}
+
+	double	elapsed = double(my_interval_timer() - start);
+	double	n = double(bench_rounds * bench_n_pages);
+
+	printf("%-12s %8.1fns/page %6.2fGB/s (%08x)\n",
+	       name, elapsed / n, n * double(srv_page_size) / elapsed, sum);
+}
+
+/** innodb_checksum_algorithm=full_crc32 of a page.
+@param[in]	page	page
+@return checksum */
+static
+uint32_t
+bench_full_crc32(const byte* page)
+{
+	return(ut_crc32(page, srv_page_size - FIL_PAGE_FCRC32_CHECKSUM));
+}
+
+/** Print the usage and exit. */
+static
+void
+bench_usage()
+{
+	fprintf(stderr,
+		"Usage: innodb_checksum_bench [--pages=n] [--page-size=bytes]"
+		" [--rounds=n]\n");
+	exit(1);
+}
+
+int
+main(int argc, char** argv)
+{
+	MY_INIT(argv[0]);
+
+	for (int i = 1; i < argc; i++) {
+		const char*	arg = argv[i];
+		const char*	val = strchr(arg, '=');
+
+		val = val ? val + 1 : "";
+
+		if (!strncmp(arg, "--pages=", 8)) {
+			bench_n_pages = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--page-size=", 12)) {
+			srv_page_size = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--rounds=", 9)) {
+			bench_rounds = strtoul(val, NULL, 10);
+		} else {
+			bench_usage();
+		}
+	}
+
+	if (!bench_n_pages || !bench_rounds
+	    || srv_page_size < UNIV_PAGE_SIZE_MIN
+	    || srv_page_size > UNIV_PAGE_SIZE_MAX
+	    || (srv_page_size & (srv_page_size - 1))) {
+		bench_usage();
+	}
+
+	srv_page_size_shift = ut_2_log(srv_page_size);
+
+	ut_crc32_init();
+
+	byte*	mem = static_cast<byte*>(
+		ut_malloc_nokey((bench_n_pages + 1) * srv_page_size));
+	bench_pages = static_cast<byte*>(ut_align(mem, srv_page_size));
+
+	ulint	rnd = 1;
+
+	for (ulint i = 0; i < bench_n_pages * srv_page_size; i++) {
+		rnd = ut_rnd_gen_next_ulint(rnd);
+		bench_pages[i] = byte(rnd);
+	}
+
+	printf("pages=" ULINTPF " page_size=" ULINTPF " rounds=" ULINTPF
+	       "\n%s\n", bench_n_pages, srv_page_size, bench_rounds,
+	       ut_crc32_implementation);
+
+	bench_run("full_crc32", bench_full_crc32);
+	bench_run("crc32", buf_calc_page_crc32);
+	bench_run("innodb", buf_calc_page_new_checksum);
+
+	ut_free(mem);
+	my_end(0);
+
+	return(0);
+}
@@ -0,0 +1,269 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file bench/innodb_log_bench.cc
+A scalability benchmark of appending mini-transaction logs to log_sys.buf.
+
+Each thread repeatedly appends --log-size bytes of redo log, the way
+mtr_t::commit() does, with 1, 2, 4, ... up to --max-threads threads.
+With --mode=copy, the records are copied after log_sys.mutex has been
+released (log_reserve_for_copy()); with --mode=locked, they are copied
+while holding it (log_write_low()), as before. The log buffer is not
+written to files: when it is full, its contents are discarded the way
+log_buffer_switch() does. The program reports the commits per second for
+each thread count.
+
+Usage:
+innodb_log_bench [--mode=copy|locked|both] [--max-threads=n]
+[--log-size=bytes] [--runtime=seconds]
+*******************************************************/
+
+#include "univ.i"
+#include "log0log.h"
+#include "os0thread.h"
+#include "srv0srv.h"
+#include "srv0start.h"
+#include "sync0debug.h"
+#include "ut0byte.h"
+
+#include <my_sys.h>
+#include <my_atomic.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Length of the log of each mini-transaction */
+static ulint		bench_log_size = 256;
+
+/** Whether to copy the log after releasing log_sys.mutex */
+static bool		bench_copy;
+
+/** Whether the measurement is over */
+static volatile bool	bench_stop;
+
+/** Number of threads that are running */
+static volatile int32	bench_n_running;
+
+/** Number of mini-transactions committed */
+static volatile int64	bench_n_commits;
+
+/** Discard the contents of the log buffer, like log_buffer_switch()
+does after the buffer has been written. */
+static
+void
+bench_discard()
+{
+	ut_ad(log_mutex_own());
+
+	log_sys.wait_for_pending_copies();
+
+	ulint	area_end = ut_calc_align(
+		log_sys.buf_free, ulong(OS_FILE_LOG_BLOCK_SIZE));
+
+	memmove(log_sys.buf,
+		log_sys.buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
+		OS_FILE_LOG_BLOCK_SIZE);
+
+	log_sys.buf_free %= OS_FILE_LOG_BLOCK_SIZE;
+	log_sys.buf_next_to_write = log_sys.buf_free;
+}
+
+/** Committing thread.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(bench_commit_thread)(void*)
+{
+	const ulint	len = bench_log_size;
+	/* The reservation in log_reserve_and_open() */
+	const ulint	len_upper_limit = 4 * OS_FILE_LOG_BLOCK_SIZE
+		+ srv_log_write_ahead_size + (5 * len) / 4;
+	byte*		rec = static_cast<byte*>(malloc(len));
+	int64		n_commits = 0;
+
+	memset(rec, MLOG_MULTI_REC_END, len);
+
+	while (!bench_stop) {
+		log_mutex_enter();
+
+		if (log_sys.buf_free + len_upper_limit
+		    > srv_log_buffer_size) {
+			bench_discard();
+		}
+
+		log_reserve_and_open(len);
+
+		if (bench_copy) {
+			byte*	dst = log_reserve_for_copy(len);
+			log_close();
+			log_mutex_exit();
+
+			log_copy_reserved(dst, rec, len);
+			log_release_reserved();
+		} else {
+			log_write_low(rec, len);
+			log_close();
+			log_mutex_exit();
+		}
+
+		n_commits++;
+	}
+
+	my_atomic_add64(&bench_n_commits, n_commits);
+
+	free(rec);
+
+	my_atomic_add32(&bench_n_running, -1);
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Measure the commit rate with a number of threads.
+@param[in]	n_threads	number of committing threads
+@param[in]	runtime		duration of the measurement, in seconds
+@return commits per second */
+static
+double
+bench_run(
+	ulint	n_threads,
+	ulint	runtime)
+{
+	bench_stop = false;
+	bench_n_commits = 0;
+	bench_n_running = int32(n_threads);
+
+	for (ulint i = 0; i < n_threads; i++) {
+		os_thread_create(bench_commit_thread, NULL, NULL);
+	}
+
+	ulonglong	start = my_interval_timer();
+
+	os_thread_sleep(runtime * 1000000);
+
+	bench_stop = true;
+
+	while (my_atomic_load32(&bench_n_running)) {
+		os_thread_sleep(10000);
+	}
+
+	double	elapsed = double(my_interval_timer() - start);
+
+	return(double(my_atomic_load64(&bench_n_commits)) / elapsed * 1e9);
+}
+
+/** Print the usage and exit. */
+static
+void
+bench_usage()
+{
+	fprintf(stderr,
+		"Usage: innodb_log_bench [--mode=copy|locked|both]"
+		" [--max-threads=n] [--log-size=bytes]"
+		" [--runtime=seconds]\n");
+	exit(1);
+}
+
+int
+main(int argc, char** argv)
+{
+	const char*	mode = "both";
+	ulint		max_threads = 128;
+	ulint		runtime = 2;
+
+	MY_INIT(argv[0]);
+
+	for (int i = 1; i < argc; i++) {
+		const char*	arg = argv[i];
+		const char*	val = strchr(arg, '=');
+
+		val = val ? val + 1 : "";
+
+		if (!strncmp(arg, "--mode=", 7)) {
+			mode = val;
+		} else if (!strncmp(arg, "--max-threads=", 14)) {
+			max_threads = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--log-size=", 11)) {
+			bench_log_size = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--runtime=", 10)) {
+			runtime = strtoul(val, NULL, 10);
+		} else {
+			bench_usage();
+		}
+	}
+
+	const bool	run_copy = !strcmp(mode, "copy")
+		|| !strcmp(mode, "both");
+	const bool	run_locked = !strcmp(mode, "locked")
+		|| !strcmp(mode, "both");
+
+	if (!max_threads || !bench_log_size || (!run_copy && !run_locked)) {
+		bench_usage();
+	}
+
+	srv_page_size_shift = UNIV_PAGE_SIZE_SHIFT_DEF;
+	srv_page_size = UNIV_PAGE_SIZE_DEF;
+	srv_max_n_threads = 1000;
+	srv_log_buffer_size = 16 << 20;
+	srv_log_write_ahead_size = 8192;
+
+	if (bench_log_size > srv_log_buffer_size / 4) {
+		bench_usage();
+	}
+
+	sync_check_init();
+	log_sys.create();
+
+	/* Keep log_close() from checking the checkpoint age. */
+	log_sys.log_group_capacity = LSN_MAX;
+	log_sys.max_modified_age_sync = LSN_MAX;
+
+	printf("log-size=" ULINTPF " runtime=" ULINTPF "s\n",
+	       bench_log_size, runtime);
+	printf("%8s %16s %16s\n", "threads",
+	       run_locked ? "locked" : "", run_copy ? "copy" : "");
+
+	for (ulint n = 1; n <= max_threads; n *= 2) {
+		double	locked = 0;
+		double	copy = 0;
+
+		if (run_locked) {
+			bench_copy = false;
+			locked = bench_run(n, runtime);
+		}
+
+		if (run_copy) {
+			bench_copy = true;
+			copy = bench_run(n, runtime);
+		}
+
+		printf("%8lu %14.0f/s %14.0f/s\n", n, locked, copy);
+		fflush(stdout);
+	}
+
+	srv_shutdown_state = SRV_SHUTDOWN_EXIT_THREADS;
+
+	log_sys.close();
+	sync_check_close();
+	my_end(0);
+
+	return(0);
+}
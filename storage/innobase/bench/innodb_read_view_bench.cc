@@ -0,0 +1,234 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file bench/innodb_read_view_bench.cc
+A stress benchmark of MVCC read view creation.
+
+Writer threads keep --active read-write transactions each registered in
+trx_sys, and continuously commit (assign a serialisation number and
+deregister) and restart them, like a heavy write load does. Reader
+threads meanwhile open and close read views. The program reports the
+average time to open a read view.
+
+Usage:
+innodb_read_view_bench [--readers=n] [--writers=n] [--active=n]
+[--runtime=seconds]
+*******************************************************/
+
+#include "univ.i"
+#include "os0thread.h"
+#include "read0types.h"
+#include "srv0srv.h"
+#include "srv0start.h"
+#include "sync0debug.h"
+#include "trx0sys.h"
+#include "trx0trx.h"
+
+#include <my_sys.h>
+#include <my_atomic.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Number of read-write transactions per writer thread */
+static ulint		bench_n_active = 64;
+
+/** Whether the measurement is over */
+static volatile bool	bench_stop;
+
+/** Number of threads that are running */
+static volatile int32	bench_n_running;
+
+/** Number of read views opened */
+static volatile int64	bench_n_views;
+
+/** Number of read-write transactions committed */
+static volatile int64	bench_n_commits;
+
+/** Writer thread.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(bench_writer_thread)(void*)
+{
+	trx_t**	trxs = new trx_t*[bench_n_active];
+
+	for (ulint i = 0; i < bench_n_active; i++) {
+		trx_t*	trx = trxs[i] = trx_create();
+		trx->auto_commit = false;
+		trx->state = TRX_STATE_ACTIVE;
+		trx_sys.register_rw(trx);
+	}
+
+	int64	n_commits = 0;
+
+	while (!bench_stop) {
+		for (ulint i = 0; i < bench_n_active; i++) {
+			trx_t*	trx = trxs[i];
+
+			/* Commit, as in trx_write_serialisation_history()
+			and trx_commit_in_memory(). */
+			trx_sys.assign_new_trx_no(trx);
+			trx_sys.deregister_rw(trx);
+			trx->no = TRX_ID_MAX;
+
+			/* Start a new transaction. */
+			trx_sys.register_rw(trx);
+		}
+
+		n_commits += int64(bench_n_active);
+	}
+
+	my_atomic_add64(&bench_n_commits, n_commits);
+
+	for (ulint i = 0; i < bench_n_active; i++) {
+		trx_t*	trx = trxs[i];
+
+		trx_sys.deregister_rw(trx);
+		trx->id = 0;
+		trx->state = TRX_STATE_NOT_STARTED;
+		trx_free(trx);
+	}
+
+	delete[] trxs;
+
+	my_atomic_add32(&bench_n_running, -1);
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Reader thread.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(bench_reader_thread)(void*)
+{
+	trx_t*	trx = trx_create();
+	int64	n_views = 0;
+
+	while (!bench_stop) {
+		trx->read_view.open(trx);
+		trx->read_view.close();
+		n_views++;
+	}
+
+	my_atomic_add64(&bench_n_views, n_views);
+
+	trx_free(trx);
+
+	my_atomic_add32(&bench_n_running, -1);
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Print the usage and exit. */
+static
+void
+bench_usage()
+{
+	fprintf(stderr,
+		"Usage: innodb_read_view_bench [--readers=n] [--writers=n]"
+		" [--active=n] [--runtime=seconds]\n");
+	exit(1);
+}
+
+int
+main(int argc, char** argv)
+{
+	ulint	n_readers = 4;
+	ulint	n_writers = 16;
+	ulint	runtime = 10;
+
+	MY_INIT(argv[0]);
+
+	for (int i = 1; i < argc; i++) {
+		const char*	arg = argv[i];
+		const char*	val = strchr(arg, '=');
+
+		val = val ? val + 1 : "";
+
+		if (!strncmp(arg, "--readers=", 10)) {
+			n_readers = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--writers=", 10)) {
+			n_writers = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--active=", 9)) {
+			bench_n_active = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--runtime=", 10)) {
+			runtime = strtoul(val, NULL, 10);
+		} else {
+			bench_usage();
+		}
+	}
+
+	if (!n_readers || !bench_n_active) {
+		bench_usage();
+	}
+
+	srv_max_n_threads = 1000;
+
+	sync_check_init();
+	trx_pool_init();
+	trx_sys.create();
+	trx_sys.init_max_trx_id(1);
+
+	bench_n_running = int32(n_readers + n_writers);
+
+	for (ulint i = 0; i < n_writers; i++) {
+		os_thread_create(bench_writer_thread, NULL, NULL);
+	}
+
+	for (ulint i = 0; i < n_readers; i++) {
+		os_thread_create(bench_reader_thread, NULL, NULL);
+	}
+
+	ulonglong	start = my_interval_timer();
+
+	os_thread_sleep(runtime * 1000000);
+
+	bench_stop = true;
+
+	while (my_atomic_load32(&bench_n_running)) {
+		os_thread_sleep(10000);
+	}
+
+	double	elapsed = double(my_interval_timer() - start);
+	int64	n_views = my_atomic_load64(&bench_n_views);
+	int64	n_commits = my_atomic_load64(&bench_n_commits);
+
+	printf("readers=" ULINTPF " writers=" ULINTPF
+	       " active=" ULINTPF "\n",
+	       n_readers, n_writers, n_writers * bench_n_active);
+	printf("views=%.0f/s %.1fns/view commits=%.0f/s\n",
+	       double(n_views) / elapsed * 1e9,
+	       n_views ? elapsed * double(n_readers) / double(n_views) : 0.0,
+	       double(n_commits) / elapsed * 1e9);
+
+	srv_shutdown_state = SRV_SHUTDOWN_EXIT_THREADS;
+
+	trx_sys.close();
+	trx_pool_close();
+	sync_check_close();
+	my_end(0);
+
+	return(0);
+}
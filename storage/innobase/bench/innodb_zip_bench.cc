@@ -0,0 +1,405 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file bench/innodb_zip_bench.cc
+A benchmark of caching ROW_FORMAT=COMPRESSED pages.
+
+The program reads the index pages of a ROW_FORMAT=COMPRESSED .ibd file
+and accesses them --accesses times, 80% of the accesses going to 20% of
+the pages. A simulated buffer pool of --ratio times the compressed data
+size holds compressed pages, and up to --frames of the buffer pool may
+be used for uncompressed frames, like buf_pool->unzip_LRU. A page that
+is not in the buffer pool is read from the file and decompressed with
+page_zip_decompress(); a page whose uncompressed frame was evicted is
+decompressed again. The program reports the throughput, reads and
+decompressions for each combination of --ratio and --frames.
+
+Usage:
+innodb_zip_bench [--accesses=n] [--ratio=r,...] [--frames=f,...] --file=path
+*******************************************************/
+
+#include "univ.i"
+#include "fil0fil.h"
+#include "fsp0fsp.h"
+#include "page0zip.h"
+#include "srv0srv.h"
+#include "sync0debug.h"
+#include "ut0new.h"
+#include "ut0rnd.h"
+
+#include <my_sys.h>
+
+#include <list>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/** State of a page in the simulated buffer pool */
+enum bench_state_t {
+	/** not in the buffer pool */
+	BENCH_NONE,
+	/** only the compressed page is in the buffer pool */
+	BENCH_ZIP,
+	/** the compressed page and the uncompressed frame are cached */
+	BENCH_FRAME
+};
+
+/** A page in the simulated buffer pool */
+struct bench_page_t {
+	/** page number in the file */
+	ulint				page_no;
+	/** state of the page */
+	bench_state_t			state;
+	/** position in bench_LRU, if state != BENCH_NONE */
+	std::list<ulint>::iterator	LRU;
+	/** position in bench_unzip_LRU, if state == BENCH_FRAME */
+	std::list<ulint>::iterator	unzip_LRU;
+};
+
+/** The data file */
+static File			bench_file;
+/** ROW_FORMAT=COMPRESSED page size */
+static ulint			bench_zip_size;
+/** Index pages of the file */
+static std::vector<bench_page_t>	bench_pages;
+/** Contents of bench_pages[], bench_zip_size bytes each */
+static std::vector<byte>	bench_zip_data;
+/** Compressed pages and uncompressed frames, most recent first */
+static std::list<ulint>		bench_LRU;
+/** Uncompressed frames, most recent first */
+static std::list<ulint>		bench_unzip_LRU;
+
+/** Read a compressed page from the file.
+@param[in]	page_no	page number
+@param[out]	buf	compressed page
+@return whether the page was read */
+static
+bool
+bench_read(ulint page_no, byte* buf)
+{
+	return(my_pread(bench_file, buf, bench_zip_size,
+			my_off_t(page_no) * bench_zip_size, MYF(MY_NABP))
+	       == 0);
+}
+
+/** Decompress a page.
+@param[in]	zip	compressed page
+@param[out]	frame	uncompressed page
+@return whether the page was decompressed */
+static
+bool
+bench_decompress(byte* zip, byte* frame)
+{
+	page_zip_des_t	page_zip;
+
+	page_zip_des_init(&page_zip);
+	page_zip_set_size(&page_zip, bench_zip_size);
+	page_zip.data = zip;
+
+	return(page_zip_decompress(&page_zip, frame, TRUE));
+}
+
+/** Find the index pages of the file that can be decompressed.
+@param[in]	n_pages	number of pages in the file
+@param[in,out]	zip	buffer for a compressed page
+@param[in,out]	frame	buffer for an uncompressed page */
+static
+void
+bench_scan(ulint n_pages, byte* zip, byte* frame)
+{
+	for (ulint page_no = 0; page_no < n_pages; page_no++) {
+		if (!bench_read(page_no, zip)) {
+			break;
+		}
+
+		if (fil_page_get_type(zip) != FIL_PAGE_INDEX
+		    || !bench_decompress(zip, frame)) {
+			continue;
+		}
+
+		bench_page_t	page;
+
+		page.page_no = page_no;
+		page.state = BENCH_NONE;
+		bench_pages.push_back(page);
+		bench_zip_data.insert(bench_zip_data.end(),
+				      zip, zip + bench_zip_size);
+	}
+}
+
+/** Evict the least recently used uncompressed frame. */
+static
+void
+bench_evict_frame()
+{
+	bench_page_t&	page = bench_pages[bench_unzip_LRU.back()];
+
+	ut_ad(page.state == BENCH_FRAME);
+	page.state = BENCH_ZIP;
+	bench_unzip_LRU.pop_back();
+}
+
+/** Evict the least recently used page, with its uncompressed frame. */
+static
+void
+bench_evict_page()
+{
+	bench_page_t&	page = bench_pages[bench_LRU.back()];
+
+	if (page.state == BENCH_FRAME) {
+		bench_unzip_LRU.erase(page.unzip_LRU);
+	}
+
+	page.state = BENCH_NONE;
+	bench_LRU.pop_back();
+}
+
+/** Access the pages with the given buffer pool configuration.
+@param[in]	ratio		buffer pool size relative to the compressed
+				data size
+@param[in]	frames		maximum share of uncompressed frames in the
+				buffer pool
+@param[in]	n_accesses	number of page accesses
+@param[in,out]	zip		buffer for a compressed page
+@param[in,out]	frame		buffer for an uncompressed page */
+static
+void
+bench_run(
+	double	ratio,
+	double	frames,
+	ulint	n_accesses,
+	byte*	zip,
+	byte*	frame)
+{
+	const ulint	n_pages = bench_pages.size();
+	const ulint	pool_size = ulint(ratio * double(n_pages
+							 * bench_zip_size));
+	const ulint	frame_size = ulint(frames * double(pool_size));
+	const ulint	n_hot = std::max<ulint>(n_pages / 5, 1);
+	ulint		n_zip = 0;
+	ulint		n_frames = 0;
+	ulint		n_reads = 0;
+	ulint		n_unzips = 0;
+	ulint		rnd = 1;
+
+	bench_LRU.clear();
+	bench_unzip_LRU.clear();
+
+	for (ulint i = 0; i < n_pages; i++) {
+		bench_pages[i].state = BENCH_NONE;
+	}
+
+	ulonglong	start = my_interval_timer();
+
+	for (ulint i = 0; i < n_accesses; i++) {
+		rnd = ut_rnd_gen_next_ulint(rnd);
+
+		const ulint	n = rnd % 5
+			? rnd / 5 % n_hot : rnd / 5 % n_pages;
+		bench_page_t&	page = bench_pages[n];
+
+		switch (page.state) {
+		case BENCH_FRAME:
+			bench_LRU.splice(bench_LRU.begin(), bench_LRU,
+					 page.LRU);
+			bench_unzip_LRU.splice(bench_unzip_LRU.begin(),
+					       bench_unzip_LRU,
+					       page.unzip_LRU);
+			continue;
+		case BENCH_NONE:
+			/* The page read is only timed; the page is
+			decompressed from bench_zip_data[] below. */
+			bench_read(page.page_no, zip);
+			n_reads++;
+			bench_LRU.push_front(n);
+			page.LRU = bench_LRU.begin();
+			n_zip++;
+			break;
+		case BENCH_ZIP:
+			bench_LRU.splice(bench_LRU.begin(), bench_LRU,
+					 page.LRU);
+			break;
+		}
+
+		bench_decompress(&bench_zip_data[n * bench_zip_size], frame);
+		n_unzips++;
+
+		if (frame_size >= srv_page_size) {
+			page.state = BENCH_FRAME;
+			bench_unzip_LRU.push_front(n);
+			page.unzip_LRU = bench_unzip_LRU.begin();
+			n_frames++;
+
+			while (n_frames * srv_page_size > frame_size) {
+				bench_evict_frame();
+				n_frames--;
+			}
+		} else {
+			page.state = BENCH_ZIP;
+		}
+
+		while (n_zip * bench_zip_size + n_frames * srv_page_size
+		       > pool_size && n_zip > 1) {
+			if (bench_pages[bench_LRU.back()].state
+			    == BENCH_FRAME) {
+				n_frames--;
+			}
+
+			bench_evict_page();
+			n_zip--;
+		}
+	}
+
+	double	elapsed = double(my_interval_timer() - start);
+
+	printf("ratio=%.2f frames=%.2f %10.0f accesses/s"
+	       " reads=" ULINTPF " decompressions=" ULINTPF "\n",
+	       ratio, frames, double(n_accesses) / elapsed * 1e9,
+	       n_reads, n_unzips);
+}
+
+/** Print the usage and exit. */
+static
+void
+bench_usage()
+{
+	fprintf(stderr,
+		"Usage: innodb_zip_bench [--accesses=n] [--ratio=r,...]"
+		" [--frames=f,...] --file=path\n");
+	exit(1);
+}
+
+/** Parse a comma-separated list of numbers.
+@param[in]	val	list of numbers
+@param[out]	list	the numbers */
+static
+void
+bench_parse_list(const char* val, std::vector<double>& list)
+{
+	list.clear();
+
+	while (*val) {
+		char*	end;
+		double	d = strtod(val, &end);
+
+		if (end == val) {
+			bench_usage();
+		}
+
+		list.push_back(d);
+		val = *end == ',' ? end + 1 : end;
+	}
+}
+
+int
+main(int argc, char** argv)
+{
+	const char*		file_name = NULL;
+	ulint			n_accesses = 1000000;
+	std::vector<double>	ratios;
+	std::vector<double>	frames;
+
+	MY_INIT(argv[0]);
+
+	bench_parse_list("0.1,0.25,0.5,1", ratios);
+	bench_parse_list("0,0.25,0.5,1", frames);
+
+	for (int i = 1; i < argc; i++) {
+		const char*	arg = argv[i];
+		const char*	val = strchr(arg, '=');
+
+		val = val ? val + 1 : "";
+
+		if (!strncmp(arg, "--accesses=", 11)) {
+			n_accesses = strtoul(val, NULL, 10);
+		} else if (!strncmp(arg, "--ratio=", 8)) {
+			bench_parse_list(val, ratios);
+		} else if (!strncmp(arg, "--frames=", 9)) {
+			bench_parse_list(val, frames);
+		} else if (!strncmp(arg, "--file=", 7)) {
+			file_name = val;
+		} else {
+			bench_usage();
+		}
+	}
+
+	if (!file_name || !n_accesses || ratios.empty() || frames.empty()) {
+		bench_usage();
+	}
+
+	bench_file = my_open(file_name, O_RDONLY, MYF(MY_WME));
+
+	if (bench_file < 0) {
+		return(1);
+	}
+
+	/* Determine the page sizes from the first page. */
+	byte	header[UNIV_ZIP_SIZE_MIN];
+
+	if (my_pread(bench_file, header, sizeof header, 0, MYF(MY_NABP))) {
+		return(1);
+	}
+
+	const ulint	flags = fsp_header_get_flags(header);
+
+	bench_zip_size = fil_space_t::zip_size(flags);
+
+	if (!fil_space_t::is_valid_flags(flags, true) || !bench_zip_size) {
+		fprintf(stderr, "%s is not a ROW_FORMAT=COMPRESSED file\n",
+			file_name);
+		return(1);
+	}
+
+	srv_page_size = fil_space_t::logical_size(flags);
+	srv_page_size_shift = ut_2_log(srv_page_size);
+	srv_max_n_threads = 1000;
+
+	sync_check_init();
+
+	byte*	mem = static_cast<byte*>(
+		ut_malloc_nokey(3 * srv_page_size));
+	byte*	frame = static_cast<byte*>(ut_align(mem, srv_page_size));
+	byte*	zip = frame + srv_page_size;
+
+	bench_scan(ulint(my_seek(bench_file, 0, MY_SEEK_END, MYF(0))
+			 / bench_zip_size), zip, frame);
+
+	if (bench_pages.empty()) {
+		fprintf(stderr, "%s contains no index pages\n", file_name);
+		return(1);
+	}
+
+	printf("pages=" ULINTPF " page_size=" ULINTPF " zip_size=" ULINTPF
+	       "\n", bench_pages.size(), srv_page_size, bench_zip_size);
+
+	for (ulint r = 0; r < ratios.size(); r++) {
+		for (ulint f = 0; f < frames.size(); f++) {
+			bench_run(ratios[r], frames[f], n_accesses,
+				  zip, frame);
+		}
+	}
+
+	ut_free(mem);
+	my_close(bench_file, MYF(0));
+	sync_check_close();
+	my_end(0);
+
+	return(0);
+}
@@ -1288,6 +1288,60 @@ void btr_free(const page_id_t page_id)
 	mtr.commit();
 }
 
+/** Free all pages of a persistent index tree except the root page,
+and empty the root page. This is used for rolling back TRX_UNDO_EMPTY.
+@param[in,out]	index	index tree */
+void btr_empty(dict_index_t* index)
+{
+	ut_ad(!index->table->is_temporary());
+	ut_ad(!dict_index_is_ibuf(index));
+	ut_ad(!dict_index_is_spatial(index));
+
+	mtr_t		mtr;
+	mtr.start();
+	index->set_modified(mtr);
+	mtr_x_lock(&index->lock, &mtr);
+
+	buf_block_t*	root = btr_root_block_get(index, RW_X_LATCH, &mtr);
+
+	if (root == NULL) {
+		mtr.commit();
+		return;
+	}
+
+	if (!page_is_leaf(root->frame)) {
+		/* Free the leaf segment and all pages of the top
+		segment except the root page. */
+		btr_free_but_not_root(root, mtr.get_log_mode());
+
+		/* Re-create the leaf segment, like btr_create() does.
+		fseg_create() expects the page of the segment header to
+		be of FIL_PAGE_TYPE_SYS; btr_page_empty() will restore
+		FIL_PAGE_INDEX. */
+		mlog_write_ulint(root->frame + FIL_PAGE_TYPE,
+				 FIL_PAGE_TYPE_SYS, MLOG_2BYTES, &mtr);
+
+		if (!fseg_create(index->table->space,
+				 root->page.id.page_no(),
+				 PAGE_HEADER + PAGE_BTR_SEG_LEAF, &mtr)) {
+			ib::error() << "Out of space when emptying index "
+				<< index->name << " of table "
+				<< index->table->name;
+			index->table->file_unreadable = true;
+		}
+
+		buf_block_dbg_add_level(root, SYNC_TREE_NODE_NEW);
+	}
+
+	btr_page_empty(root, buf_block_get_page_zip(root), index, 0, &mtr);
+
+	if (!dict_index_is_clust(index)) {
+		ibuf_reset_free_bits(root);
+	}
+
+	mtr.commit();
+}
+
 /** Read the last used AUTO_INCREMENT value from PAGE_ROOT_AUTO_INC.
 @param[in,out]	index	clustered index
 @return	the last used AUTO_INCREMENT value
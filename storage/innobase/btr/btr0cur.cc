@@ -67,6 +67,8 @@ Created 10/16/1994 Heikki Tuuri
 #include "srv0start.h"
 #include "mysql_com.h"
 #include "dict0stats.h"
+#include "btr0pcur.h"
+#include "srv0mon.h"
 
 /** Buffered B-tree operation types, introduced as part of delete buffering. */
 enum btr_op_t {
@@ -6715,6 +6717,450 @@ btr_estimate_n_rows_in_range_low(
 	}
 }
 
+/** Every this many estimates from btr_range_cache_t are compared to
+the estimate of btr_estimate_n_rows_in_range_low(). */
+static const ulint	btr_range_cache_check_interval = 32;
+
+/** Cached node pointers of one level of an index tree, for estimating
+the number of records in a range without latching any index pages
+(innodb_records_in_range_cache). The node pointers divide the index into
+subtrees; a range is estimated by the sizes of the subtrees that contain
+its start and end. */
+struct btr_range_cache_t {
+	/** memory for recs, offsets and rows */
+	mem_heap_t*		heap;
+	/** innodb_records_in_range_cache when the cache was built */
+	ulint			max_entries;
+	/** number of cached node pointers, 0 if the index must be dived */
+	ulint			n_entries;
+	/** copies of the node pointers, in ascending order; recs[0]
+	is the leftmost node pointer of the level (REC_INFO_MIN_REC_FLAG) */
+	const rec_t**		recs;
+	/** rec_get_offsets(recs[i]) */
+	const ulint**		offsets;
+	/** estimated number of records in the subtrees on the left of
+	recs[i], for 0 <= i <= n_entries; rows[n_entries] == n_rows */
+	ha_rows*		rows;
+	/** dict_table_get_n_rows() when the cache was built */
+	ha_rows			n_rows;
+	/** dict_table_t::stat_modified_counter when the cache was built */
+	ib_uint64_t		modified_counter;
+	/** number of estimates made from the cache */
+	Atomic_counter<ulint>	n_hits;
+};
+
+/** Free the cached node pointers of an index.
+@param[in,out]	index	index whose range_cache to free */
+void
+btr_range_cache_free(dict_index_t* index)
+{
+	btr_range_cache_t*	cache = index->range_cache;
+
+	if (cache != NULL) {
+		index->range_cache = NULL;
+		mem_heap_free(cache->heap);
+		UT_DELETE(cache);
+	}
+}
+
+/** Determine if the cached node pointers of an index need to be rebuilt.
+@param[in]	index	index
+@return whether index->range_cache is missing or stale */
+static
+bool
+btr_range_cache_is_stale(const dict_index_t* index)
+{
+	const btr_range_cache_t*	cache = index->range_cache;
+
+	if (cache == NULL || cache->max_entries != srv_records_in_range_cache) {
+		return(true);
+	}
+
+	/* The counter is reset when the statistics are recalculated. */
+	ib_uint64_t	modified = index->table->stat_modified_counter;
+
+	return(modified < cache->modified_counter
+	       || modified - cache->modified_counter > 16 + cache->n_rows / 16);
+}
+
+/** Read one level of an index tree for btr_range_cache_build().
+@param[in]	index		index tree
+@param[in]	level		level to read
+@param[out]	n_recs		number of records on each page of the level
+@param[in,out]	heap		memory for the copies of the records,
+				or NULL if the records are not needed
+@param[out]	recs		copies of the records, if heap != NULL
+@param[out]	offsets		rec_get_offsets(recs[i]), if heap != NULL
+@param[in]	max_recs	maximum number of records to copy
+@param[in,out]	mtr		mini-transaction holding dict_index_t::lock
+@return whether all records of the level were copied */
+static
+bool
+btr_range_cache_read_level(
+	dict_index_t*			index,
+	ulint				level,
+	std::vector<ulint>&		n_recs,
+	mem_heap_t*			heap,
+	std::vector<const rec_t*>&	recs,
+	std::vector<const ulint*>&	offsets,
+	ulint				max_recs,
+	mtr_t*				mtr)
+{
+	btr_pcur_t	pcur;
+	mem_heap_t*	offsets_heap = NULL;
+	ulint*		rec_offsets = NULL;
+	bool		copied = heap != NULL;
+
+	n_recs.clear();
+	recs.clear();
+	offsets.clear();
+
+	btr_pcur_open_at_index_side(
+		true, index, BTR_SEARCH_TREE_ALREADY_S_LATCHED,
+		&pcur, true, level, mtr);
+
+	for (;;) {
+		const page_t*	page = btr_pcur_get_page(&pcur);
+
+		ut_a(btr_page_get_level(page) == level);
+
+		n_recs.push_back(page_get_n_recs(page));
+
+		if (copied && recs.size() + page_get_n_recs(page) > max_recs) {
+			copied = false;
+		}
+
+		for (const rec_t* rec = page_rec_get_next_const(
+			     page_get_infimum_rec(page));
+		     copied && !page_rec_is_supremum(rec);
+		     rec = page_rec_get_next_const(rec)) {
+			rec_offsets = rec_get_offsets(
+				rec, index, rec_offsets, false,
+				ULINT_UNDEFINED, &offsets_heap);
+
+			const rec_t*	copy = rec_copy(
+				mem_heap_alloc(heap, rec_offs_size(rec_offsets)),
+				rec, rec_offsets);
+
+			recs.push_back(copy);
+			offsets.push_back(rec_get_offsets(
+				copy, index, NULL, false,
+				ULINT_UNDEFINED, &heap));
+		}
+
+		if (!page_has_next(page)) {
+			break;
+		}
+
+		btr_pcur_move_to_last_on_page(&pcur, mtr);
+		btr_pcur_move_to_next_page(&pcur, mtr);
+	}
+
+	btr_pcur_close(&pcur);
+
+	if (offsets_heap != NULL) {
+		mem_heap_free(offsets_heap);
+	}
+
+	return(copied);
+}
+
+/** Build the cached node pointers of an index. The lowest non-leaf level
+that has at most max_entries records is cached. The size of the subtree
+of each cached node pointer is estimated from the number of records on
+its child page; the leaf pages are not read, but assumed to be equally
+filled.
+@param[in]	index		index tree
+@param[in]	max_entries	innodb_records_in_range_cache
+@return the cache (with n_entries == 0 if the index should be dived) */
+static
+btr_range_cache_t*
+btr_range_cache_build(dict_index_t* index, ulint max_entries)
+{
+	btr_range_cache_t*	cache = UT_NEW_NOKEY(btr_range_cache_t());
+	mtr_t			mtr;
+
+	cache->heap = mem_heap_create(1024);
+	cache->max_entries = max_entries;
+	cache->n_entries = 0;
+	cache->n_rows = dict_table_get_n_rows(index->table);
+	cache->modified_counter = index->table->stat_modified_counter;
+	cache->n_hits = 0;
+
+	mtr_start(&mtr);
+	mtr_sx_lock(dict_index_get_lock(index), &mtr);
+
+	ulint	level = btr_height_get(index, &mtr);
+
+	if (level == 0 || cache->n_rows == 0) {
+		mtr_commit(&mtr);
+		return(cache);
+	}
+
+	std::vector<const rec_t*>	recs[2];
+	std::vector<const ulint*>	offsets[2];
+	std::vector<ulint>		n_recs;
+	mem_heap_t*			heap[2] = {
+		mem_heap_create(1024), mem_heap_create(1024)
+	};
+	ulint				cur = 0;
+
+	/* The root page alone is the topmost level. */
+	if (!btr_range_cache_read_level(index, level, n_recs, heap[cur],
+					recs[cur], offsets[cur],
+					max_entries, &mtr)) {
+		goto func_exit;
+	}
+
+	n_recs.assign(recs[cur].size(), 1);
+
+	while (level > 1) {
+		ulint	next = !cur;
+
+		mem_heap_empty(heap[next]);
+
+		bool	copied = btr_range_cache_read_level(
+			index, level - 1, n_recs, heap[next],
+			recs[next], offsets[next], max_entries, &mtr);
+
+		if (n_recs.size() != recs[cur].size()) {
+			/* Each page on the level below must be pointed to
+			by one record on this level. */
+			ut_ad(0);
+			goto func_exit;
+		}
+
+		if (!copied) {
+			break;
+		}
+
+		cur = next;
+		level--;
+		n_recs.assign(recs[cur].size(), 1);
+	}
+
+	{
+		const ulint	n = recs[cur].size();
+		ulint		total = 0;
+
+		for (ulint i = 0; i < n; i++) {
+			total += n_recs[i];
+		}
+
+		/* The copies of the node pointers were allocated from
+		heap[cur]; let the cache take it over. */
+		std::swap(cache->heap, heap[cur]);
+
+		cache->recs = static_cast<const rec_t**>(
+			mem_heap_alloc(cache->heap, n * sizeof *cache->recs));
+		cache->offsets = static_cast<const ulint**>(
+			mem_heap_alloc(cache->heap, n * sizeof *cache->offsets));
+		cache->rows = static_cast<ha_rows*>(
+			mem_heap_alloc(cache->heap,
+				       (n + 1) * sizeof *cache->rows));
+
+		ulint	sum = 0;
+
+		for (ulint i = 0; i < n; i++) {
+			cache->recs[i] = recs[cur][i];
+			cache->offsets[i] = offsets[cur][i];
+			cache->rows[i] = ha_rows(double(cache->n_rows)
+						 * double(sum)
+						 / double(total));
+			sum += n_recs[i];
+		}
+
+		cache->rows[n] = cache->n_rows;
+		cache->n_entries = n;
+	}
+
+func_exit:
+	mtr_commit(&mtr);
+	mem_heap_free(heap[0]);
+	mem_heap_free(heap[1]);
+
+	return(cache);
+}
+/** Rebuild the cached node pointers of an index, unless another thread
+is already doing that.
+@param[in,out]	index	index tree */
+static
+void
+btr_range_cache_refresh(dict_index_t* index)
+{
+	dict_table_t*	table = index->table;
+
+	dict_table_stats_lock(table, RW_X_LATCH);
+
+	if (index->range_cache_building || !btr_range_cache_is_stale(index)) {
+		dict_table_stats_unlock(table, RW_X_LATCH);
+		return;
+	}
+
+	index->range_cache_building = true;
+
+	dict_table_stats_unlock(table, RW_X_LATCH);
+
+	btr_range_cache_t*	cache = btr_range_cache_build(
+		index, srv_records_in_range_cache);
+
+	dict_table_stats_lock(table, RW_X_LATCH);
+
+	btr_range_cache_free(index);
+	index->range_cache = cache;
+	index->range_cache_building = false;
+
+	dict_table_stats_unlock(table, RW_X_LATCH);
+
+	MONITOR_INC(MONITOR_INDEX_RANGE_CACHE_REFRESH);
+}
+
+/** Find the cached subtree that contains a range boundary.
+@param[in]	cache		cached node pointers
+@param[in]	tuple		range boundary, may also be empty tuple
+@param[in]	mode		search mode for the boundary
+@param[in]	is_end		whether tuple is the end of the range
+@return index of the last node pointer that precedes the boundary */
+static
+ulint
+btr_range_cache_search(
+	const btr_range_cache_t*	cache,
+	const dtuple_t*			tuple,
+	page_cur_mode_t			mode,
+	bool				is_end)
+{
+	if (dtuple_get_n_fields(tuple) == 0) {
+		return(is_end ? cache->n_entries - 1 : 0);
+	}
+
+	/* Whether the records that are equal to tuple precede the
+	boundary, like for x > 5 or x <= 5. */
+	const bool	or_equal = mode == PAGE_CUR_G || mode == PAGE_CUR_LE;
+
+	/* recs[0] carries REC_INFO_MIN_REC_FLAG and always precedes
+	the boundary. Find the last recs[low] that precedes it. */
+	ulint	low = 0;
+	ulint	high = cache->n_entries;
+
+	while (high - low > 1) {
+		ulint	mid = (low + high) / 2;
+		int	cmp = cmp_dtuple_rec(tuple, cache->recs[mid],
+					     cache->offsets[mid]);
+
+		if (cmp > 0 || (or_equal && cmp == 0)) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+
+	return(low);
+}
+
+/** Estimate the number of rows in a given index range from the cached
+node pointers of the index.
+@param[in,out]	index	index
+@param[in]	tuple1	range start, may also be empty tuple
+@param[in]	mode1	search mode for range start
+@param[in]	tuple2	range end, may also be empty tuple
+@param[in]	mode2	search mode for range end
+@param[out]	check	whether the estimate should be compared to a dive
+@return estimated number of rows
+@retval HA_POS_ERROR if the index must be dived */
+static
+ha_rows
+btr_range_cache_estimate(
+	dict_index_t*	index,
+	const dtuple_t*	tuple1,
+	page_cur_mode_t	mode1,
+	const dtuple_t*	tuple2,
+	page_cur_mode_t	mode2,
+	bool*		check)
+{
+	dict_table_t*	table = index->table;
+
+	dict_table_stats_lock(table, RW_S_LATCH);
+
+	if (btr_range_cache_is_stale(index)) {
+		dict_table_stats_unlock(table, RW_S_LATCH);
+		btr_range_cache_refresh(index);
+		dict_table_stats_lock(table, RW_S_LATCH);
+	}
+
+	/* If another thread is rebuilding the cache, the stale one
+	is good enough for an estimate. */
+	btr_range_cache_t*	cache = index->range_cache;
+
+	if (cache == NULL || cache->n_entries == 0) {
+		dict_table_stats_unlock(table, RW_S_LATCH);
+		return(HA_POS_ERROR);
+	}
+
+	ulint	s1 = btr_range_cache_search(cache, tuple1, mode1, false);
+	ulint	s2 = btr_range_cache_search(cache, tuple2, mode2, true);
+	ha_rows	n_rows = HA_POS_ERROR;
+
+	if (mode1 == PAGE_CUR_GE && mode2 == PAGE_CUR_G
+	    && dtuple_get_n_fields(tuple1) > 0
+	    && dtuple_get_n_fields(tuple1) == dtuple_get_n_fields(tuple2)
+	    && !dtuple_coll_cmp(tuple1, tuple2)) {
+		/* An equality lookup, such as one value of an IN list.
+		If the key equals a cached node pointer, the range
+		starts in the subtree on the left of it (s2 == s1 + 1).
+		Unless the key spans whole subtrees, use the average
+		number of records per key value. */
+		if (s2 - s1 <= 1 && table->stat_initialized) {
+			ulint		n = std::min(
+				dtuple_get_n_fields(tuple1),
+				dict_index_get_n_unique(index));
+			ib_uint64_t	n_diff
+				= index->stat_n_diff_key_vals[n - 1];
+
+			if (n_diff > 0) {
+				n_rows = std::max<ha_rows>(
+					ha_rows(cache->n_rows / n_diff), 1);
+				n_rows = std::min(n_rows, cache->rows[s2 + 1]
+						  - cache->rows[s1] + 1);
+			}
+
+			goto func_exit;
+		}
+	} else if (s1 == s2) {
+		/* The range is within one subtree. */
+		goto func_exit;
+	}
+
+	if (s1 < s2) {
+		/* Assume that the range starts and ends in the middle
+		of the subtrees s1 and s2. */
+		n_rows = (cache->rows[s2] + cache->rows[s2 + 1]) / 2
+			- (cache->rows[s1] + cache->rows[s1 + 1]) / 2;
+
+		ha_rows	table_n_rows = dict_table_get_n_rows(table);
+
+		/* Do not estimate the number of rows in the range
+		to over 1 / 2 of the estimated rows in the whole
+		table, like btr_estimate_n_rows_in_range_low(). */
+		if (n_rows > table_n_rows / 2) {
+			n_rows = table_n_rows / 2;
+
+			if (n_rows == 0) {
+				n_rows = table_n_rows;
+			}
+		}
+	}
+
+func_exit:
+	if (n_rows != HA_POS_ERROR) {
+		*check = ++cache->n_hits % btr_range_cache_check_interval
+			== 0;
+	}
+
+	dict_table_stats_unlock(table, RW_S_LATCH);
+
+	return(n_rows);
+}
+
 /** Estimates the number of rows in a given index range.
 @param[in]	index	index
 @param[in]	tuple1	range start, may also be empty tuple
@@ -6730,8 +7176,36 @@ btr_estimate_n_rows_in_range(
 	const dtuple_t*	tuple2,
 	page_cur_mode_t	mode2)
 {
-	return btr_estimate_n_rows_in_range_low(
+	ha_rows	cached = HA_POS_ERROR;
+	bool	check = false;
+
+	if (srv_records_in_range_cache) {
+		cached = btr_range_cache_estimate(
+			index, tuple1, mode1, tuple2, mode2, &check);
+
+		if (cached != HA_POS_ERROR) {
+			MONITOR_INC(MONITOR_INDEX_RANGE_CACHE_HIT);
+
+			if (!check) {
+				return(cached);
+			}
+		}
+	}
+
+	MONITOR_INC(MONITOR_INDEX_RANGE_CACHE_DIVE);
+
+	ha_rows	n_rows = btr_estimate_n_rows_in_range_low(
 		index, tuple1, mode1, tuple2, mode2, 1);
+
+	if (check) {
+		MONITOR_INC(MONITOR_INDEX_RANGE_CACHE_CHECK);
+
+		if (cached > 2 * n_rows + 1 || n_rows > 2 * cached + 1) {
+			MONITOR_INC(MONITOR_INDEX_RANGE_CACHE_CHECK_OFF);
+		}
+	}
+
+	return(n_rows);
 }
 
 /*******************************************************************//**
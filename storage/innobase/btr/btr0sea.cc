@@ -50,6 +50,10 @@ char		btr_search_enabled;
 /** Number of adaptive hash index partition. */
 ulong		btr_ahi_parts;
 
+/** Whether the adaptive hash index is disabled and re-enabled for each
+index automatically (innodb_adaptive_hash_index_auto) */
+my_bool		btr_search_auto;
+
 #ifdef UNIV_SEARCH_PERF_STAT
 /** Number of successful adaptive hash index lookups */
 ulint		btr_search_n_succ	= 0;
@@ -839,6 +843,8 @@ btr_search_failure(btr_search_t* info, btr_cur_t* cursor)
 {
 	cursor->flag = BTR_CUR_HASH_FAIL;
 
+	info->n_misses++;
+
 #ifdef UNIV_SEARCH_PERF_STAT
 	++info->n_hash_fail;
 
@@ -905,7 +911,7 @@ btr_search_guess_on_hash(
 	/* Note that, for efficiency, the struct info may not be protected by
 	any latch here! */
 
-	if (info->n_hash_potential == 0) {
+	if (info->n_hash_potential == 0 || info->auto_disabled) {
 
 		return(FALSE);
 	}
@@ -1048,6 +1054,7 @@ btr_search_guess_on_hash(
 	meanwhile! Thus it might not be a bug. */
 #endif
 	info->last_hash_succ = TRUE;
+	info->n_hits++;
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1257,6 +1264,8 @@ void btr_search_drop_page_hash_index(buf_block_t* block)
 	info = btr_search_get_info(block->index);
 	ut_a(info->ref_count > 0);
 	info->ref_count--;
+	info->n_pages_removed++;
+	info->n_rows_removed += n_cached;
 
 	block->index = NULL;
 
@@ -1507,6 +1516,9 @@ btr_search_build_page_hash_index(
 		ha_insert_for_fold(table, folds[i], block, recs[i]);
 	}
 
+	index->search_info->n_pages_added++;
+	index->search_info->n_rows_added += n_cached;
+
 	MONITOR_INC(MONITOR_ADAPTIVE_HASH_PAGE_ADDED);
 	MONITOR_INC_VALUE(MONITOR_ADAPTIVE_HASH_ROW_ADDED, n_cached);
 exit_func:
@@ -1520,6 +1532,75 @@ btr_search_build_page_hash_index(
 	}
 }
 
+/** Difference of two approximate counters of btr_search_t.
+@param[in]	now	current value
+@param[in]	then	earlier value
+@return now - then, or 0 if a lost update made the counter go backwards */
+static inline ulint btr_search_auto_delta(ulint now, ulint then)
+{
+	return(now > then ? now - then : 0);
+}
+
+/** Disable or re-enable the adaptive hash index for an index, based on
+the hash searches that it saved compared to the failed hash searches and
+the page hash index builds and drops (innodb_adaptive_hash_index_auto).
+NOTE that info is NOT protected by any semaphore, to save CPU time!
+@param[in,out]	info	search info
+@return whether the adaptive hash index is disabled for the index */
+static
+bool
+btr_search_auto_update(btr_search_t* info)
+{
+	if (info->auto_disabled) {
+		if (btr_search_auto && info->auto_retry > 1) {
+			info->auto_retry--;
+			return(true);
+		}
+
+		/* Try the hash index again, starting a new window. */
+		info->auto_disabled = false;
+		MONITOR_INC(MONITOR_ADAPTIVE_HASH_AUTO_ENABLED);
+		info->auto_hits = info->n_hits;
+		info->auto_misses = info->n_misses;
+		info->auto_rows = info->n_rows_added + info->n_rows_removed;
+		return(false);
+	}
+
+	if (!btr_search_auto) {
+		return(false);
+	}
+
+	DBUG_EXECUTE_IF("btr_search_auto_lose",
+			info->n_misses += BTR_SEARCH_AUTO_WINDOW;);
+
+	const ulint	rows = info->n_rows_added + info->n_rows_removed;
+	const ulint	saved = btr_search_auto_delta(info->n_hits,
+						      info->auto_hits);
+	const ulint	wasted = btr_search_auto_delta(info->n_misses,
+						       info->auto_misses)
+		+ btr_search_auto_delta(rows, info->auto_rows)
+		/ BTR_SEARCH_AUTO_ROWS_PER_SEARCH;
+
+	if (saved + wasted < BTR_SEARCH_AUTO_WINDOW) {
+		return(false);
+	}
+
+	info->auto_hits = info->n_hits;
+	info->auto_misses = info->n_misses;
+	info->auto_rows = rows;
+
+	if (saved >= wasted) {
+		return(false);
+	}
+
+	info->auto_disabled = true;
+	info->auto_retry = BTR_SEARCH_AUTO_RETRY
+		* std::min<ulint>(++info->n_auto_disabled,
+				  BTR_SEARCH_AUTO_RETRY_MAX);
+	MONITOR_INC(MONITOR_ADAPTIVE_HASH_AUTO_DISABLED);
+	return(true);
+}
+
 /** Updates the search info.
 @param[in,out]	info	search info
 @param[in,out]	cursor	cursor which was just positioned */
@@ -1533,6 +1614,16 @@ btr_search_info_update_slow(btr_search_t* info, btr_cur_t* cursor)
 
 	buf_block_t*	block = btr_cur_get_block(cursor);
 
+	if (btr_search_auto_update(info)) {
+		/* The hash index does not pay off for this index.
+		Drop it page by page, as the pages are accessed. */
+		if (block->index) {
+			btr_search_drop_page_hash_index(block);
+		}
+
+		return;
+	}
+
 	/* NOTE that the following two function calls do NOT protect
 	info or block->n_fields etc. with any semaphore, to save CPU time!
 	We cannot assume the fields are consistent when we return from
@@ -709,6 +709,9 @@ buf_get_total_stat(
 
 		tot_stat->n_pages_not_made_young +=
 			buf_stat->n_pages_not_made_young;
+
+		tot_stat->n_pages_ghost_young +=
+			buf_stat->n_pages_ghost_young;
 	}
 }
 
@@ -1933,6 +1936,15 @@ buf_pool_init_instance(
 
 		buf_pool->zip_hash = hash_create(2 * buf_pool->curr_size);
 
+		if (buf_LRU_policy == BUF_LRU_POLICY_2Q) {
+			/* Remember about as many evicted pages as
+			the buffer pool can hold. */
+			buf_pool->LRU_ghost_size = buf_pool->curr_size;
+			buf_pool->LRU_ghost = static_cast<ulint*>(
+				ut_zalloc_nokey(buf_pool->LRU_ghost_size
+						* sizeof *buf_pool->LRU_ghost));
+		}
+
 		buf_pool->last_printout_time = ut_time();
 	}
 	/* 2. Initialize flushing fields
@@ -2026,6 +2038,9 @@ buf_pool_free_instance(
 	ut_free(buf_pool->watch);
 	buf_pool->watch = NULL;
 
+	ut_free(buf_pool->LRU_ghost);
+	buf_pool->LRU_ghost = NULL;
+
 	chunks = buf_pool->chunks;
 	chunk = chunks + buf_pool->n_chunks;
 
@@ -2053,6 +2068,39 @@ buf_pool_free_instance(
 	buf_pool->allocator.~ut_allocator();
 }
 
+#ifdef LINUX_IO_URING
+/** Register the memory of all buffer pool chunks for fixed-buffer
+io_uring reads and writes. */
+static
+void
+buf_pool_register_io_buffers()
+{
+	ulint	n = 0;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		n += buf_pool_from_array(i)->n_chunks;
+	}
+
+	os_aio_buffer_t*	buffers = static_cast<os_aio_buffer_t*>(
+		ut_malloc_nokey(n * sizeof *buffers));
+	os_aio_buffer_t*	b = buffers;
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		const buf_pool_t*	buf_pool = buf_pool_from_array(i);
+		const buf_chunk_t*	chunk = buf_pool->chunks;
+
+		for (ulint j = buf_pool->n_chunks; j--; chunk++, b++) {
+			b->mem = chunk->mem;
+			b->size = chunk->mem_size();
+		}
+	}
+
+	os_aio_register_buffers(buffers, n);
+
+	ut_free(buffers);
+}
+#endif /* LINUX_IO_URING */
+
 /********************************************************************//**
 Creates the buffer pool.
 @return DB_SUCCESS if success, DB_ERROR if not enough memory or error */
@@ -2099,6 +2147,10 @@ buf_pool_init(
 
 	btr_search_sys_create(buf_pool_get_curr_size() / sizeof(void*) / 64);
 
+#ifdef LINUX_IO_URING
+	buf_pool_register_io_buffers();
+#endif /* LINUX_IO_URING */
+
 	return(DB_SUCCESS);
 }
 
@@ -2848,6 +2900,11 @@ buf_pool_resize()
 		return;
 	}
 
+#ifdef LINUX_IO_URING
+	/* Chunks may be freed below. */
+	os_aio_register_buffers(NULL, 0);
+#endif /* LINUX_IO_URING */
+
 	/* Indicate critical path */
 	buf_pool_resizing = true;
 
@@ -3074,6 +3131,10 @@ buf_pool_resize()
 
 	buf_pool_resizing = false;
 
+#ifdef LINUX_IO_URING
+	buf_pool_register_io_buffers();
+#endif /* LINUX_IO_URING */
+
 	/* Normalize other components, if the new size is too different */
 	if (!warning && new_size_too_diff) {
 		srv_buf_pool_base_size = srv_buf_pool_size;
@@ -4668,6 +4729,8 @@ buf_page_get_gen(
 			}
 		}
 
+		buf_LRU_stat_inc_refetch(block);
+
 		if (!access_time && !recv_no_ibuf_operations) {
 			ibuf_merge_or_delete_for_page(
 				block, block->page.id, zip_size, true);
@@ -6862,6 +6925,7 @@ buf_stats_aggregate_pool_info(
 	total_info->n_pending_flush_list += pool_info->n_pending_flush_list;
 	total_info->n_pages_made_young += pool_info->n_pages_made_young;
 	total_info->n_pages_not_made_young += pool_info->n_pages_not_made_young;
+	total_info->n_pages_ghost_young += pool_info->n_pages_ghost_young;
 	total_info->n_pages_read += pool_info->n_pages_read;
 	total_info->n_pages_created += pool_info->n_pages_created;
 	total_info->n_pages_written += pool_info->n_pages_written;
@@ -6882,6 +6946,9 @@ buf_stats_aggregate_pool_info(
 	total_info->pages_readahead_rnd_rate += pool_info->pages_readahead_rnd_rate;
 	total_info->pages_readahead_rate += pool_info->pages_readahead_rate;
 	total_info->pages_evicted_rate += pool_info->pages_evicted_rate;
+	total_info->page_cleaner_lru_rate += pool_info->page_cleaner_lru_rate;
+	total_info->page_cleaner_list_rate += pool_info->page_cleaner_list_rate;
+	total_info->n_page_cleaner_stalls += pool_info->n_page_cleaner_stalls;
 	total_info->unzip_lru_len += pool_info->unzip_lru_len;
 	total_info->io_sum += pool_info->io_sum;
 	total_info->io_cur += pool_info->io_cur;
@@ -6949,6 +7016,8 @@ buf_stats_get_pool_info(
 	pool_info->n_pages_not_made_young =
 		buf_pool->stat.n_pages_not_made_young;
 
+	pool_info->n_pages_ghost_young = buf_pool->stat.n_pages_ghost_young;
+
 	pool_info->n_pages_read = buf_pool->stat.n_pages_read;
 
 	pool_info->n_pages_created = buf_pool->stat.n_pages_created;
@@ -7010,6 +7079,17 @@ buf_stats_get_pool_info(
 		(buf_pool->stat.n_ra_pages_evicted
 		 - buf_pool->old_stat.n_ra_pages_evicted) / time_elapsed;
 
+	pool_info->page_cleaner_lru_rate =
+		(buf_pool->stat.n_page_cleaner_lru
+		 - buf_pool->old_stat.n_page_cleaner_lru) / time_elapsed;
+
+	pool_info->page_cleaner_list_rate =
+		(buf_pool->stat.n_page_cleaner_list
+		 - buf_pool->old_stat.n_page_cleaner_list) / time_elapsed;
+
+	pool_info->n_page_cleaner_stalls =
+		buf_pool->stat.n_page_cleaner_stalls;
+
 	pool_info->unzip_lru_len = UT_LIST_GET_LEN(buf_pool->unzip_LRU);
 
 	pool_info->io_sum = buf_LRU_stat_sum.io;
@@ -7076,6 +7156,13 @@ buf_print_io_instance(
 		pool_info->pages_created_rate,
 		pool_info->pages_written_rate);
 
+	if (buf_LRU_policy == BUF_LRU_POLICY_2Q) {
+		fprintf(file,
+			"Pages read into the new sublist by the 2q policy "
+			ULINTPF "\n",
+			pool_info->n_pages_ghost_young);
+	}
+
 	if (pool_info->n_page_get_delta) {
 		double hit_rate = double(pool_info->page_read_delta)
 			/ pool_info->n_page_get_delta;
@@ -7107,6 +7194,12 @@ buf_print_io_instance(
 		pool_info->pages_evicted_rate,
 		pool_info->pages_readahead_rnd_rate);
 
+	fprintf(file, "Page cleaner flushed from LRU %.2f/s,"
+		" from flush list %.2f/s, stalls " ULINTPF "\n",
+		pool_info->page_cleaner_lru_rate,
+		pool_info->page_cleaner_list_rate,
+		pool_info->n_page_cleaner_stalls);
+
 	/* Print some values to help us with visualizing what is
 	happening with LRU eviction. */
 	fprintf(file,
@@ -7397,15 +7490,22 @@ buf_page_encrypt(
 		/* First we compress the page content */
 		buf_tmp_reserve_compression_buf(slot);
 		byte* tmp = slot->comp_buf;
+		const ulonglong start = my_interval_timer();
 		ulint out_len = fil_page_compress(
 			src_frame, tmp, space->flags,
 			fil_space_get_block_size(space, bpage->id.page_no()),
 			encrypted);
 
+		space->page_compress_time += ulint(
+			(my_interval_timer() - start) / 1000);
+		space->n_page_compress++;
+
 		if (!out_len) {
 			goto not_compressed;
 		}
 
+		space->n_page_compress_ok++;
+		space->page_compress_bytes += out_len;
 		bpage->real_size = out_len;
 
 		if (full_crc32) {
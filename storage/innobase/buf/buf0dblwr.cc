@@ -135,9 +135,22 @@ buf_dblwr_init(
 
 	buf_dblwr->b_event = os_event_create("dblwr_batch_event");
 	buf_dblwr->s_event = os_event_create("dblwr_single_event");
-	buf_dblwr->first_free = 0;
 	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
+
+	/* Divide the slots for batch flushing between the batches.
+	With srv_doublewrite_batch_size=1 the last batch is empty and
+	will never be used. */
+	for (ulint i = 0, first = 0; i < buf_dblwr_t::N_BATCHES; i++) {
+		buf_dblwr_t::batch_t&	b = buf_dblwr->batches[i];
+		b.first = first;
+		b.size = (srv_doublewrite_batch_size + i)
+			/ buf_dblwr_t::N_BATCHES;
+		first += b.size;
+	}
+
+	ut_ad(buf_dblwr->batches[buf_dblwr_t::N_BATCHES - 1].first
+	      + buf_dblwr->batches[buf_dblwr_t::N_BATCHES - 1].size
+	      == srv_doublewrite_batch_size);
 
 	buf_dblwr->block1 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
@@ -156,6 +169,9 @@ buf_dblwr_init(
 
 	buf_dblwr->buf_block_arr = static_cast<buf_page_t**>(
 		ut_zalloc_nokey(buf_size * sizeof(void*)));
+
+	buf_dblwr->write_arr = static_cast<buf_page_t**>(
+		ut_zalloc_nokey(buf_size * sizeof(void*)));
 }
 
 /** Create the doublewrite buffer if the doublewrite buffer header
@@ -516,6 +532,78 @@ buf_dblwr_init_or_load_pages(
 	return(DB_SUCCESS);
 }
 
+/** Check if a copy in the doublewrite buffer is valid.
+@param[in,out]	page	copy of the page; will be decompressed in place
+@param[in]	space	tablespace
+@param[in,out]	buf	temporary buffer of innodb_page_size
+@param[in]	encrypted	whether to verify the encryption checksum
+@return whether the copy can be written to the data file */
+static bool
+buf_dblwr_copy_is_valid(
+	byte*			page,
+	const fil_space_t&	space,
+	byte*			buf,
+	bool			encrypted)
+{
+	ulint decomp = fil_page_decompress(buf, page, space.flags);
+	if (!decomp || (space.zip_size() && decomp != srv_page_size)) {
+		return(false);
+	}
+
+	return(encrypted
+	       ? buf_page_verify_crypt_checksum(page, space.flags)
+	       : !buf_page_is_corrupted(true, page, space.flags));
+}
+
+/** Check if the doublewrite buffer contains a valid copy of a page
+that is newer than the given one. When a page is written again before
+the batch that holds its previous copy has completed, both batches
+will contain a copy of the page, and the older copy may be in the
+lower slot.
+@param[in]	dblwr	doublewrite buffer pages read at startup
+@param[in]	page	copy of the page
+@param[in]	space	tablespace
+@param[in,out]	buf	temporary buffer of 2*innodb_page_size
+@return whether a newer valid copy of the page exists */
+static bool
+buf_dblwr_has_newer_copy(
+	const recv_dblwr_t&	dblwr,
+	const byte*		page,
+	const fil_space_t&	space,
+	byte*			buf)
+{
+	const ulint	space_id = page_get_space_id(page);
+	const ulint	page_no = page_get_page_no(page);
+	const lsn_t	lsn = mach_read_from_8(page + FIL_PAGE_LSN);
+	const bool	expect_encrypted = space.crypt_data
+		&& space.crypt_data->type != CRYPT_SCHEME_UNENCRYPTED;
+
+	for (recv_dblwr_t::list::const_iterator i = dblwr.pages.begin();
+	     i != dblwr.pages.end(); ++i) {
+		const byte*	copy = *i;
+
+		if (copy == page
+		    || page_get_page_no(copy) != page_no
+		    || page_get_space_id(copy) != space_id
+		    || mach_read_from_8(copy + FIL_PAGE_LSN) <= lsn) {
+			continue;
+		}
+
+		/* Validate a private copy, so that the page in
+		the list is left as it was read. */
+		memcpy(buf, copy, space.physical_size());
+
+		if (buf_dblwr_copy_is_valid(
+			    buf, space, buf + srv_page_size,
+			    expect_encrypted
+			    && buf_page_get_key_version(buf, space.flags))) {
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
 /** Process and remove the double write buffer pages for all tablespaces. */
 void
 buf_dblwr_process()
@@ -530,11 +618,12 @@ buf_dblwr_process()
 	}
 
 	unaligned_read_buf = static_cast<byte*>(
-		ut_malloc_nokey(3U << srv_page_size_shift));
+		ut_malloc_nokey(5U << srv_page_size_shift));
 
 	read_buf = static_cast<byte*>(
 		ut_align(unaligned_read_buf, srv_page_size));
 	byte* const buf = read_buf + srv_page_size;
+	byte* const newer_buf = buf + srv_page_size;
 
 	for (recv_dblwr_t::list::iterator i = recv_dblwr.pages.begin();
 	     i != recv_dblwr.pages.end();
@@ -635,23 +724,20 @@ buf_dblwr_process()
 				<< " from the doublewrite buffer.";
 		}
 
-		ulint decomp = fil_page_decompress(buf, page, space->flags);
-		if (!decomp || (zip_size && decomp != srv_page_size)) {
-			goto bad_doublewrite;
-		}
-
-		if (expect_encrypted
-		    && buf_page_get_key_version(read_buf, space->flags)) {
-			is_corrupted = !buf_page_verify_crypt_checksum(
-						page, space->flags);
-		} else {
-			is_corrupted = buf_page_is_corrupted(
-					true, page, space->flags);
+		if (buf_dblwr_has_newer_copy(recv_dblwr, page, *space,
+					     newer_buf)) {
+			/* Restore the newest valid copy. If it is
+			in an earlier slot, it was already written
+			and the data file page is valid now. */
+			continue;
 		}
 
-		if (is_corrupted) {
+		if (!buf_dblwr_copy_is_valid(
+			    page, *space, buf,
+			    expect_encrypted
+			    && buf_page_get_key_version(read_buf,
+							space->flags))) {
 			if (!is_all_zero) {
-bad_doublewrite:
 				ib::warn() << "A doublewrite copy of page "
 					<< page_id << " is corrupted.";
 			}
@@ -705,7 +791,11 @@ buf_dblwr_free()
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
 	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
+#ifdef UNIV_DEBUG
+	for (ulint i = 0; i < buf_dblwr_t::N_BATCHES; i++) {
+		ut_ad(buf_dblwr->batches[i].reserved == 0);
+	}
+#endif /* UNIV_DEBUG */
 
 	os_event_destroy(buf_dblwr->b_event);
 	os_event_destroy(buf_dblwr->s_event);
@@ -715,6 +805,9 @@ buf_dblwr_free()
 	ut_free(buf_dblwr->buf_block_arr);
 	buf_dblwr->buf_block_arr = NULL;
 
+	ut_free(buf_dblwr->write_arr);
+	buf_dblwr->write_arr = NULL;
+
 	ut_free(buf_dblwr->in_use);
 	buf_dblwr->in_use = NULL;
 
@@ -741,27 +834,53 @@ buf_dblwr_update(
 	case BUF_FLUSH_LRU:
 		mutex_enter(&buf_dblwr->mutex);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+		for (ulint i = 0; i < buf_dblwr_t::N_BATCHES; i++) {
+			buf_dblwr_t::batch_t&	b = buf_dblwr->batches[i];
 
-		buf_dblwr->b_reserved--;
+			if (!b.running) {
+				continue;
+			}
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
-			/* This will finish the batch. Sync data files
-			to the disk. */
-			fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			ut_ad(b.reserved > 0);
+			ut_ad(b.reserved <= b.first_free);
+
+			buf_page_t**	slot = buf_dblwr->buf_block_arr
+				+ b.first;
+			buf_page_t**	end = slot + b.first_free;
 
-			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
+			slot = std::find(slot, end, bpage);
+
+			if (slot == end) {
+				continue;
+			}
+
+			/* The page may be posted to another batch
+			before this batch completes. Clear the slot so
+			that its next write will not be attributed to
+			this batch. */
+			*slot = NULL;
+
+			if (--b.reserved == 0) {
+				mutex_exit(&buf_dblwr->mutex);
+				/* This will finish the batch. Sync data
+				files to the disk. */
+				fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+				mutex_enter(&buf_dblwr->mutex);
+
+				/* We can now reuse the slots of
+				the batch: */
+				b.first_free = 0;
+				b.running = false;
+				os_event_set(buf_dblwr->b_event);
+			}
+
+			mutex_exit(&buf_dblwr->mutex);
+			return;
 		}
 
-		mutex_exit(&buf_dblwr->mutex);
-		break;
+		/* The block we are looking for must exist in a
+		running batch. */
+		ut_error;
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
 			const ulint size = TRX_SYS_DOUBLEWRITE_BLOCKS * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
@@ -946,81 +1065,77 @@ buf_dblwr_write_block_to_datafile(
 	}
 }
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
-void
-buf_dblwr_flush_buffered_writes()
+/** Write pages from write_buf to the doublewrite buffer in the system
+tablespace, using one synchronous write per contiguous range of pages.
+@param[in]	first	first slot to write
+@param[in]	n	number of slots to write */
+static void buf_dblwr_write_slots(ulint first, ulint n)
 {
-	byte*		write_buf;
-	ulint		first_free;
-	ulint		len;
-
-	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
-		/* Sync the writes to the disk. */
-		buf_dblwr_sync_datafiles();
-		/* Now we flush the data to disk (for example, with fsync) */
-		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-		return;
-	}
-
-	ut_ad(!srv_read_only_mode);
-
-try_again:
-	mutex_enter(&buf_dblwr->mutex);
-
-	/* Write first to doublewrite buffer blocks. We use synchronous
-	aio and thus know that file write has been completed when the
-	control returns. */
-
-	if (buf_dblwr->first_free == 0) {
-
-		mutex_exit(&buf_dblwr->mutex);
-
-		/* Wake possible simulated aio thread as there could be
-		system temporary tablespace pages active for flushing.
-		Note: system temporary tablespace pages are not scheduled
-		for doublewrite. */
-		os_aio_simulated_wake_handler_threads();
+	/* Normally, the second block immediately follows the first
+	one, and any range of slots is contiguous in the file. */
+	const bool contiguous = buf_dblwr->block2
+		== buf_dblwr->block1 + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
+
+	while (n) {
+		ulint	page_no;
+		ulint	len = n;
+
+		if (first >= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+			page_no = buf_dblwr->block2 + first
+				- TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
+		} else {
+			page_no = buf_dblwr->block1 + first;
 
-		return;
-	}
+			if (!contiguous) {
+				len = std::min<ulint>(
+					n, TRX_SYS_DOUBLEWRITE_BLOCK_SIZE
+					- first);
+			}
+		}
 
-	if (buf_dblwr->batch_running) {
-		/* Another thread is running the batch right now. Wait
-		for it to finish. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		fil_io(IORequestWrite, true,
+		       page_id_t(TRX_SYS_SPACE, page_no), 0,
+		       0, len << srv_page_size_shift,
+		       buf_dblwr->write_buf
+		       + (first << srv_page_size_shift), NULL);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
-		goto try_again;
+		first += len;
+		n -= len;
 	}
+}
 
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-
-	/* Disallow anyone else to post to doublewrite buffer or to
-	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
-
-	/* Now safe to release the mutex. Note that though no other
-	thread is allowed to post to the doublewrite batch flushing
-	but any threads working on single page flushes are allowed
-	to proceed. */
+/** Write a batch to the doublewrite buffer, and then submit the writes
+of its pages to the data files. Pages can be posted to the other
+batches while this is in progress.
+@param[in,out]	b	batch to write, with buf_dblwr->mutex held;
+			the mutex will be released */
+static void buf_dblwr_write_batch(buf_dblwr_t::batch_t& b)
+{
+	ut_ad(mutex_own(&buf_dblwr->mutex));
+	ut_ad(!b.running);
+	ut_ad(b.first_free > 0);
+	ut_ad(b.first_free == b.reserved);
+
+	/* Disallow anyone else to post to this batch or to start
+	writing it. */
+	b.running = true;
+
+	const ulint	first = b.first;
+	const ulint	n = b.first_free;
+	buf_page_t**	pages = buf_dblwr->write_arr + first;
+
+	/* The slots of buf_block_arr will be cleared as the data file
+	writes complete, possibly before we have submitted all of
+	them. Work on a copy. */
+	memcpy(pages, buf_dblwr->buf_block_arr + first, n * sizeof *pages);
+
+	/* Now safe to release the mutex. Other threads may post
+	pages to the other batches, or do single page flushes. */
 	mutex_exit(&buf_dblwr->mutex);
 
-	write_buf = buf_dblwr->write_buf;
-
-	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
-	     len2 += srv_page_size, i++) {
-
-		const buf_block_t*	block;
-
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+	for (ulint i = 0; i < n; i++) {
+		const buf_block_t*	block
+			= reinterpret_cast<buf_block_t*>(pages[i]);
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -1032,36 +1147,15 @@ buf_dblwr_flush_buffered_writes()
 		/* Check that the actual page in the buffer pool is
 		not corrupt and the LSN values are sane. */
 		buf_dblwr_check_block(block);
-		ut_d(buf_dblwr_check_page_lsn(block->page, write_buf + len2));
+		ut_d(buf_dblwr_check_page_lsn(
+			     block->page, buf_dblwr->write_buf
+			     + ((first + i) << srv_page_size_shift)));
 	}
 
-	/* Write out the first block of the doublewrite buffer */
-	len = std::min<ulint>(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-			      buf_dblwr->first_free) << srv_page_size_shift;
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1), 0,
-	       0, len, (void*) write_buf, NULL);
-
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
-		/* No unwritten pages in the second block. */
-		goto flush;
-	}
+	buf_dblwr_write_slots(first, n);
 
-	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
-	       << srv_page_size_shift;
-
-	write_buf = buf_dblwr->write_buf
-		+ (TRX_SYS_DOUBLEWRITE_BLOCK_SIZE << srv_page_size_shift);
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block2), 0,
-	       0, len, (void*) write_buf, NULL);
-
-flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(n);
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
@@ -1069,23 +1163,15 @@ buf_dblwr_flush_buffered_writes()
 
 	/* We know that the writes have been flushed to disk now
 	and in recovery we will find them in the doublewrite buffer
-	blocks. Next do the writes to the intended positions. */
-
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
-	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
-	This is so because it is possible that after we are done with
-	the last iteration and before we terminate the loop, the batch
-	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
-	loop termination condition then we'll end up dispatching
-	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
-	for (ulint i = 0; i < first_free; i++) {
-		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+	blocks. Next do the writes to the intended positions,
+	in the order of the page identifiers, so that writes of
+	adjacent pages can be merged by the I/O subsystem. */
+	std::sort(pages, pages + n,
+		  [](const buf_page_t* a, const buf_page_t* b)
+		  { return a->id < b->id; });
+
+	for (ulint i = 0; i < n; i++) {
+		buf_dblwr_write_block_to_datafile(pages[i], false);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1095,6 +1181,70 @@ buf_dblwr_flush_buffered_writes()
 	os_aio_simulated_wake_handler_threads();
 }
 
+/** Find the batch that pages can be posted to.
+@return the batch
+@retval NULL if all batches are running */
+static buf_dblwr_t::batch_t* buf_dblwr_get_batch()
+{
+	ut_ad(mutex_own(&buf_dblwr->mutex));
+
+	for (ulint i = 0; i < buf_dblwr_t::N_BATCHES; i++) {
+		const ulint		n = (buf_dblwr->active + i)
+			% buf_dblwr_t::N_BATCHES;
+		buf_dblwr_t::batch_t&	b = buf_dblwr->batches[n];
+
+		if (!b.running && b.size) {
+			ut_ad(n == buf_dblwr->active || !b.first_free);
+			buf_dblwr->active = n;
+			return &b;
+		}
+	}
+
+	return NULL;
+}
+
+/********************************************************************//**
+Flushes possible buffered writes from the doublewrite memory buffer to disk,
+and also wakes up the aio thread if simulated aio is used. It is very
+important to call this function after a batch of writes has been posted,
+and also when we may have to wait for a page latch! Otherwise a deadlock
+of threads can occur. */
+void
+buf_dblwr_flush_buffered_writes()
+{
+	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
+		/* Sync the writes to the disk. */
+		buf_dblwr_sync_datafiles();
+		/* Now we flush the data to disk (for example, with fsync) */
+		fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
+		return;
+	}
+
+	ut_ad(!srv_read_only_mode);
+
+	mutex_enter(&buf_dblwr->mutex);
+
+	/* Only the active batch can contain pages that have not been
+	submitted for writing. The pages of a running batch will be
+	submitted by the thread that is writing it. */
+	buf_dblwr_t::batch_t&	b = buf_dblwr->batches[buf_dblwr->active];
+
+	if (b.running || b.first_free == 0) {
+
+		mutex_exit(&buf_dblwr->mutex);
+
+		/* Wake possible simulated aio thread as there could be
+		system temporary tablespace pages active for flushing.
+		Note: system temporary tablespace pages are not scheduled
+		for doublewrite. */
+		os_aio_simulated_wake_handler_threads();
+
+		return;
+	}
+
+	buf_dblwr_write_batch(b);
+}
+
 /********************************************************************//**
 Posts a buffer page for writing. If the doublewrite memory buffer is
 full, calls buf_dblwr_flush_buffered_writes and waits for for free
@@ -1109,16 +1259,14 @@ buf_dblwr_add_to_batch(
 try_again:
 	mutex_enter(&buf_dblwr->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	buf_dblwr_t::batch_t*	b = buf_dblwr_get_batch();
 
-	if (buf_dblwr->batch_running) {
+	if (b == NULL) {
 
-		/* This not nearly as bad as it looks. There is only
-		page_cleaner thread which does background flushing
-		in batches therefore it is unlikely to be a contention
-		point. The only exception is when a user thread is
-		forced to do a flush batch because of a sync
-		checkpoint. */
+		/* All batches are being written. This should be
+		rare, because the data file writes of a batch are
+		asynchronous, and a new batch can be filled while the
+		previous one is being written. */
 		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
 		mutex_exit(&buf_dblwr->mutex);
 
@@ -1126,16 +1274,19 @@ buf_dblwr_add_to_batch(
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	ut_a(b->first_free <= b->size);
 
-		buf_dblwr_flush_buffered_writes();
+	if (b->first_free == b->size) {
+		/* Another thread filled the batch, but did not
+		start writing it yet. */
+		buf_dblwr_write_batch(*b);
 
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ srv_page_size * buf_dblwr->first_free;
+	const ulint	slot = b->first + b->first_free;
+	byte*		p = buf_dblwr->write_buf
+		+ (slot << srv_page_size_shift);
 
 	/* We request frame here to get correct buffer in case of
 	encryption and/or page compression */
@@ -1153,20 +1304,15 @@ buf_dblwr_add_to_batch(
 		memcpy(p, frame, srv_page_size);
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
-
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
-
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	buf_dblwr->buf_block_arr[slot] = bpage;
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	b->first_free++;
+	b->reserved++;
 
-		buf_dblwr_flush_buffered_writes();
+	ut_ad(b->first_free == b->reserved);
 
+	if (b->first_free == b->size) {
+		buf_dblwr_write_batch(*b);
 		return;
 	}
 
@@ -35,6 +35,7 @@ Created April 08, 2011 Vasil Dimov
 #include "dict0dict.h"
 #include "os0file.h"
 #include "os0thread.h"
+#include "page0page.h"
 #include "srv0srv.h"
 #include "srv0start.h"
 #include "sync0rw.h"
@@ -70,6 +71,11 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/** Number of pages that buf_load() sorts and reads at a time. The dump
+file lists the pages in priority order; within a batch the order is
+relaxed so that adjacent pages of a tablespace are read together. */
+static const ulint	BUF_LOAD_BATCH = 4096;
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -244,6 +250,51 @@ buf_dump_generate_path(
 	}
 }
 
+/** Determine whether a page should be loaded before the other pages.
+The page frame is read without holding the block mutex or latch; the
+result is merely a hint for buf_load().
+@param[in]	bpage	page in the LRU list
+@return whether bpage is a non-leaf page of an index tree */
+static
+bool
+buf_dump_is_non_leaf(const buf_page_t* bpage)
+{
+	if (buf_page_get_state(bpage) != BUF_BLOCK_FILE_PAGE
+	    || buf_page_get_io_fix(bpage) == BUF_IO_READ) {
+		return(false);
+	}
+
+	const page_t*	page = reinterpret_cast<const buf_block_t*>(
+		bpage)->frame;
+
+	return(fil_page_index_page_check(page) && !page_is_leaf(page));
+}
+
+/** Entries of a buffer pool instance collected by buf_dump(): first
+the non-leaf B-tree pages and then the other pages, both in the LRU order
+(most recently used first). */
+struct buf_dump_instance_t {
+	/** the entries */
+	buf_dump_t*	dump;
+	/** number of non-leaf pages at the start of dump */
+	ulint		n_non_leaf;
+	/** number of entries in dump */
+	ulint		n_pages;
+};
+
+/** Free the entries that buf_dump() collected.
+@param[in,out]	inst	entries of each buffer pool instance */
+static
+void
+buf_dump_free(buf_dump_instance_t* inst)
+{
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		ut_free(inst[i].dump);
+	}
+
+	ut_free(inst);
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -296,6 +347,21 @@ buf_dump(
 	}
 	/* else */
 
+	buf_dump_instance_t*	inst = static_cast<buf_dump_instance_t*>(
+		ut_zalloc_nokey(srv_buf_pool_instances * sizeof *inst));
+
+	if (inst == NULL) {
+		fclose(f);
+		buf_dump_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				ulint(srv_buf_pool_instances * sizeof *inst),
+				strerror(errno));
+		/* leave tmp_filename to exist */
+		return;
+	}
+
+	ulint	n_total = 0;
+
 	/* walk through each buffer pool */
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
@@ -348,6 +414,7 @@ buf_dump(
 
 		if (dump == NULL) {
 			buf_pool_mutex_exit(buf_pool);
+			buf_dump_free(inst);
 			fclose(f);
 			buf_dump_status(STATUS_ERR,
 					"Cannot allocate " ULINTPF " bytes: %s",
@@ -357,51 +424,96 @@ buf_dump(
 			return;
 		}
 
-		for (bpage = UT_LIST_GET_FIRST(buf_pool->LRU), j = 0;
-		     bpage != NULL && j < n_pages;
-		     bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
-
-			ut_a(buf_page_in_file(bpage));
-			if (bpage->id.space() >= SRV_LOG_SPACE_FIRST_ID) {
-				/* Ignore the innodb_temporary tablespace. */
-				continue;
+		j = 0;
+
+		for (ulint pass = 0; pass < 2; pass++) {
+			for (bpage = UT_LIST_GET_FIRST(buf_pool->LRU);
+			     bpage != NULL && j < n_pages;
+			     bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
+
+				ut_a(buf_page_in_file(bpage));
+				if (bpage->id.space()
+				    >= SRV_LOG_SPACE_FIRST_ID) {
+					/* Ignore the innodb_temporary
+					tablespace. */
+					continue;
+				}
+
+				if (buf_dump_is_non_leaf(bpage) == !pass) {
+					dump[j++] = BUF_DUMP_CREATE(
+						bpage->id.space(),
+						bpage->id.page_no());
+				}
 			}
 
-			dump[j++] = BUF_DUMP_CREATE(bpage->id.space(),
-						    bpage->id.page_no());
+			if (!pass) {
+				inst[i].n_non_leaf = j;
+			}
 		}
 
 		buf_pool_mutex_exit(buf_pool);
 
 		ut_a(j <= n_pages);
-		n_pages = j;
-
-		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
-				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
-			if (ret < 0) {
-				ut_free(dump);
-				fclose(f);
-				buf_dump_status(STATUS_ERR,
+		inst[i].dump = dump;
+		inst[i].n_pages = j;
+		n_total += j;
+	}
+
+	/* Write the non-leaf pages of all instances first and then
+	the other pages. Pages are distributed evenly between the
+	instances, so taking the entries of the instances in turn by
+	their LRU position approximates a global LRU order. buf_load()
+	will read the pages in this order. */
+	ulint	n_written = 0;
+
+	for (ulint pass = 0; pass < 2 && !SHOULD_QUIT(); pass++) {
+		for (ulint rank = 0; !SHOULD_QUIT(); rank++) {
+			bool	found = false;
+
+			for (i = 0; i < srv_buf_pool_instances; i++) {
+				const buf_dump_instance_t&	d = inst[i];
+				const ulint	j = (pass ? d.n_non_leaf : 0)
+					+ rank;
+
+				if (j >= (pass ? d.n_pages : d.n_non_leaf)) {
+					continue;
+				}
+
+				found = true;
+
+				ret = fprintf(f, ULINTPF "," ULINTPF "\n",
+					      BUF_DUMP_SPACE(d.dump[j]),
+					      BUF_DUMP_PAGE(d.dump[j]));
+				if (ret < 0) {
+					buf_dump_free(inst);
+					fclose(f);
+					buf_dump_status(
+						STATUS_ERR,
 						"Cannot write to '%s': %s",
 						tmp_filename, strerror(errno));
-				/* leave tmp_filename to exist */
-				return;
+					/* leave tmp_filename to exist */
+					return;
+				}
+
+				if (SHUTTING_DOWN() && !(n_written % 1024)) {
+					service_manager_extend_timeout(
+						INNODB_EXTEND_TIMEOUT_INTERVAL,
+						"Dumping buffer pool, "
+						"page " ULINTPF "/" ULINTPF,
+						n_written + 1, n_total);
+				}
+
+				n_written++;
 			}
-			if (SHUTTING_DOWN() && !(j % 1024)) {
-				service_manager_extend_timeout(INNODB_EXTEND_TIMEOUT_INTERVAL,
-					"Dumping buffer pool "
-					ULINTPF "/%lu, "
-					"page " ULINTPF "/" ULINTPF,
-					i + 1, srv_buf_pool_instances,
-					j + 1, n_pages);
+
+			if (!found) {
+				break;
 			}
 		}
-
-		ut_free(dump);
 	}
 
+	buf_dump_free(inst);
+
 	ret = fclose(f);
 	if (ret != 0) {
 		buf_dump_status(STATUS_ERR,
@@ -511,6 +623,24 @@ buf_load_throttle_if_needed(
 	*last_activity_count = srv_get_activity_count();
 }
 
+/** Wait until the read requests that buf_load() has submitted leave
+room in the asynchronous I/O read queues. This lets the pages that are
+requested by running queries be read without waiting behind the
+whole buffer pool load. */
+static
+void
+buf_load_wait_for_reads()
+{
+	const ulint	limit = srv_n_read_io_threads
+		* OS_AIO_N_PENDING_IOS_PER_THREAD / 2;
+
+	while (buf_get_n_pending_read_ios() > limit
+	       && !SHUTTING_DOWN() && !buf_load_abort_flag) {
+		os_aio_simulated_wake_handler_threads();
+		os_thread_sleep(1000);
+	}
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -660,16 +790,12 @@ buf_load()
 		return;
 	}
 
-	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
-	}
-
 	ulint		last_check_time = 0;
 	ulint		last_activity_cnt = 0;
 
 	/* Avoid calling the expensive fil_space_acquire_silent() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
+	page within the same tablespace. Each batch of dump[] is sorted by
+	(space, page), so pages from a given tablespace are consecutive. */
 	ulint		cur_space_id = BUF_DUMP_SPACE(dump[0]);
 	fil_space_t*	space = fil_space_acquire_silent(cur_space_id);
 	ulint		zip_size = space ? space->zip_size() : 0;
@@ -686,6 +812,16 @@ buf_load()
 
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
 
+		if (i % BUF_LOAD_BATCH == 0) {
+			/* The file lists the non-leaf pages first and
+			then the most recently used pages. Preserve that
+			order between batches, but sort each batch by
+			(space, page) so that adjacent pages can be read
+			with merged requests. */
+			std::sort(dump + i,
+				  dump + std::min(i + BUF_LOAD_BATCH, dump_n));
+		}
+
 		/* space_id for this iteration of the loop */
 		const ulint	this_space_id = BUF_DUMP_SPACE(dump[i]);
 
@@ -716,6 +852,8 @@ buf_load()
 			continue;
 		}
 
+		buf_load_wait_for_reads();
+
 		buf_read_page_background(
 			page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])),
 			zip_size, true);
@@ -47,6 +47,9 @@ Created 11/11/1995 Heikki Tuuri
 #include "srv0mon.h"
 #include "ut0stage.h"
 #include "fil0pagecompress.h"
+
+#include <deque>
+
 #ifdef UNIV_LINUX
 /* include defs for CPU time priority settings */
 #include <unistd.h>
@@ -105,40 +108,50 @@ enum page_cleaner_state_t {
 	PAGE_CLEANER_STATE_FINISHED
 };
 
-/** Page cleaner request state for each buffer pool instance */
+/** Page cleaner request state for one kind of flushing (LRU or
+flush_list) of one buffer pool instance. The two slots of an instance
+are independent of each other, so that LRU flushing of an instance can
+be done by one thread while another thread is flushing its flush_list. */
 struct page_cleaner_slot_t {
 	page_cleaner_state_t	state;	/*!< state of the request.
 					protected by page_cleaner_t::mutex
 					if the worker thread got the slot and
 					set to PAGE_CLEANER_STATE_FLUSHING,
-					n_flushed_lru and n_flushed_list can be
+					n_flushed and succeeded can be
 					updated only by the worker thread */
-	/* This value is set during state==PAGE_CLEANER_STATE_NONE */
+	buf_flush_t		flush_type;
+					/*!< BUF_FLUSH_LRU or BUF_FLUSH_LIST */
+	ulint			instance;
+					/*!< buffer pool instance number */
+	/* These values are set during state==PAGE_CLEANER_STATE_NONE */
 	ulint			n_pages_requested;
 					/*!< number of requested pages
-					for the slot */
+					for the slot (BUF_FLUSH_LIST) */
+	lsn_t			lsn_limit;
+					/*!< upper limit of LSN to be
+					flushed (BUF_FLUSH_LIST) */
+	lsn_t			order;	/*!< among the requested slots of
+					the same flush_type, the one with the
+					smallest value is served first: the
+					length of the free list for
+					BUF_FLUSH_LRU and the oldest
+					modification for BUF_FLUSH_LIST */
 	/* These values are updated during state==PAGE_CLEANER_STATE_FLUSHING,
 	and commited with state==PAGE_CLEANER_STATE_FINISHED.
 	The consistency is protected by the 'state' */
-	ulint			n_flushed_lru;
-					/*!< number of flushed pages
-					by LRU scan flushing */
-	ulint			n_flushed_list;
-					/*!< number of flushed pages
-					by flush_list flushing */
-	bool			succeeded_list;
+	ulint			n_flushed;
+					/*!< number of flushed pages */
+	bool			succeeded;
 					/*!< true if flush_list flushing
 					succeeded. */
-	ulint			flush_lru_time;
-					/*!< elapsed time for LRU flushing */
-	ulint			flush_list_time;
-					/*!< elapsed time for flush_list
-					flushing */
-	ulint			flush_lru_pass;
-					/*!< count to attempt LRU flushing */
-	ulint			flush_list_pass;
-					/*!< count to attempt flush_list
-					flushing */
+	ulint			flush_time;
+					/*!< elapsed time for flushing */
+	ulint			flush_pass;
+					/*!< count to attempt flushing */
+	ulint			n_flushed_avg;
+					/*!< number of pages flushed during
+					the current averaging period of
+					page_cleaner_flush_pages_recommendation() */
 };
 
 /** Page cleaner structure common for all threads */
@@ -149,15 +162,11 @@ struct page_cleaner_t {
 	os_event_t		is_requested;	/*!< event to activate worker
 						threads. */
 	os_event_t		is_finished;	/*!< event to signal that all
-						slots were finished. */
+						requested slots were finished. */
 	os_event_t		is_started;	/*!< event to signal that
 						thread is started/exiting */
 	volatile ulint		n_workers;	/*!< number of worker threads
 						in existence */
-	bool			requested;	/*!< true if requested pages
-						to flush */
-	lsn_t			lsn_limit;	/*!< upper limit of LSN to be
-						flushed */
 	ulint			n_slots;	/*!< total number of slots */
 	ulint			n_slots_requested;
 						/*!< number of slots
@@ -175,7 +184,10 @@ struct page_cleaner_t {
 						requests for all slots */
 	ulint			flush_pass;	/*!< count to finish to flush
 						requests for all slots */
-	page_cleaner_slot_t	slots[MAX_BUFFER_POOLS];
+	page_cleaner_slot_t	slots[2 * MAX_BUFFER_POOLS];
+						/*!< BUF_FLUSH_LRU and
+						BUF_FLUSH_LIST slot of each
+						buffer pool instance */
 	bool			is_running;	/*!< false if attempt
 						to shutdown */
 
@@ -188,6 +200,62 @@ struct page_cleaner_t {
 
 static page_cleaner_t	page_cleaner;
 
+/** Number of page compression threads (innodb_page_compression_threads) */
+ulong	innodb_page_compression_threads;
+
+/** A page write that was handed over to a page compression thread */
+struct buf_flush_compress_job_t {
+	/** the tablespace, acquired for I/O */
+	fil_space_t*	space;
+	/** the page to write */
+	buf_page_t*	bpage;
+	/** buffer pool instance of the page */
+	ulint		instance;
+	/** BUF_FLUSH_LRU or BUF_FLUSH_LIST */
+	buf_flush_t	flush_type;
+};
+
+/** The page compression threads. They compress and encrypt the pages of
+page_compressed tablespaces that the page cleaner writes, and submit the
+writes, so that the flushing is not bound by the speed of a single
+thread compressing pages. */
+struct buf_flush_compress_t {
+	/** mutex protecting the queue and the counts */
+	ib_mutex_t		mutex;
+	/** event to wake up the threads */
+	os_event_t		is_requested;
+	/** event signalled when the queued writes of a batch have
+	been submitted, or a thread exits */
+	os_event_t		is_finished;
+	/** queued page writes */
+	std::deque<buf_flush_compress_job_t,
+		   ut_allocator<buf_flush_compress_job_t> >	jobs;
+	/** number of queued or running jobs of each buffer pool
+	instance and flush type */
+	ulint			n_pending[MAX_BUFFER_POOLS][BUF_FLUSH_N_TYPES];
+	/** number of threads in existence */
+	ulint			n_threads;
+	/** false if the threads are to exit */
+	bool			is_running;
+};
+
+static buf_flush_compress_t	buf_flush_compress;
+
+/** Get a page cleaner slot.
+@param[in]	instance	buffer pool instance number
+@param[in]	flush_type	BUF_FLUSH_LRU or BUF_FLUSH_LIST
+@return the slot */
+static inline
+page_cleaner_slot_t*
+pc_get_slot(ulint instance, buf_flush_t flush_type)
+{
+	ut_ad(instance < srv_buf_pool_instances);
+	ut_ad(flush_type == BUF_FLUSH_LRU || flush_type == BUF_FLUSH_LIST);
+
+	return(&page_cleaner.slots[2 * instance
+				   + (flush_type == BUF_FLUSH_LIST)]);
+}
+
 #ifdef UNIV_DEBUG
 my_bool innodb_page_cleaner_disabled_debug;
 #endif /* UNIV_DEBUG */
@@ -943,23 +1011,20 @@ buf_flush_init_for_writing(
 			checksum);
 }
 
-/********************************************************************//**
-Does an asynchronous write of a buffer page. NOTE: in simulated aio and
-also when the doublewrite buffer is used, we must call
-buf_dblwr_flush_buffered_writes after we have posted a batch of
-writes! */
+/** Write a buffer page.
+@param[in,out]	space		tablespace, acquired for I/O; will be
+released
+@param[in,out]	bpage		buffer block to write
+@param[in]	flush_type	type of flush
+@param[in]	sync		true if sync IO request */
 static
 void
 buf_flush_write_block_low(
-/*======================*/
-	buf_page_t*	bpage,		/*!< in: buffer block to write */
-	buf_flush_t	flush_type,	/*!< in: type of flush */
-	bool		sync)		/*!< in: true if sync IO request */
+	fil_space_t*	space,
+	buf_page_t*	bpage,
+	buf_flush_t	flush_type,
+	bool		sync)
 {
-	fil_space_t* space = fil_space_acquire_for_io(bpage->id.space());
-	if (!space) {
-		return;
-	}
 	ut_ad(space->purpose == FIL_TYPE_TEMPORARY
 	      || space->purpose == FIL_TYPE_IMPORT
 	      || space->purpose == FIL_TYPE_TABLESPACE);
@@ -1093,6 +1158,208 @@ buf_flush_write_block_low(
 	buf_LRU_stat_inc_io();
 }
 
+/** Hand over a page write to the page compression threads.
+@param[in,out]	space		tablespace, acquired for I/O
+@param[in,out]	bpage		buffer block to write
+@param[in]	flush_type	type of flush
+@return whether the write was queued */
+static
+bool
+buf_flush_compress_queue(
+	fil_space_t*	space,
+	buf_page_t*	bpage,
+	buf_flush_t	flush_type)
+{
+	if (!buf_flush_compress.n_threads
+	    || flush_type == BUF_FLUSH_SINGLE_PAGE
+	    || !space->is_compressed()
+	    || buf_page_get_state(bpage) != BUF_BLOCK_FILE_PAGE) {
+		return(false);
+	}
+
+	buf_flush_compress_job_t	job;
+
+	job.space = space;
+	job.bpage = bpage;
+	job.instance = buf_pool_index(buf_pool_from_bpage(bpage));
+	job.flush_type = flush_type;
+
+	mutex_enter(&buf_flush_compress.mutex);
+
+	const bool	queued = buf_flush_compress.is_running;
+
+	if (queued) {
+		buf_flush_compress.jobs.push_back(job);
+		buf_flush_compress.n_pending[job.instance][flush_type]++;
+		os_event_set(buf_flush_compress.is_requested);
+	}
+
+	mutex_exit(&buf_flush_compress.mutex);
+
+	return(queued);
+}
+
+/** Wait for the page compression threads to submit the queued writes
+of a flush batch.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	flush_type	BUF_FLUSH_LRU or BUF_FLUSH_LIST */
+static
+void
+buf_flush_compress_wait(
+	const buf_pool_t*	buf_pool,
+	buf_flush_t		flush_type)
+{
+	if (!buf_flush_compress.n_threads) {
+		return;
+	}
+
+	const ulint&	n_pending = buf_flush_compress.n_pending[
+		buf_pool_index(buf_pool)][flush_type];
+
+	mutex_enter(&buf_flush_compress.mutex);
+
+	while (n_pending) {
+		const int64_t	sig_count = os_event_reset(
+			buf_flush_compress.is_finished);
+
+		mutex_exit(&buf_flush_compress.mutex);
+		os_event_wait_low(buf_flush_compress.is_finished, sig_count);
+		mutex_enter(&buf_flush_compress.mutex);
+	}
+
+	mutex_exit(&buf_flush_compress.mutex);
+}
+
+/** Page compression thread. Compresses and writes the pages that
+buf_flush_compress_queue() handed over.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(buf_flush_compress_thread)(void*)
+{
+	mutex_enter(&buf_flush_compress.mutex);
+
+	for (;;) {
+		if (buf_flush_compress.jobs.empty()) {
+			if (!buf_flush_compress.is_running) {
+				break;
+			}
+
+			const int64_t	sig_count = os_event_reset(
+				buf_flush_compress.is_requested);
+
+			mutex_exit(&buf_flush_compress.mutex);
+			os_event_wait_low(buf_flush_compress.is_requested,
+					  sig_count);
+			mutex_enter(&buf_flush_compress.mutex);
+			continue;
+		}
+
+		const buf_flush_compress_job_t	job
+			= buf_flush_compress.jobs.front();
+		buf_flush_compress.jobs.pop_front();
+
+		mutex_exit(&buf_flush_compress.mutex);
+
+		buf_flush_write_block_low(job.space, job.bpage,
+					  job.flush_type, false);
+
+		mutex_enter(&buf_flush_compress.mutex);
+
+		if (!--buf_flush_compress.n_pending[job.instance]
+		    [job.flush_type]) {
+			os_event_set(buf_flush_compress.is_finished);
+		}
+	}
+
+	buf_flush_compress.n_threads--;
+	os_event_set(buf_flush_compress.is_finished);
+
+	mutex_exit(&buf_flush_compress.mutex);
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start the page compression threads. */
+void
+buf_flush_compress_threads_create()
+{
+	if (!innodb_page_compression_threads) {
+		return;
+	}
+
+	mutex_create(LATCH_ID_BUF_FLUSH_COMPRESS, &buf_flush_compress.mutex);
+
+	buf_flush_compress.is_requested = os_event_create(0);
+	buf_flush_compress.is_finished = os_event_create(0);
+	buf_flush_compress.is_running = true;
+	buf_flush_compress.n_threads = innodb_page_compression_threads;
+
+	for (ulong i = 0; i < innodb_page_compression_threads; i++) {
+		os_thread_create(buf_flush_compress_thread, NULL, NULL);
+	}
+}
+
+/** Stop the page compression threads, after the page cleaner has
+exited. */
+void
+buf_flush_compress_threads_shutdown()
+{
+	if (!buf_flush_compress.is_requested) {
+		return;
+	}
+
+	mutex_enter(&buf_flush_compress.mutex);
+
+	buf_flush_compress.is_running = false;
+	os_event_set(buf_flush_compress.is_requested);
+
+	while (buf_flush_compress.n_threads) {
+		const int64_t	sig_count = os_event_reset(
+			buf_flush_compress.is_finished);
+
+		mutex_exit(&buf_flush_compress.mutex);
+		os_event_wait_low(buf_flush_compress.is_finished, sig_count);
+		mutex_enter(&buf_flush_compress.mutex);
+	}
+
+	ut_ad(buf_flush_compress.jobs.empty());
+
+	mutex_exit(&buf_flush_compress.mutex);
+
+	mutex_free(&buf_flush_compress.mutex);
+	os_event_destroy(buf_flush_compress.is_requested);
+	os_event_destroy(buf_flush_compress.is_finished);
+}
+
+/** Does an asynchronous write of a buffer page. NOTE: in simulated aio
+and also when the doublewrite buffer is used, we must call
+buf_dblwr_flush_buffered_writes after we have posted a batch of
+writes! Pages of page_compressed tablespaces that are written by a
+flush batch may be handed over to the page compression threads; see
+buf_flush_compress_wait().
+@param[in,out]	bpage		buffer block to write
+@param[in]	flush_type	type of flush
+@param[in]	sync		true if sync IO request */
+static
+void
+buf_flush_write_block(
+	buf_page_t*	bpage,
+	buf_flush_t	flush_type,
+	bool		sync)
+{
+	fil_space_t* space = fil_space_acquire_for_io(bpage->id.space());
+	if (!space) {
+		return;
+	}
+
+	if (!buf_flush_compress_queue(space, bpage, flush_type)) {
+		buf_flush_write_block_low(space, bpage, flush_type, sync);
+	}
+}
+
 /********************************************************************//**
 Writes a flushable page asynchronously from the buffer pool to a file.
 NOTE: in simulated aio we must call
@@ -1179,6 +1446,7 @@ buf_flush_page(
 				/* avoiding deadlock possibility involves
 				doublewrite buffer, should flush it, because
 				it might hold the another block->lock. */
+				buf_flush_compress_wait(buf_pool, flush_type);
 				buf_dblwr_flush_buffered_writes();
 			} else {
 				buf_dblwr_sync_datafiles();
@@ -1205,7 +1473,7 @@ buf_flush_page(
 		oldest_modification != 0.  Thus, it cannot be relocated in the
 		buffer pool or removed from flush_list or LRU_list. */
 
-		buf_flush_write_block_low(bpage, flush_type, sync);
+		buf_flush_write_block(bpage, flush_type, sync);
 	}
 
 	return(flush);
@@ -1909,6 +2177,10 @@ buf_flush_end(
 	buf_flush_t	flush_type)	/*!< in: BUF_FLUSH_LRU
 					or BUF_FLUSH_LIST */
 {
+	/* Let the page compression threads add the pages of this
+	batch to the doublewrite buffer before it is flushed below. */
+	buf_flush_compress_wait(buf_pool, flush_type);
+
 	buf_pool_mutex_enter(buf_pool);
 
 	buf_pool->init_flush[flush_type] = FALSE;
@@ -2450,24 +2722,45 @@ page_cleaner_flush_pages_recommendation(
 		ulint	lru_pass = 0;
 		ulint	list_pass = 0;
 
-		for (ulint i = 0; i < page_cleaner.n_slots; i++) {
-			page_cleaner_slot_t*	slot;
-
-			slot = &page_cleaner.slots[i];
-
-			lru_tm    += slot->flush_lru_time;
-			lru_pass  += slot->flush_lru_pass;
-			list_tm   += slot->flush_list_time;
-			list_pass += slot->flush_list_pass;
-
-			slot->flush_lru_time  = 0;
-			slot->flush_lru_pass  = 0;
-			slot->flush_list_time = 0;
-			slot->flush_list_pass = 0;
+		ulint	max_instance_pages = 0;
+		ulint	min_instance_pages = ULINT_MAX;
+
+		for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+			page_cleaner_slot_t*	lru_slot
+				= pc_get_slot(i, BUF_FLUSH_LRU);
+			page_cleaner_slot_t*	list_slot
+				= pc_get_slot(i, BUF_FLUSH_LIST);
+
+			lru_tm    += lru_slot->flush_time;
+			lru_pass  += lru_slot->flush_pass;
+			list_tm   += list_slot->flush_time;
+			list_pass += list_slot->flush_pass;
+
+			ulint	instance_pages = lru_slot->n_flushed_avg
+				+ list_slot->n_flushed_avg;
+
+			max_instance_pages = std::max(max_instance_pages,
+						      instance_pages);
+			min_instance_pages = std::min(min_instance_pages,
+						      instance_pages);
+
+			lru_slot->flush_time = 0;
+			lru_slot->flush_pass = 0;
+			lru_slot->n_flushed_avg = 0;
+			list_slot->flush_time = 0;
+			list_slot->flush_pass = 0;
+			list_slot->n_flushed_avg = 0;
 		}
 
 		mutex_exit(&page_cleaner.mutex);
 
+		MONITOR_SET(MONITOR_FLUSH_INSTANCE_MAX_RATE,
+			    static_cast<ulint>(max_instance_pages
+					       / time_elapsed));
+		MONITOR_SET(MONITOR_FLUSH_INSTANCE_MIN_RATE,
+			    static_cast<ulint>(min_instance_pages
+					       / time_elapsed));
+
 		/* minimum values are 1, to avoid dividing by zero. */
 		if (lru_tm < 1) {
 			lru_tm = 1;
@@ -2507,9 +2800,9 @@ page_cleaner_flush_pages_recommendation(
 		MONITOR_SET(MONITOR_FLUSH_AVG_TIME, flush_tm / flush_pass);
 
 		MONITOR_SET(MONITOR_FLUSH_ADAPTIVE_AVG_PASS,
-			    list_pass / page_cleaner.n_slots);
+			    list_pass / srv_buf_pool_instances);
 		MONITOR_SET(MONITOR_LRU_BATCH_FLUSH_AVG_PASS,
-			    lru_pass / page_cleaner.n_slots);
+			    lru_pass / srv_buf_pool_instances);
 		MONITOR_SET(MONITOR_FLUSH_AVG_PASS, flush_pass);
 
 		prev_lsn = cur_lsn;
@@ -2553,11 +2846,16 @@ page_cleaner_flush_pages_recommendation(
 
 		sum_pages_for_lsn += pages_for_lsn;
 
+		/* A slot that is still busy with an earlier request
+		keeps that request; it will be requested again once the
+		coordinator has collected its result. */
 		mutex_enter(&page_cleaner.mutex);
-		ut_ad(page_cleaner.slots[i].state
-		      == PAGE_CLEANER_STATE_NONE);
-		page_cleaner.slots[i].n_pages_requested
-			= pages_for_lsn / buf_flush_lsn_scan_factor + 1;
+		page_cleaner_slot_t*	slot = pc_get_slot(i, BUF_FLUSH_LIST);
+		if (slot->state == PAGE_CLEANER_STATE_NONE) {
+			slot->n_pages_requested
+				= pages_for_lsn / buf_flush_lsn_scan_factor
+				+ 1;
+		}
 		mutex_exit(&page_cleaner.mutex);
 	}
 
@@ -2580,14 +2878,18 @@ page_cleaner_flush_pages_recommendation(
 	/* Normalize request for each instance */
 	mutex_enter(&page_cleaner.mutex);
 	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == 0);
 
 	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = pc_get_slot(i, BUF_FLUSH_LIST);
+
+		if (slot->state != PAGE_CLEANER_STATE_NONE) {
+			continue;
+		}
+
 		/* if REDO has enough of free space,
 		don't care about age distribution of pages */
-		page_cleaner.slots[i].n_pages_requested = pct_for_lsn > 30 ?
-			page_cleaner.slots[i].n_pages_requested
+		slot->n_pages_requested = pct_for_lsn > 30 ?
+			slot->n_pages_requested
 			* n_pages / sum_pages_for_lsn + 1
 			: n_pages / srv_buf_pool_instances;
 	}
@@ -2657,7 +2959,17 @@ buf_flush_page_cleaner_init(void)
 	page_cleaner.is_requested = os_event_create("pc_is_requested");
 	page_cleaner.is_finished = os_event_create("pc_is_finished");
 	page_cleaner.is_started = os_event_create("pc_is_started");
-	page_cleaner.n_slots = static_cast<ulint>(srv_buf_pool_instances);
+	page_cleaner.n_slots = 2 * static_cast<ulint>(srv_buf_pool_instances);
+
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		page_cleaner_slot_t*	slot = pc_get_slot(i, BUF_FLUSH_LRU);
+		slot->flush_type = BUF_FLUSH_LRU;
+		slot->instance = i;
+
+		slot = pc_get_slot(i, BUF_FLUSH_LIST);
+		slot->flush_type = BUF_FLUSH_LIST;
+		slot->instance = i;
+	}
 
 	ut_d(page_cleaner.n_disabled_debug = 0);
 
@@ -2665,9 +2977,12 @@ buf_flush_page_cleaner_init(void)
 }
 
 /**
-Requests for all slots to flush all buffer pool instances.
+Requests for the idle slots to flush all buffer pool instances.
+Slots that are still busy with an earlier request are left alone, so
+that a slow buffer pool instance does not hold back the others.
 @param min_n	wished minimum mumber of blocks flushed
-		(it is not guaranteed that the actual number is that big)
+		(it is not guaranteed that the actual number is that big);
+		0 requests LRU flushing only
 @param lsn_limit in the case BUF_FLUSH_LIST all blocks whose
 		oldest_modification is smaller than this should be flushed
 		(if their number does not exceed min_n), otherwise ignored
@@ -2678,91 +2993,145 @@ pc_request(
 	ulint		min_n,
 	lsn_t		lsn_limit)
 {
-	if (min_n != ULINT_MAX) {
-		/* Ensure that flushing is spread evenly amongst the
-		buffer pool instances. When min_n is ULINT_MAX
-		we need to flush everything up to the lsn limit
-		so no limit here. */
-		min_n = (min_n + srv_buf_pool_instances - 1)
-			/ srv_buf_pool_instances;
+	lsn_t	free_len[MAX_BUFFER_POOLS];
+	lsn_t	oldest[MAX_BUFFER_POOLS];
+
+	/* Determine the order in which the instances are served:
+	the ones that are shortest of free blocks or that hold back
+	the checkpoint the most go first. */
+	for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+		buf_pool_t*		buf_pool = buf_pool_from_array(i);
+		const buf_page_t*	bpage;
+
+		/* A dirty read is good enough for ordering. */
+		free_len[i] = UT_LIST_GET_LEN(buf_pool->free);
+
+		buf_flush_list_mutex_enter(buf_pool);
+		bpage = UT_LIST_GET_LAST(buf_pool->flush_list);
+		oldest[i] = bpage ? bpage->oldest_modification : LSN_MAX;
+		buf_flush_list_mutex_exit(buf_pool);
 	}
 
 	mutex_enter(&page_cleaner.mutex);
 
 	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == 0);
 
-	page_cleaner.requested = (min_n > 0);
-	page_cleaner.lsn_limit = lsn_limit;
+	ulint	n_requested = 0;
 
 	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
 		page_cleaner_slot_t* slot = &page_cleaner.slots[i];
 
-		ut_ad(slot->state == PAGE_CLEANER_STATE_NONE);
+		if (slot->state != PAGE_CLEANER_STATE_NONE) {
+			continue;
+		}
 
-		if (min_n == ULINT_MAX) {
-			slot->n_pages_requested = ULINT_MAX;
+		if (slot->flush_type == BUF_FLUSH_LRU) {
+			slot->order = free_len[slot->instance];
 		} else if (min_n == 0) {
-			slot->n_pages_requested = 0;
-		}
+			continue;
+		} else {
+			if (min_n == ULINT_MAX) {
+				slot->n_pages_requested = ULINT_MAX;
+			}
+
+			/* Otherwise slot->n_pages_requested was already
+			set by page_cleaner_flush_pages_recommendation() */
 
-		/* slot->n_pages_requested was already set by
-		page_cleaner_flush_pages_recommendation() */
+			slot->lsn_limit = lsn_limit;
+			slot->order = oldest[slot->instance];
+		}
 
 		slot->state = PAGE_CLEANER_STATE_REQUESTED;
+		n_requested++;
 	}
 
-	page_cleaner.n_slots_requested = page_cleaner.n_slots;
-	page_cleaner.n_slots_flushing = 0;
-	page_cleaner.n_slots_finished = 0;
+	if (n_requested) {
+		page_cleaner.n_slots_requested = n_requested;
 
-	os_event_set(page_cleaner.is_requested);
+		os_event_reset(page_cleaner.is_finished);
+		os_event_set(page_cleaner.is_requested);
+	}
 
 	mutex_exit(&page_cleaner.mutex);
 }
 
+/**
+Pick the requested slot to be flushed next. LRU flushing goes first,
+because user threads may be waiting for free blocks.
+@return the slot, or NULL if none is requested */
+static
+page_cleaner_slot_t*
+pc_pick_slot()
+{
+	ut_ad(mutex_own(&page_cleaner.mutex));
+
+	page_cleaner_slot_t*	best = NULL;
+
+	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
+		page_cleaner_slot_t*	slot = &page_cleaner.slots[i];
+
+		if (slot->state != PAGE_CLEANER_STATE_REQUESTED) {
+			continue;
+		}
+
+		if (best == NULL
+		    || (slot->flush_type == best->flush_type
+			? slot->order < best->order
+			: slot->flush_type == BUF_FLUSH_LRU)) {
+			best = slot;
+		}
+	}
+
+	return(best);
+}
+
 /**
 Do flush for one slot.
+@param worker	whether this is invoked by buf_flush_page_cleaner_worker()
 @return	the number of the slots which has not been treated yet. */
 static
 ulint
-pc_flush_slot(void)
+pc_flush_slot(bool worker = false)
 {
-	ulint	lru_tm = 0;
-	ulint	list_tm = 0;
-	ulint	lru_pass = 0;
-	ulint	list_pass = 0;
+	ulint	tm = 0;
+	ulint	pass = 0;
 
 	mutex_enter(&page_cleaner.mutex);
 
 	if (!page_cleaner.n_slots_requested) {
 		os_event_reset(page_cleaner.is_requested);
 	} else {
-		page_cleaner_slot_t*	slot = NULL;
-		ulint			i;
-
-		for (i = 0; i < page_cleaner.n_slots; i++) {
-			slot = &page_cleaner.slots[i];
-
-			if (slot->state == PAGE_CLEANER_STATE_REQUESTED) {
-				break;
-			}
-		}
+		page_cleaner_slot_t*	slot = pc_pick_slot();
 
 		/* slot should be found because
 		page_cleaner.n_slots_requested > 0 */
-		ut_a(i < page_cleaner.n_slots);
+		ut_a(slot != NULL);
 
-		buf_pool_t* buf_pool = buf_pool_from_array(i);
+#ifndef DBUG_OFF
+		/* Let a worker thread stall in the flush_list slot of the
+		first instance, so that pc_wait_finished() will time out. */
+		const bool	stall = slot->instance == 0
+			&& slot->flush_type == BUF_FLUSH_LIST
+			&& DBUG_EVALUATE_IF("page_cleaner_worker_stall",
+					    true, false);
+
+		if (stall && !worker) {
+			ulint	ret = page_cleaner.n_slots_requested;
+			mutex_exit(&page_cleaner.mutex);
+			os_thread_yield();
+			return(ret);
+		}
+#endif /* !DBUG_OFF */
+
+		buf_pool_t* buf_pool = buf_pool_from_array(slot->instance);
 
 		page_cleaner.n_slots_requested--;
 		page_cleaner.n_slots_flushing++;
 		slot->state = PAGE_CLEANER_STATE_FLUSHING;
+		slot->n_flushed = 0;
+		slot->succeeded = true;
 
 		if (UNIV_UNLIKELY(!page_cleaner.is_running)) {
-			slot->n_flushed_lru = 0;
-			slot->n_flushed_list = 0;
 			goto finish_mutex;
 		}
 
@@ -2772,50 +3141,42 @@ pc_flush_slot(void)
 
 		mutex_exit(&page_cleaner.mutex);
 
-		lru_tm = ut_time_ms();
-
-		/* Flush pages from end of LRU if required */
-		slot->n_flushed_lru = buf_flush_LRU_list(buf_pool);
+		tm = ut_time_ms();
 
-		lru_tm = ut_time_ms() - lru_tm;
-		lru_pass++;
-
-		if (UNIV_UNLIKELY(!page_cleaner.is_running)) {
-			slot->n_flushed_list = 0;
-			goto finish;
+#ifndef DBUG_OFF
+		if (stall) {
+			os_thread_sleep(2000000);
 		}
+#endif /* !DBUG_OFF */
 
-		/* Flush pages from flush_list if required */
-		if (page_cleaner.requested) {
+		if (slot->flush_type == BUF_FLUSH_LRU) {
+			/* Flush pages from end of LRU if required */
+			slot->n_flushed = buf_flush_LRU_list(buf_pool);
+		} else {
+			/* Flush pages from flush_list if required */
 			flush_counters_t n;
 			memset(&n, 0, sizeof(flush_counters_t));
-			list_tm = ut_time_ms();
 
-			slot->succeeded_list = buf_flush_do_batch(
+			slot->succeeded = buf_flush_do_batch(
 				buf_pool, BUF_FLUSH_LIST,
 				slot->n_pages_requested,
-				page_cleaner.lsn_limit,
+				slot->lsn_limit,
 				&n);
 
-			slot->n_flushed_list = n.flushed;
-
-			list_tm = ut_time_ms() - list_tm;
-			list_pass++;
-		} else {
-			slot->n_flushed_list = 0;
-			slot->succeeded_list = true;
+			slot->n_flushed = n.flushed;
 		}
-finish:
+
+		tm = ut_time_ms() - tm;
+		pass++;
+
 		mutex_enter(&page_cleaner.mutex);
 finish_mutex:
 		page_cleaner.n_slots_flushing--;
 		page_cleaner.n_slots_finished++;
 		slot->state = PAGE_CLEANER_STATE_FINISHED;
 
-		slot->flush_lru_time += lru_tm;
-		slot->flush_list_time += list_tm;
-		slot->flush_lru_pass += lru_pass;
-		slot->flush_list_pass += list_pass;
+		slot->flush_time += tm;
+		slot->flush_pass += pass;
 
 		if (page_cleaner.n_slots_requested == 0
 		    && page_cleaner.n_slots_flushing == 0) {
@@ -2831,47 +3192,78 @@ pc_flush_slot(void)
 }
 
 /**
-Wait until all flush requests are finished.
+Wait until the flush requests are finished, and collect the results
+of the finished slots.
 @param n_flushed_lru	number of pages flushed from the end of the LRU list.
 @param n_flushed_list	number of pages flushed from the end of the
 			flush_list.
-@return			true if all flush_list flushing batch were success. */
+@param timeout_us	0 to wait for all slots; otherwise the maximum
+			time to wait, in microseconds, after which the slots
+			that are still being flushed are left running and
+			counted as stalls of their buffer pool instance
+@return			true if all collected flush_list flushing batches
+			were successful. */
 static
 bool
 pc_wait_finished(
 	ulint*	n_flushed_lru,
-	ulint*	n_flushed_list)
+	ulint*	n_flushed_list,
+	ulint	timeout_us = 0)
 {
 	bool	all_succeeded = true;
 
 	*n_flushed_lru = 0;
 	*n_flushed_list = 0;
 
-	os_event_wait(page_cleaner.is_finished);
+	if (timeout_us == 0) {
+		os_event_wait(page_cleaner.is_finished);
+	} else {
+		os_event_wait_time(page_cleaner.is_finished, timeout_us);
+	}
 
 	mutex_enter(&page_cleaner.mutex);
 
-	ut_ad(page_cleaner.n_slots_requested == 0);
-	ut_ad(page_cleaner.n_slots_flushing == 0);
-	ut_ad(page_cleaner.n_slots_finished == page_cleaner.n_slots);
+	ut_ad(timeout_us || page_cleaner.n_slots_requested == 0);
+	ut_ad(timeout_us || page_cleaner.n_slots_flushing == 0);
+
+	bool	stalled[MAX_BUFFER_POOLS];
+	memset(stalled, 0, sizeof stalled);
 
 	for (ulint i = 0; i < page_cleaner.n_slots; i++) {
 		page_cleaner_slot_t* slot = &page_cleaner.slots[i];
+		buf_pool_t*	buf_pool = buf_pool_from_array(slot->instance);
 
-		ut_ad(slot->state == PAGE_CLEANER_STATE_FINISHED);
+		switch (slot->state) {
+		case PAGE_CLEANER_STATE_NONE:
+			continue;
+		case PAGE_CLEANER_STATE_REQUESTED:
+		case PAGE_CLEANER_STATE_FLUSHING:
+			if (!stalled[slot->instance]) {
+				stalled[slot->instance] = true;
+				buf_pool->stat.n_page_cleaner_stalls++;
+				MONITOR_INC(MONITOR_FLUSH_INSTANCE_STALLS);
+			}
+			continue;
+		case PAGE_CLEANER_STATE_FINISHED:
+			break;
+		}
 
-		*n_flushed_lru += slot->n_flushed_lru;
-		*n_flushed_list += slot->n_flushed_list;
-		all_succeeded &= slot->succeeded_list;
+		if (slot->flush_type == BUF_FLUSH_LRU) {
+			*n_flushed_lru += slot->n_flushed;
+			buf_pool->stat.n_page_cleaner_lru += slot->n_flushed;
+		} else {
+			*n_flushed_list += slot->n_flushed;
+			buf_pool->stat.n_page_cleaner_list += slot->n_flushed;
+			all_succeeded &= slot->succeeded;
+			slot->n_pages_requested = 0;
+		}
 
+		slot->n_flushed_avg += slot->n_flushed;
 		slot->state = PAGE_CLEANER_STATE_NONE;
-
-		slot->n_pages_requested = 0;
+		page_cleaner.n_slots_finished--;
 	}
 
-	page_cleaner.n_slots_finished = 0;
-
-	os_event_reset(page_cleaner.is_finished);
+	ut_ad(page_cleaner.n_slots_finished == 0);
 
 	mutex_exit(&page_cleaner.mutex);
 
@@ -3213,11 +3605,18 @@ DECLARE_THREAD(buf_flush_page_cleaner_coordinator)(void*)
 			page_cleaner.flush_time += ut_time_ms() - tm;
 			page_cleaner.flush_pass++ ;
 
-			/* Wait for all slots to be finished */
+			/* Wait for the slots to be finished, but not
+			beyond this iteration. Slots of slow instances
+			are left running and collected later, so that
+			the other instances can be requested again. */
 			ulint	n_flushed_lru = 0;
 			ulint	n_flushed_list = 0;
+			ulint	now = ut_time_ms();
 
-			pc_wait_finished(&n_flushed_lru, &n_flushed_list);
+			pc_wait_finished(&n_flushed_lru, &n_flushed_list,
+					 next_loop_time > now
+					 ? (next_loop_time - now) * 1000
+					 : 1);
 
 			if (n_flushed_list > 0 || n_flushed_lru > 0) {
 				buf_flush_stats(n_flushed_list, n_flushed_lru);
@@ -3470,7 +3869,7 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 			break;
 		}
 
-		pc_flush_slot();
+		pc_flush_slot(true);
 	}
 
 	mutex_enter(&page_cleaner.mutex);
@@ -115,12 +115,42 @@ buf_LRU_stat_t	buf_LRU_stat_cur;
 Updated by buf_LRU_stat_update().  Not Protected by any mutex. */
 buf_LRU_stat_t	buf_LRU_stat_sum;
 
+/** Number of slots in buf_LRU_unzip_stat[]. Indexes are hashed to
+the slots by their id. */
+static const ulint BUF_LRU_UNZIP_STAT_N = 256;
+
+/** Minimum number of evicted uncompressed frames in a slot before
+the frames of the slot can be considered costly to evict */
+static const ulint BUF_LRU_UNZIP_MIN_EVICTED = 16;
+
+/** Per-index counters for evicting uncompressed frames of
+ROW_FORMAT=COMPRESSED pages.  Not protected by any mutex.
+Halved by buf_LRU_stat_update(). */
+static struct
+{
+	/** number of uncompressed frames evicted from unzip_LRU */
+	ulint	evicted;
+	/** number of pages decompressed again after eviction */
+	ulint	refetched;
+} buf_LRU_unzip_stat[BUF_LRU_UNZIP_STAT_N];
+
+/** Get the buf_LRU_unzip_stat[] slot of an index page.
+@param[in]	frame	uncompressed index page
+@return the slot */
+static inline ulint buf_LRU_unzip_stat_slot(const page_t* frame)
+{
+	return ulint(btr_page_get_index_id(frame) % BUF_LRU_UNZIP_STAT_N);
+}
+
 /* @} */
 
 /** @name Heuristics for detecting index scan @{ */
 /** Move blocks to "new" LRU list only if the first access was at
 least this many milliseconds ago.  Not protected by any mutex or latch. */
 uint	buf_LRU_old_threshold_ms;
+
+/** innodb_buffer_pool_lru_policy */
+ulong	buf_LRU_policy;
 /* @} */
 
 /******************************************************************//**
@@ -759,9 +789,45 @@ buf_LRU_insert_zip_clean(
 }
 #endif /* UNIV_DEBUG || UNIV_BUF_DEBUG */
 
+/** Note that a ROW_FORMAT=COMPRESSED index page had to be decompressed
+again after its uncompressed frame had been evicted.
+@param[in]	block	the block that the page was decompressed into */
+void
+buf_LRU_stat_inc_refetch(const buf_block_t* block)
+{
+	if (fil_page_index_page_check(block->frame)) {
+		buf_LRU_unzip_stat[buf_LRU_unzip_stat_slot(block->frame)]
+			.refetched++;
+		MONITOR_INC(MONITOR_LRU_UNZIP_REFETCH);
+	}
+}
+
+/** Determine if evicting the uncompressed frame of a block is likely
+to be undone soon.  This is the case when most of the recently evicted
+frames of the index had to be decompressed again.
+@param[in]	block	block in buf_pool->unzip_LRU
+@return whether the uncompressed frame should be kept */
+static
+bool
+buf_LRU_unzip_is_costly(const buf_block_t* block)
+{
+	if (!fil_page_index_page_check(block->frame)) {
+		return(false);
+	}
+
+	const ulint slot = buf_LRU_unzip_stat_slot(block->frame);
+	const ulint evicted = buf_LRU_unzip_stat[slot].evicted;
+
+	return(evicted >= BUF_LRU_UNZIP_MIN_EVICTED
+	       && buf_LRU_unzip_stat[slot].refetched * 2 >= evicted);
+}
+
 /******************************************************************//**
 Try to free an uncompressed page of a compressed block from the unzip
 LRU list.  The compressed page is preserved, and it need not be clean.
+Unless the whole list is to be scanned, the frames of indexes that are
+frequently decompressed again are skipped; if nothing else can be
+freed, buf_LRU_free_from_common_LRU_list() will evict entire blocks.
 @return true if freed */
 static
 bool
@@ -779,6 +845,7 @@ buf_LRU_free_from_unzip_LRU_list(
 	}
 
 	ulint	scanned = 0;
+	ulint	kept = 0;
 	bool	freed = false;
 
 	for (buf_block_t* block = UT_LIST_GET_LAST(buf_pool->unzip_LRU);
@@ -795,11 +862,28 @@ buf_LRU_free_from_unzip_LRU_list(
 		ut_ad(block->in_unzip_LRU_list);
 		ut_ad(block->page.in_LRU_list);
 
-		freed = buf_LRU_free_page(&block->page, false);
+		if (!scan_all && buf_LRU_unzip_is_costly(block)) {
+			kept++;
+		} else {
+			const bool index_page = fil_page_index_page_check(
+				block->frame);
+			const ulint slot = index_page
+				? buf_LRU_unzip_stat_slot(block->frame) : 0;
+
+			freed = buf_LRU_free_page(&block->page, false);
+
+			if (freed && index_page) {
+				buf_LRU_unzip_stat[slot].evicted++;
+			}
+		}
 
 		block = prev_block;
 	}
 
+	if (kept) {
+		MONITOR_INC_VALUE(MONITOR_LRU_UNZIP_KEPT, kept);
+	}
+
 	if (scanned) {
 		MONITOR_INC_VALUE_CUMULATIVE(
 			MONITOR_LRU_UNZIP_SEARCH_SCANNED,
@@ -1535,6 +1619,24 @@ buf_LRU_add_block(
 				added to the start, regardless of this
 				parameter */
 {
+	buf_pool_t*	buf_pool = buf_pool_from_bpage(bpage);
+
+	if (old && buf_pool->LRU_ghost != NULL) {
+		ulint	fold = bpage->id.fold();
+		ulint&	ghost = buf_pool->LRU_ghost[
+			fold % buf_pool->LRU_ghost_size];
+
+		if (ghost == fold) {
+			/* The page was evicted not long ago after it
+			had proven to be useful. Let it skip the
+			probation in the old sublist. */
+			ghost = 0;
+			old = FALSE;
+			buf_pool->stat.n_pages_ghost_young++;
+			MONITOR_INC(MONITOR_LRU_GHOST_HITS);
+		}
+	}
+
 	buf_LRU_add_block_low(bpage, old);
 }
 
@@ -1914,6 +2016,17 @@ buf_LRU_block_remove_hashed(
 
 	buf_LRU_remove_block(bpage);
 
+	if (buf_pool->LRU_ghost != NULL && bpage->freed_page_clock) {
+		/* The page was in the "new" sublist at some point.
+		A page that was only accessed by a scan is never
+		moved there. Remember the page, so that it can skip
+		the old sublist if it is read again soon. */
+		ulint	fold = bpage->id.fold();
+
+		buf_pool->LRU_ghost[fold % buf_pool->LRU_ghost_size] = fold;
+		MONITOR_INC(MONITOR_LRU_GHOST_ADDED);
+	}
+
 	buf_pool->freed_page_clock += 1;
 
 	switch (buf_page_get_state(bpage)) {
@@ -2283,6 +2396,13 @@ buf_LRU_stat_update(void)
 	/* Put current entry in the array. */
 	memcpy(item, &cur_stat, sizeof *item);
 
+	/* Let the per-index statistics decay, so that they reflect
+	the recent workload. */
+	for (ulint i = 0; i < BUF_LRU_UNZIP_STAT_N; i++) {
+		buf_LRU_unzip_stat[i].evicted /= 2;
+		buf_LRU_unzip_stat[i].refetched /= 2;
+	}
+
 func_exit:
 	/* Clear the current entry. */
 	memset(&buf_LRU_stat_cur, 0, sizeof buf_LRU_stat_cur);
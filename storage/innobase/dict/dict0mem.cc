@@ -33,6 +33,7 @@ Created 1/8/1996 Heikki Tuuri
 #include "data0type.h"
 #include "mach0data.h"
 #include "dict0dict.h"
+#include "btr0cur.h"
 #include "fts0priv.h"
 #include "lock0lock.h"
 #include "sync0sync.h"
@@ -1062,6 +1063,7 @@ dict_mem_index_free(
 	ut_ad(index->magic_n == DICT_INDEX_MAGIC_N);
 
 	dict_index_zip_pad_mutex_destroy(index);
+	btr_range_cache_free(index);
 
 	if (dict_index_is_spatial(index)) {
 		rtr_info_active::iterator	it;
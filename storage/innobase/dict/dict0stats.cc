@@ -37,6 +37,7 @@ Created Jan 06, 2010 Vasil Dimov
 #include <algorithm>
 #include <map>
 #include <vector>
+#include <math.h>
 
 /* Sampling algorithm description @{
 
@@ -2201,10 +2202,68 @@ dict_stats_analyze_index(
 	DBUG_VOID_RETURN;
 }
 
+/** Indexes of a table that are being sampled by
+dict_stats_analyze_thread() and dict_stats_update_persistent() */
+struct dict_stats_analyze_ctx_t
+{
+	/** the table whose statistics are being calculated */
+	dict_table_t*		table;
+	/** the indexes to analyze; the clustered index first, and
+	then the secondary indexes from the largest to the smallest */
+	dict_index_t**		indexes;
+	/** number of indexes[] */
+	ulint			n_indexes;
+	/** the next element of indexes[] to pick */
+	Atomic_counter<ulint>	next;
+};
+
+/** Analyze indexes until there are none left.
+@param[in,out]	ctx	indexes to analyze */
+static
+void
+dict_stats_analyze_indexes(dict_stats_analyze_ctx_t* ctx)
+{
+	for (ulint i; (i = ctx->next++) < ctx->n_indexes; ) {
+		/* The clustered index is always analyzed. The secondary
+		indexes are skipped if DROP TABLE is waiting for us. */
+		if (i == 0
+		    || !(ctx->table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
+			dict_stats_analyze_index(ctx->indexes[i]);
+		}
+	}
+}
+
+/** Thread that samples indexes of a table in parallel with
+dict_stats_update_persistent().
+@param[in,out]	arg	dict_stats_analyze_ctx_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(dict_stats_analyze_thread)(void* arg)
+{
+	dict_stats_analyze_indexes(
+		static_cast<dict_stats_analyze_ctx_t*>(arg));
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Compare the sizes of indexes for sorting them from the largest
+to the smallest, by the statistics of the previous run. */
+struct dict_stats_index_size_greater
+{
+	bool operator()(const dict_index_t* a, const dict_index_t* b) const
+	{
+		return(a->stat_index_size > b->stat_index_size);
+	}
+};
+
 /*********************************************************************//**
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
-will be saved on disk.
+will be saved on disk. With innodb_stats_threads>1, the indexes are
+sampled by several threads.
 @return DB_SUCCESS or error code */
 static
 dberr_t
@@ -2218,8 +2277,6 @@ dict_stats_update_persistent(
 
 	dict_table_stats_lock(table, RW_X_LATCH);
 
-	/* analyze the clustered index first */
-
 	index = dict_table_get_first_index(table);
 
 	if (index == NULL
@@ -2235,17 +2292,16 @@ dict_stats_update_persistent(
 
 	ut_ad(!dict_index_is_ibuf(index));
 
-	dict_stats_analyze_index(index);
+	dict_stats_analyze_ctx_t	ctx;
 
-	ulint	n_unique = dict_index_get_n_unique(index);
-
-	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+	ctx.table = table;
+	ctx.indexes = UT_NEW_ARRAY_NOKEY(dict_index_t*,
+					 UT_LIST_GET_LEN(table->indexes));
+	ctx.n_indexes = 0;
+	ctx.next = 0;
 
-	table->stat_clustered_index_size = index->stat_index_size;
-
-	/* analyze other indexes from the table, if any */
-
-	table->stat_sum_of_other_index_sizes = 0;
+	/* analyze the clustered index first */
+	ctx.indexes[ctx.n_indexes++] = index;
 
 	for (index = dict_table_get_next_index(index);
 	     index != NULL;
@@ -2257,24 +2313,75 @@ dict_stats_update_persistent(
 			continue;
 		}
 
+		ctx.indexes[ctx.n_indexes++] = index;
+	}
+
+	/* Hand out the largest secondary indexes first, so that
+	a big index that is picked last does not leave the other
+	threads idle. */
+	std::sort(ctx.indexes + 1, ctx.indexes + ctx.n_indexes,
+		  dict_stats_index_size_greater());
+
+	ulint	n_indexes = 1;
+
+	for (ulint i = 1; i < ctx.n_indexes; i++) {
+		index = ctx.indexes[i];
+
 		dict_stats_empty_index(index, false);
 
-		if (dict_stats_should_ignore_index(index)) {
-			continue;
+		if (!dict_stats_should_ignore_index(index)) {
+			ctx.indexes[n_indexes++] = index;
 		}
+	}
 
-		if (!(table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
-			dict_stats_analyze_index(index);
+	ctx.n_indexes = n_indexes;
+
+	/* The calling thread samples indexes too. */
+	const ulint	n_threads = std::min(ulint(srv_stats_threads),
+					     ctx.n_indexes) - 1;
+	os_thread_id_t*	thread_ids = NULL;
+
+	if (n_threads) {
+		thread_ids = static_cast<os_thread_id_t*>(
+			ut_malloc_nokey(n_threads * sizeof *thread_ids));
+
+		for (ulint t = 0; t < n_threads; t++) {
+			os_thread_create(dict_stats_analyze_thread, &ctx,
+					 &thread_ids[t]);
 		}
+	}
+
+	dict_stats_analyze_indexes(&ctx);
+
+	for (ulint t = 0; t < n_threads; t++) {
+		os_thread_join(thread_ids[t]);
+	}
+
+	ut_free(thread_ids);
+
+	index = ctx.indexes[0];
+
+	ulint	n_unique = dict_index_get_n_unique(index);
+
+	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+
+	table->stat_clustered_index_size = index->stat_index_size;
+
+	table->stat_sum_of_other_index_sizes = 0;
 
+	for (ulint i = 1; i < ctx.n_indexes; i++) {
 		table->stat_sum_of_other_index_sizes
-			+= index->stat_index_size;
+			+= ctx.indexes[i]->stat_index_size;
 	}
 
+	UT_DELETE_ARRAY(ctx.indexes);
+
 	table->stats_last_recalc = ut_time();
 
 	table->stat_modified_counter = 0;
 
+	table->stats_n_incremental = 0;
+
 	table->stat_initialized = TRUE;
 
 	dict_stats_assert_initialized(table);
@@ -2284,6 +2391,134 @@ dict_stats_update_persistent(
 	return(DB_SUCCESS);
 }
 
+/** Extrapolate the persistent statistics of a table from the change of
+the index sizes since the previous recalculation, instead of sampling the
+indexes again. The number of distinct values of a key prefix is assumed to
+grow as a power of the number of records, so that the estimate for a
+unique prefix grows with the number of leaf pages and the estimate for a
+prefix with few distinct values stays nearly constant.
+@param[in,out]	table	table
+@return whether the statistics were updated
+@retval	false	if the indexes must be sampled */
+static
+bool
+dict_stats_update_incremental(dict_table_t* table)
+{
+	if (!table->stat_initialized
+	    || table->stats_n_incremental >= srv_stats_incremental_recalc) {
+		return(false);
+	}
+
+	dict_table_stats_lock(table, RW_X_LATCH);
+
+	dict_index_t*	index = dict_table_get_first_index(table);
+
+	if (index == NULL || dict_stats_should_ignore_index(index)
+	    || !dict_index_is_clust(index)) {
+		dict_table_stats_unlock(table, RW_X_LATCH);
+		return(false);
+	}
+
+	/* Read the sizes of all indexes first, so that either all or
+	none of the estimates are extrapolated. */
+	const ulint	n = UT_LIST_GET_LEN(table->indexes);
+	ulint*		size = UT_NEW_ARRAY_NOKEY(ulint, 2 * n);
+	ulint*		n_leaf_pages = size + n;
+	bool		ok = true;
+	ulint		i = 0;
+
+	for (; ok && index != NULL;
+	     index = dict_table_get_next_index(index), i++) {
+
+		if (dict_stats_should_ignore_index(index)) {
+			continue;
+		}
+
+		mtr_t	mtr;
+
+		mtr.start();
+		mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+		size[i] = btr_get_size(index, BTR_TOTAL_SIZE, &mtr);
+
+		if (size[i] != ULINT_UNDEFINED) {
+			n_leaf_pages[i] = std::max(
+				btr_get_size(index, BTR_N_LEAF_PAGES, &mtr),
+				ulint(1));
+		}
+
+		mtr.commit();
+
+		/* Sample the index again if it is unreadable, or if
+		it has more than doubled or halved in size. */
+		ok = size[i] != ULINT_UNDEFINED
+			&& n_leaf_pages[i] != ULINT_UNDEFINED
+			&& n_leaf_pages[i] <= 2 * index->stat_n_leaf_pages
+			&& 2 * n_leaf_pages[i] >= index->stat_n_leaf_pages;
+	}
+
+	if (ok) {
+		table->stat_sum_of_other_index_sizes = 0;
+
+		for (i = 0, index = dict_table_get_first_index(table);
+		     index != NULL;
+		     index = dict_table_get_next_index(index), i++) {
+
+			if (dict_stats_should_ignore_index(index)) {
+				continue;
+			}
+
+			const ulint	n_uniq = index->n_uniq;
+			const double	ratio = double(n_leaf_pages[i])
+				/ double(index->stat_n_leaf_pages);
+			const double	n_recs = double(
+				index->stat_n_diff_key_vals[n_uniq - 1]);
+
+			for (ulint j = 0; j < n_uniq; j++) {
+				double	n_diff = double(
+					index->stat_n_diff_key_vals[j]);
+
+				if (n_diff > 1 && n_recs > 1) {
+					n_diff *= pow(ratio, log(n_diff)
+						      / log(n_recs));
+				}
+
+				index->stat_n_diff_key_vals[j]
+					= ib_uint64_t(n_diff + 0.5);
+				index->stat_n_non_null_key_vals[j]
+					= ib_uint64_t(double(
+						index->stat_n_non_null_key_vals[j])
+						* ratio + 0.5);
+			}
+
+			index->stat_index_size = size[i];
+			index->stat_n_leaf_pages = n_leaf_pages[i];
+
+			if (dict_index_is_clust(index)) {
+				table->stat_n_rows
+					= index->stat_n_diff_key_vals[
+						n_uniq - 1];
+				table->stat_clustered_index_size = size[i];
+			} else {
+				table->stat_sum_of_other_index_sizes
+					+= size[i];
+			}
+		}
+
+		table->stats_n_incremental++;
+		table->stats_last_recalc = ut_time();
+		table->stat_modified_counter = 0;
+
+		dict_stats_assert_initialized(table);
+	}
+
+	dict_table_stats_unlock(table, RW_X_LATCH);
+
+	UT_DELETE_ARRAY(size);
+
+	return(ok);
+}
+
 #include "mysql_com.h"
 /** Save an individual index's statistic into the persistent statistics
 storage.
@@ -3166,6 +3401,7 @@ dict_stats_update(
 	}
 
 	switch (stats_upd_option) {
+	case DICT_STATS_RECALC_INCREMENTAL:
 	case DICT_STATS_RECALC_PERSISTENT:
 
 		if (srv_read_only_mode) {
@@ -3174,7 +3410,8 @@ dict_stats_update(
 
 		/* Persistent recalculation requested, called from
 		1) ANALYZE TABLE, or
-		2) the auto recalculation background thread, or
+		2) the auto recalculation background thread, which passes
+		   DICT_STATS_RECALC_INCREMENTAL, or
 		3) open table if stats do not exist on disk and auto recalc
 		   is enabled */
 
@@ -3190,10 +3427,13 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			if (stats_upd_option != DICT_STATS_RECALC_INCREMENTAL
+			    || !dict_stats_update_incremental(table)) {
+				err = dict_stats_update_persistent(table);
 
-			if (err != DB_SUCCESS) {
-				return(err);
+				if (err != DB_SUCCESS) {
+					return(err);
+				}
 			}
 
 			err = dict_stats_save(table, NULL);
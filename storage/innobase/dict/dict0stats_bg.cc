@@ -411,7 +411,7 @@ dict_stats_process_entry_from_recalc_pool()
 
 	} else {
 
-		dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT);
+		dict_stats_update(table, DICT_STATS_RECALC_INCREMENTAL);
 	}
 
 	mutex_enter(&dict_sys->mutex);
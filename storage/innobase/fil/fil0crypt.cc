@@ -39,6 +39,8 @@ Modified           Jan Lindström jan.lindstrom@mariadb.com
 #include "btr0scrub.h"
 #include "fsp0fsp.h"
 #include "fil0pagecompress.h"
+#include "buf0rea.h"
+#include "buf0dblwr.h"
 #include <my_crypt.h>
 
 /** Mutex for keys */
@@ -78,6 +80,14 @@ UNIV_INTERN uint srv_n_fil_crypt_iops = 100;	 // 10ms per iop
 static uint srv_alloc_time = 3;		    // allocate iops for 3s at a time
 static uint n_fil_crypt_iops_allocated = 0;
 
+/** Minimum number of pages that must remain to be rotated per thread
+for another key rotation thread to join the rotation of a tablespace.
+Smaller tablespaces are rotated by one thread each, in parallel. */
+static const ulint FIL_CRYPT_PAGES_PER_THREAD = 1024;
+
+/** Number of pages that a key rotation thread submits reads for at a time */
+static const ulint FIL_CRYPT_READ_AHEAD = 64;
+
 /** Variables for scrubbing */
 extern uint srv_background_scrub_data_interval;
 extern uint srv_background_scrub_data_check_interval;
@@ -1418,6 +1428,20 @@ fil_crypt_space_needs_rotation(
 			break;
 		}
 
+		/* Join the threads that are already rotating the space
+		only if enough pages remain for all of them. Otherwise,
+		look for another tablespace to rotate. */
+		if (ulint n = crypt_data->rotate_state.active_threads) {
+			const fil_space_rotate_state_t& r
+				= crypt_data->rotate_state;
+
+			if (r.next_offset > r.max_offset
+			    || r.max_offset - r.next_offset
+			    < (n + 1) * FIL_CRYPT_PAGES_PER_THREAD) {
+				break;
+			}
+		}
+
 		/* No need to rotate space if encryption is disabled */
 		if (crypt_data->not_encrypted()) {
 			break;
@@ -2144,6 +2168,81 @@ fil_crypt_rotate_page(
 	}
 }
 
+/** Submit asynchronous reads for pages to be rotated.
+Pages that are marked free in the allocation bitmap are not read.
+@param[in]	state	rotation state
+@param[in]	end	end of the batch of pages
+@param[out]	n_reads	number of reads that were submitted
+@return the page number after the last page that reads were submitted for */
+static
+ulint
+fil_crypt_read_ahead(
+	const rotate_thread_t*	state,
+	ulint			end,
+	ulint*			n_reads)
+{
+	fil_space_t*		space = state->space;
+	const ulint		zip_size = space->zip_size();
+	const ulint		last = std::min(end,
+						state->offset
+						+ FIL_CRYPT_READ_AHEAD);
+
+	for (ulint offset = state->offset; offset < last; offset++) {
+		if (space->is_stopping()) {
+			break;
+		}
+
+		if (space->id == TRX_SYS_SPACE
+		    && (offset == TRX_SYS_PAGE_NO
+			|| buf_dblwr_page_inside(offset))) {
+			continue;
+		}
+
+		const page_id_t	page_id(space->id, offset);
+
+		/* No page latches are being held here, so it is
+		safe to consult the allocation bitmap. A page that
+		is allocated after this check will be read by
+		fil_crypt_get_page_throttle(). */
+		if (!buf_page_peek(page_id)
+		    && !fseg_page_is_free(space, unsigned(offset))) {
+			buf_read_page_background(page_id, zip_size, false);
+			(*n_reads)++;
+		}
+	}
+
+	os_aio_simulated_wake_handler_threads();
+
+	return(last);
+}
+
+/** Sleep if the pages of a read-ahead window were read faster than
+the allocated iops allow.
+@param[in]	state	rotation state
+@param[in]	n_reads	number of pages read in the window
+@param[in]	start	time when the reads were submitted, in microseconds */
+static
+void
+fil_crypt_throttle_read_ahead(
+	const rotate_thread_t*	state,
+	ulint			n_reads,
+	uintmax_t		start)
+{
+	if (!n_reads) {
+		return;
+	}
+
+	const uintmax_t	budget_us = n_reads * 1000000
+		/ std::max(state->allocated_iops, 1U);
+	const uintmax_t	elapsed_us = ut_time_us(NULL) - start;
+
+	if (elapsed_us < budget_us) {
+		os_event_reset(fil_crypt_throttle_sleep_event);
+		os_event_wait_time(fil_crypt_throttle_sleep_event,
+				   ulint(budget_us - elapsed_us));
+	}
+}
+
 /***********************************************************************
 Rotate a batch of pages
 @param[in,out]		key_state		Key state
@@ -2157,11 +2256,28 @@ fil_crypt_rotate_pages(
 	ulint space = state->space->id;
 	ulint end = std::min(state->offset + state->batch,
 			     state->space->free_limit);
+	ulint read_ahead = state->offset;
+	ulint n_reads = 0;
+	uintmax_t read_ahead_start = 0;
 
 	ut_ad(state->space->referenced());
 
 	for (; state->offset < end; state->offset++) {
 
+		if (state->offset == read_ahead) {
+			/* Submit the reads for the next pages, so that
+			fil_crypt_get_page_throttle() will not have to
+			read them one by one. The pages will be found
+			in the buffer pool, so the allocated iops are
+			enforced per window instead of per page. */
+			fil_crypt_throttle_read_ahead(state, n_reads,
+						      read_ahead_start);
+			n_reads = 0;
+			read_ahead_start = ut_time_us(NULL);
+			read_ahead = fil_crypt_read_ahead(state, end,
+							  &n_reads);
+		}
+
 		/* we can't rotate pages in dblwr buffer as
 		* it's not possible to read those due to lots of asserts
 		* in buffer pool.
@@ -2183,6 +2299,8 @@ fil_crypt_rotate_pages(
 
 		fil_crypt_rotate_page(key_state, state);
 	}
+
+	fil_crypt_throttle_read_ahead(state, n_reads, read_ahead_start);
 }
 
 /***********************************************************************
@@ -2633,6 +2751,30 @@ fil_space_crypt_close_tablespace(
 	mutex_exit(&crypt_data->mutex);
 }
 
+/** Estimate the remaining time of key rotation in a tablespace.
+@param[in]	rotate_state	key rotation state of the tablespace
+@return estimated number of seconds, or ULINT_UNDEFINED if not known */
+static
+ulint
+fil_crypt_rotate_eta(const fil_space_rotate_state_t& rotate_state)
+{
+	if (rotate_state.flushing) {
+		return(ULINT_UNDEFINED);
+	}
+
+	const time_t	elapsed = time(0) - rotate_state.start_time;
+	/* Page 0 is not rotated. */
+	const ulint	next = std::min(rotate_state.next_offset,
+					rotate_state.max_offset + 1);
+
+	if (elapsed <= 0 || next <= 1) {
+		return(ULINT_UNDEFINED);
+	}
+
+	return(ulint((rotate_state.max_offset + 1 - next)
+		     * ulonglong(elapsed) / (next - 1)));
+}
+
 /*********************************************************************
 Get crypt status for a space (used by information_schema)
 @param[in]	space		Tablespace
@@ -2673,6 +2815,10 @@ fil_space_crypt_get_status(
 				crypt_data->rotate_state.next_offset;
 			status->rotate_max_page_number =
 				crypt_data->rotate_state.max_offset;
+			status->rotate_threads =
+				crypt_data->rotate_state.active_threads;
+			status->rotate_eta = fil_crypt_rotate_eta(
+				crypt_data->rotate_state);
 		}
 
 		mutex_exit(&crypt_data->mutex);
@@ -441,6 +441,9 @@ static bool fil_comp_algo_validate(const fil_space_t* space)
 #ifdef HAVE_SNAPPY
 	case PAGE_SNAPPY_ALGORITHM:
 #endif /* HAVE_SNAPPY */
+#ifdef HAVE_ZSTD
+	case PAGE_ZSTD_ALGORITHM:
+#endif /* HAVE_ZSTD */
 		return true;
 	}
 
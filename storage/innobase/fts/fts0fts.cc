@@ -898,6 +898,11 @@ fts_drop_index(
 				rbt_free(index_cache->words);
 			}
 
+			if (index_cache->sync_words) {
+				fts_words_free(index_cache->sync_words);
+				rbt_free(index_cache->sync_words);
+			}
+
 			ib_vector_remove(cache->indexes, *(void**) index_cache);
 		}
 
@@ -1074,6 +1079,107 @@ fts_words_free(
 	}
 }
 
+/** Free the query graphs of an index cache.
+@param[in,out]	index_cache	index cache */
+static
+void
+fts_index_cache_free_graphs(
+	fts_index_cache_t*	index_cache)
+{
+	for (ulint j = 0; j < FTS_NUM_AUX_INDEX; ++j) {
+
+		if (index_cache->ins_graph[j] != NULL) {
+
+			fts_que_graph_free_check_lock(
+				NULL, index_cache, index_cache->ins_graph[j]);
+
+			index_cache->ins_graph[j] = NULL;
+		}
+
+		if (index_cache->sel_graph[j] != NULL) {
+
+			fts_que_graph_free_check_lock(
+				NULL, index_cache, index_cache->sel_graph[j]);
+
+			index_cache->sel_graph[j] = NULL;
+		}
+	}
+}
+
+/** A SYNC snapshot that was unlinked from the cache */
+struct fts_sync_snapshot_t {
+	/** memory of the snapshot, including this object */
+	mem_heap_t*	heap;
+	/** number of elements in words */
+	ulint		n_words;
+	/** the words of each index cache, or NULL */
+	ib_rbt_t**	words;
+};
+
+/** Unlink the SYNC snapshot from the cache, so that it can be freed
+by fts_sync_free_snapshot() after the cache lock has been released.
+@param[in,out]	cache	fts cache, X-latched or not accessible
+			by other threads
+@return the snapshot
+@retval	NULL	if there is no snapshot */
+static
+fts_sync_snapshot_t*
+fts_sync_unlink_snapshot(
+	fts_cache_t*	cache)
+{
+	fts_sync_t*	sync = cache->sync;
+
+	if (sync->heap == NULL) {
+		return(NULL);
+	}
+
+	const ulint		n = ib_vector_size(cache->indexes);
+	fts_sync_snapshot_t*	snapshot = static_cast<fts_sync_snapshot_t*>(
+		mem_heap_alloc(sync->heap, sizeof *snapshot));
+
+	snapshot->heap = sync->heap;
+	snapshot->n_words = n;
+	snapshot->words = static_cast<ib_rbt_t**>(
+		mem_heap_alloc(sync->heap, n * sizeof *snapshot->words));
+
+	for (ulint i = 0; i < n; ++i) {
+		fts_index_cache_t*	index_cache;
+
+		index_cache = static_cast<fts_index_cache_t*>(
+			ib_vector_get(cache->indexes, i));
+
+		snapshot->words[i] = index_cache->sync_words;
+		index_cache->sync_words = NULL;
+	}
+
+	/* We need to do this within the deleted lock since
+	fts_cache_append_deleted_doc_ids() may be reading them. */
+	mutex_enter(&cache->deleted_lock);
+	sync->deleted_doc_ids = NULL;
+	mutex_exit(&cache->deleted_lock);
+
+	sync->heap = NULL;
+
+	return(snapshot);
+}
+
+/** Free a SYNC snapshot that was unlinked from the cache.
+@param[in,out]	snapshot	fts_sync_unlink_snapshot() */
+static
+void
+fts_sync_free_snapshot(
+	fts_sync_snapshot_t*	snapshot)
+{
+	for (ulint i = 0; i < snapshot->n_words; ++i) {
+		if (ib_rbt_t* words = snapshot->words[i]) {
+			fts_words_free(words);
+			rbt_free(words);
+		}
+	}
+
+	mem_heap_free(snapshot->heap);
+}
+
 /** Clear cache.
 @param[in,out]	cache	fts cache */
 void
@@ -1083,7 +1189,6 @@ fts_cache_clear(
 	ulint		i;
 
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		ulint			j;
 		fts_index_cache_t*	index_cache;
 
 		index_cache = static_cast<fts_index_cache_t*>(
@@ -1095,30 +1200,15 @@ fts_cache_clear(
 
 		index_cache->words = NULL;
 
-		for (j = 0; j < FTS_NUM_AUX_INDEX; ++j) {
-
-			if (index_cache->ins_graph[j] != NULL) {
-
-				fts_que_graph_free_check_lock(
-					NULL, index_cache,
-					index_cache->ins_graph[j]);
-
-				index_cache->ins_graph[j] = NULL;
-			}
-
-			if (index_cache->sel_graph[j] != NULL) {
-
-				fts_que_graph_free_check_lock(
-					NULL, index_cache,
-					index_cache->sel_graph[j]);
-
-				index_cache->sel_graph[j] = NULL;
-			}
-		}
+		fts_index_cache_free_graphs(index_cache);
 
 		index_cache->doc_stats = NULL;
 	}
 
+	if (fts_sync_snapshot_t* snapshot = fts_sync_unlink_snapshot(cache)) {
+		fts_sync_free_snapshot(snapshot);
+	}
+
 	mem_heap_free(static_cast<mem_heap_t*>(cache->sync_heap->arg));
 	cache->sync_heap->arg = NULL;
 
@@ -3427,7 +3517,12 @@ fts_add_doc_from_tuple(
 
                        if (cache->total_size > fts_max_cache_size / 5
                            || fts_need_sync) {
-                               fts_sync(cache->sync, true, false, false);
+                               /* Only if the cache grew to its maximum
+                               size while the previous contents were being
+                               written, wait for that SYNC to finish. */
+                               fts_sync(cache->sync, true,
+                                        cache->total_size
+                                        > fts_max_cache_size, false);
                        }
 
                        mtr_start(&mtr);
@@ -3608,6 +3703,11 @@ fts_add_doc_by_id(
 					fts_sync(cache->sync, true, true, false);
 				);
 
+				DBUG_EXECUTE_IF(
+					"fts_instrument_sync_partial",
+					fts_sync(cache->sync, true, false, false);
+				);
+
 				DEBUG_SYNC_C("fts_instrument_sync_request");
 				DBUG_EXECUTE_IF(
 					"fts_instrument_sync_request",
@@ -3929,7 +4029,7 @@ dberr_t
 fts_sync_add_deleted_cache(
 /*=======================*/
 	fts_sync_t*	sync,			/*!< in: sync state */
-	ib_vector_t*	doc_ids)		/*!< in: doc ids to add */
+	ib_vector_t*	doc_ids)		/*!< in: sorted doc ids to add */
 {
 	ulint		i;
 	pars_info_t*	info;
@@ -3942,8 +4042,6 @@ fts_sync_add_deleted_cache(
 
 	ut_a(ib_vector_size(doc_ids) > 0);
 
-	ib_vector_sort(doc_ids, fts_update_doc_id_cmp);
-
 	info = pars_info_create();
 
 	fts_bind_doc_id(info, "doc_id", &dummy);
@@ -3980,33 +4078,44 @@ fts_sync_add_deleted_cache(
 /** Write the words and ilist to disk.
 @param[in,out]	trx		transaction
 @param[in]	index_cache	index cache
-@param[in]	unlock_cache	whether unlock cache when write node
+@param[in]	words		index_cache->sync_words, or
+				index_cache->words in a full SYNC
+@param[in]	part		auxiliary INDEX table whose words to write,
+				or FTS_NUM_AUX_INDEX to write all words
+@param[in]	unlock_cache	whether to release the cache lock while
+				writing each node of index_cache->words
+@param[in,out]	n_written	number of nodes written
 @return DB_SUCCESS if all went well else error code */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
 fts_sync_write_words(
 	trx_t*			trx,
 	fts_index_cache_t*	index_cache,
-	bool			unlock_cache)
+	ib_rbt_t*		words,
+	ulint			part,
+	bool			unlock_cache,
+	ulint*			n_written)
 {
 	fts_table_t	fts_table;
 	ulint		n_nodes = 0;
 	ulint		n_words = 0;
 	const ib_rbt_node_t* rbt_node;
 	dberr_t		error = DB_SUCCESS;
-	ibool		print_error = FALSE;
-	dict_table_t*	table = index_cache->index->table;
 
 	FTS_INIT_INDEX_TABLE(
 		&fts_table, NULL, FTS_INDEX_TABLE, index_cache->index);
 
-	n_words = rbt_size(index_cache->words);
+	rw_lock_t*	lock = &index_cache->index->table->fts->cache->lock;
 
-	/* We iterate over the entire tree, even if there is an error,
-	since we want to free the memory used during caching. */
-	for (rbt_node = rbt_first(index_cache->words);
-	     rbt_node;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+	ut_ad(words == index_cache->sync_words || words == index_cache->words);
+	ut_ad(!unlock_cache || words == index_cache->words);
+
+	/* The snapshot is not modified by anyone else until the SYNC
+	completes, so it can be read without holding the cache lock.
+	index_cache->words is only read while holding the cache lock. */
+	for (rbt_node = rbt_first(words);
+	     rbt_node && error == DB_SUCCESS;
+	     rbt_node = rbt_next(words, rbt_node)) {
 
 		ulint			i;
 		ulint			selected;
@@ -4021,10 +4130,14 @@ fts_sync_write_words(
 			index_cache->charset, word->text.f_str,
 			word->text.f_len);
 
+		if (part != FTS_NUM_AUX_INDEX && selected != part) {
+			continue;
+		}
+
 		fts_table.suffix = fts_get_suffix(selected);
 
-		/* We iterate over all the nodes even if there was an error */
-		for (i = 0; i < ib_vector_size(word->nodes); ++i) {
+		for (i = 0; i < ib_vector_size(word->nodes)
+		     && error == DB_SUCCESS; ++i) {
 
 			fts_node_t* fts_node = static_cast<fts_node_t*>(
 				ib_vector_get(word->nodes, i));
@@ -4035,40 +4148,41 @@ fts_sync_write_words(
 				fts_node->synced = true;
 			}
 
-			/*FIXME: we need to handle the error properly. */
-			if (error == DB_SUCCESS) {
-				if (unlock_cache) {
-					rw_lock_x_unlock(
-						&table->fts->cache->lock);
-				}
+			if (unlock_cache) {
+				rw_lock_x_unlock(lock);
+			}
+
+			error = fts_write_node(
+				trx, &index_cache->ins_graph[selected],
+				&fts_table, &word->text, fts_node);
 
-				error = fts_write_node(
-					trx,
-					&index_cache->ins_graph[selected],
-					&fts_table, &word->text, fts_node);
+			++*n_written;
 
+			/* When the auxiliary tables are written in
+			parallel, fts_sync_write() invokes these in the
+			thread that requested the SYNC. */
+			if (part == FTS_NUM_AUX_INDEX) {
 				DEBUG_SYNC_C("fts_write_node");
 				DBUG_EXECUTE_IF("fts_write_node_crash",
-					DBUG_SUICIDE(););
+						DBUG_SUICIDE(););
+			}
 
-				DBUG_EXECUTE_IF("fts_instrument_sync_sleep",
-					os_thread_sleep(1000000);
-				);
+			DBUG_EXECUTE_IF("fts_instrument_sync_sleep",
+				os_thread_sleep(1000000);
+			);
 
-				if (unlock_cache) {
-					rw_lock_x_lock(
-						&table->fts->cache->lock);
-				}
+			if (unlock_cache) {
+				rw_lock_x_lock(lock);
 			}
 		}
 
 		n_nodes += ib_vector_size(word->nodes);
+		n_words++;
+	}
 
-		if (error != DB_SUCCESS && !print_error) {
-			ib::error() << "(" << ut_strerr(error) << ") writing"
-				" word node to FTS auxiliary index table.";
-			print_error = TRUE;
-		}
+	if (error != DB_SUCCESS) {
+		ib::error() << "(" << ut_strerr(error) << ") writing"
+			" word node to FTS auxiliary index table.";
 	}
 
 	if (fts_enable_diag_print) {
@@ -4105,28 +4219,205 @@ fts_sync_begin(
 	}
 }
 
-/*********************************************************************//**
-Run SYNC on the table, i.e., write out data from the index specific
-cache to the FTS aux INDEX table and FTS aux doc id stats table.
+/** Move the contents of the cache to the SYNC snapshot and start
+with an empty cache, so that documents can be added to the cache
+while the snapshot is being written to the auxiliary tables.
+@param[in,out]	cache	fts cache */
+static
+void
+fts_sync_detach(
+	fts_cache_t*	cache)
+{
+	fts_sync_t*	sync = cache->sync;
+
+	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X));
+	ut_ad(sync->heap == NULL);
+
+	/* fts_cache_append_deleted_doc_ids() may be reading the
+	deleted doc ids. */
+	mutex_enter(&cache->deleted_lock);
+	sync->heap = static_cast<mem_heap_t*>(cache->sync_heap->arg);
+	sync->deleted_doc_ids = cache->deleted_doc_ids;
+	ib_vector_sort(sync->deleted_doc_ids, fts_update_doc_id_cmp);
+	cache->sync_heap->arg = mem_heap_create(1024);
+	cache->deleted_doc_ids = ib_vector_create(
+		cache->sync_heap, sizeof(fts_update_t), 4);
+	mutex_exit(&cache->deleted_lock);
+
+	for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+		fts_index_cache_t*	index_cache;
+
+		index_cache = static_cast<fts_index_cache_t*>(
+			ib_vector_get(cache->indexes, i));
+
+		ut_ad(index_cache->sync_words == NULL);
+		ut_ad(rbt_validate(index_cache->words));
+
+		index_cache->sync_words = index_cache->words;
+		index_cache->words = NULL;
+		index_cache->doc_stats = NULL;
+
+		fts_index_cache_init(cache->sync_heap, index_cache);
+	}
+
+	sync->sync_doc_id = sync->max_doc_id;
+	cache->total_size = 0;
+	fts_need_sync = false;
+}
+
+/** A transaction writing the words of the SYNC snapshot that belong
+to one auxiliary INDEX table */
+struct fts_sync_part_t {
+	/** sync state */
+	fts_sync_t*	sync;
+	/** the auxiliary INDEX table */
+	ulint		part;
+	/** outcome of the operation */
+	dberr_t		error;
+	/** number of nodes written */
+	ulint		n_written;
+	/** the thread writing the words */
+	os_thread_id_t	id;
+};
+
+/** Write the words of the SYNC snapshot that belong to one auxiliary
+INDEX table, in the transaction sync->part_trx[part].
+@param[in,out]	job	the words to write */
+static
+void
+fts_sync_write_part(
+	fts_sync_part_t*	job)
+{
+	fts_sync_t*	sync = job->sync;
+	fts_cache_t*	cache = sync->table->fts->cache;
+	trx_t*		trx = sync->part_trx[job->part];
+
+	job->error = DB_SUCCESS;
+	job->n_written = 0;
+
+	trx->op_info = "doing SYNC index";
+
+	for (ulint i = 0; i < ib_vector_size(cache->indexes)
+	     && job->error == DB_SUCCESS; ++i) {
+		fts_index_cache_t*	index_cache;
+
+		index_cache = static_cast<fts_index_cache_t*>(
+			ib_vector_get(cache->indexes, i));
+
+		if (index_cache->sync_words != NULL
+		    && index_cache->index->index_fts_syncing) {
+			job->error = fts_sync_write_words(
+				trx, index_cache, index_cache->sync_words,
+				job->part, false, &job->n_written);
+		}
+	}
+}
+
+/** Thread that writes the words of the SYNC snapshot that belong to
+one auxiliary INDEX table.
+@param[in,out]	arg	fts_sync_part_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(fts_sync_write_thread)(void* arg)
+{
+	fts_sync_write_part(static_cast<fts_sync_part_t*>(arg));
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Write the SYNC snapshot to the auxiliary INDEX tables. When the
+cache lock was released, each auxiliary table is written by a thread
+of its own, in a transaction of its own; those transactions are
+committed together with sync->trx in fts_sync_commit().
+@param[in,out]	sync	sync state
 @return DB_SUCCESS if all OK */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
-fts_sync_index(
-/*===========*/
-	fts_sync_t*		sync,		/*!< in: sync state */
-	fts_index_cache_t*	index_cache)	/*!< in: index cache */
+fts_sync_write(
+	fts_sync_t*	sync)
 {
-	trx_t*		trx = sync->trx;
-
-	trx->op_info = "doing SYNC index";
+	fts_cache_t*	cache = sync->table->fts->cache;
+	dberr_t		error = DB_SUCCESS;
 
 	if (fts_enable_diag_print) {
-		ib::info() << "SYNC words: " << rbt_size(index_cache->words);
+		for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+			fts_index_cache_t*	index_cache
+				= static_cast<fts_index_cache_t*>(
+					ib_vector_get(cache->indexes, i));
+
+			if (index_cache->sync_words) {
+				ib::info() << "SYNC words: "
+					<< rbt_size(index_cache->sync_words);
+			}
+		}
+	}
+
+	if (!sync->unlock_cache
+	    || sync->trx->dict_operation_lock_mode) {
+		/* Write everything in the current thread, because
+		the caller is holding latches. */
+		ulint	n_written = 0;
+
+		sync->trx->op_info = "doing SYNC index";
+
+		for (ulint i = 0; i < ib_vector_size(cache->indexes)
+		     && error == DB_SUCCESS; ++i) {
+			fts_index_cache_t*	index_cache
+				= static_cast<fts_index_cache_t*>(
+					ib_vector_get(cache->indexes, i));
+
+			if (index_cache->sync_words != NULL
+			    && index_cache->index->index_fts_syncing) {
+				error = fts_sync_write_words(
+					sync->trx, index_cache,
+					index_cache->sync_words,
+					FTS_NUM_AUX_INDEX, false, &n_written);
+			}
+		}
+
+		return(error);
+	}
+
+	fts_sync_part_t	jobs[FTS_NUM_AUX_INDEX];
+
+	for (ulint i = 0; i < FTS_NUM_AUX_INDEX; i++) {
+		jobs[i].sync = sync;
+		jobs[i].part = i;
+		sync->part_trx[i] = trx_create();
+		trx_start_internal(sync->part_trx[i]);
+	}
+
+	for (ulint i = 1; i < FTS_NUM_AUX_INDEX; i++) {
+		os_thread_create(fts_sync_write_thread, &jobs[i], &jobs[i].id);
 	}
 
-	ut_ad(rbt_validate(index_cache->words));
+	fts_sync_write_part(&jobs[0]);
+
+	for (ulint i = 1; i < FTS_NUM_AUX_INDEX; i++) {
+		os_thread_join(jobs[i].id);
+	}
+
+	ulint	n_written = 0;
+
+	for (ulint i = 0; i < FTS_NUM_AUX_INDEX; i++) {
+		n_written += jobs[i].n_written;
+
+		if (error == DB_SUCCESS) {
+			error = jobs[i].error;
+		}
+	}
+
+	/* The writer threads have no THD, and they do not see
+	session debug settings. */
+	if (n_written) {
+		DEBUG_SYNC_C("fts_write_node");
+		DBUG_EXECUTE_IF("fts_write_node_crash", DBUG_SUICIDE(););
+	}
 
-	return(fts_sync_write_words(trx, index_cache, sync->unlock_cache));
+	return(error);
 }
 
 /** Check if index cache has been synced completely
@@ -4157,26 +4448,125 @@ fts_sync_index_check(
 	return(true);
 }
 
-/** Reset synced flag in index cache when rollback
-@param[in,out]	index_cache	index cache */
+/** Write the whole cache to the auxiliary INDEX tables in a full SYNC,
+including the documents that are added while the SYNC is running.
+The cache lock is released while each node is written, unless the
+cache has grown over innodb_ft_cache_size.
+@param[in,out]	sync	sync state; the cache lock is X-latched
+@return DB_SUCCESS if all OK */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+dberr_t
+fts_sync_write_cache(
+	fts_sync_t*	sync)
+{
+	fts_cache_t*	cache = sync->table->fts->cache;
+	ulint		n_written = 0;
+
+	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X));
+
+	sync->trx->op_info = "doing SYNC index";
+
+	for (;;) {
+		if (cache->total_size > fts_max_cache_size) {
+			/* Avoid the case: sync never finish when
+			insert/update keeps comming. */
+			sync->unlock_cache = false;
+		}
+
+		for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+			fts_index_cache_t*	index_cache
+				= static_cast<fts_index_cache_t*>(
+					ib_vector_get(cache->indexes, i));
+
+			if (!index_cache->index->index_fts_syncing) {
+				continue;
+			}
+
+			ut_ad(rbt_validate(index_cache->words));
+
+			dberr_t	error = fts_sync_write_words(
+				sync->trx, index_cache, index_cache->words,
+				FTS_NUM_AUX_INDEX, sync->unlock_cache,
+				&n_written);
+
+			if (error != DB_SUCCESS) {
+				return(error);
+			}
+		}
+
+		/* Make sure all the caches are synced. */
+		bool	synced = true;
+
+		for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+			fts_index_cache_t*	index_cache
+				= static_cast<fts_index_cache_t*>(
+					ib_vector_get(cache->indexes, i));
+
+			if (index_cache->index->index_fts_syncing
+			    && !fts_sync_index_check(index_cache)) {
+				synced = false;
+				break;
+			}
+		}
+
+		if (synced) {
+			return(DB_SUCCESS);
+		}
+	}
+}
+
+/** Commit or roll back and free the transactions that were used
+for writing the SYNC snapshot in parallel.
+@param[in,out]	sync	sync state
+@param[in]	commit	whether to commit the transactions */
+static
+void
+fts_sync_end_parts(
+	fts_sync_t*	sync,
+	bool		commit)
+{
+	for (ulint i = 0; i < FTS_NUM_AUX_INDEX; i++) {
+		trx_t*	trx = sync->part_trx[i];
+
+		if (trx == NULL) {
+			continue;
+		}
+
+		if (commit) {
+			fts_sql_commit(trx);
+		} else {
+			fts_sql_rollback(trx);
+		}
+
+		trx_free(trx);
+		sync->part_trx[i] = NULL;
+	}
+}
+
+/** Reset synced flag in the words of an index cache when rollback
+@param[in,out]	words	index_cache->words or index_cache->sync_words */
 static
 void
 fts_sync_index_reset(
-	fts_index_cache_t*	index_cache)
+	ib_rbt_t*	words)
 {
 	const ib_rbt_node_t*	rbt_node;
 
-	for (rbt_node = rbt_first(index_cache->words);
+	if (words == NULL) {
+		return;
+	}
+
+	for (rbt_node = rbt_first(words);
 	     rbt_node != NULL;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+	     rbt_node = rbt_next(words, rbt_node)) {
 
 		fts_tokenizer_word_t*	word;
 		word = rbt_value(fts_tokenizer_word_t, rbt_node);
 
-		fts_node_t*	fts_node;
-		fts_node = static_cast<fts_node_t*>(ib_vector_last(word->nodes));
-
-		fts_node->synced = false;
+		for (ulint i = 0; i < ib_vector_size(word->nodes); ++i) {
+			static_cast<fts_node_t*>(
+				ib_vector_get(word->nodes, i))->synced = false;
+		}
 	}
 }
 
@@ -4197,32 +4587,61 @@ fts_sync_commit(
 
 	/* After each Sync, update the CONFIG table about the max doc id
 	we just sync-ed to index table */
-	error = fts_cmp_set_sync_doc_id(sync->table, sync->max_doc_id, FALSE,
+	error = fts_cmp_set_sync_doc_id(sync->table, sync->sync_doc_id, FALSE,
 					&last_doc_id);
 
 	/* Get the list of deleted documents that are either in the
 	cache or were headed there but were deleted before the add
 	thread got to them. */
 
-	if (error == DB_SUCCESS && ib_vector_size(cache->deleted_doc_ids) > 0) {
+	if (error == DB_SUCCESS && ib_vector_size(sync->deleted_doc_ids) > 0) {
 
 		error = fts_sync_add_deleted_cache(
-			sync, cache->deleted_doc_ids);
+			sync, sync->deleted_doc_ids);
+	}
+
+	if (sync->unlock_cache) {
+		rw_lock_x_lock(&cache->lock);
+	}
+
+	fts_sync_snapshot_t*	snapshot = NULL;
+
+	if (error == DB_SUCCESS) {
+		for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+			fts_index_cache_free_graphs(
+				static_cast<fts_index_cache_t*>(
+					ib_vector_get(cache->indexes, i)));
+		}
+
+		DEBUG_SYNC_C("fts_deleted_doc_ids_clear");
+		snapshot = fts_sync_unlink_snapshot(cache);
+	} else {
+		for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+			fts_index_cache_t*	index_cache
+				= static_cast<fts_index_cache_t*>(
+					ib_vector_get(cache->indexes, i));
+
+			fts_sync_index_reset(index_cache->words);
+			fts_sync_index_reset(index_cache->sync_words);
+			fts_index_cache_free_graphs(index_cache);
+		}
 	}
 
-	/* We need to do this within the deleted lock since fts_delete() can
-	attempt to add a deleted doc id to the cache deleted id array. */
-	fts_cache_clear(cache);
-	DEBUG_SYNC_C("fts_deleted_doc_ids_clear");
-	fts_cache_init(cache);
 	rw_lock_x_unlock(&cache->lock);
 
+	/* Free the snapshot without blocking the users of the cache. */
+	if (snapshot != NULL) {
+		fts_sync_free_snapshot(snapshot);
+	}
+
 	if (error == DB_SUCCESS) {
 
+		fts_sync_end_parts(sync, true);
 		fts_sql_commit(trx);
 
 	} else if (error != DB_SUCCESS) {
 
+		fts_sync_end_parts(sync, false);
 		fts_sql_rollback(trx);
 
 		ib::error() << "(" << ut_strerr(error) << ") during SYNC.";
@@ -4244,7 +4663,8 @@ fts_sync_commit(
 	return(error);
 }
 
-/** Rollback a sync operation
+/** Rollback a sync operation. The snapshot is preserved, and the next
+SYNC will write it again.
 @param[in,out]	sync	sync state */
 static
 void
@@ -4254,8 +4674,11 @@ fts_sync_rollback(
 	trx_t*		trx = sync->trx;
 	fts_cache_t*	cache = sync->table->fts->cache;
 
+	if (sync->unlock_cache) {
+		rw_lock_x_lock(&cache->lock);
+	}
+
 	for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		ulint			j;
 		fts_index_cache_t*	index_cache;
 
 		index_cache = static_cast<fts_index_cache_t*>(
@@ -4263,32 +4686,14 @@ fts_sync_rollback(
 
 		/* Reset synced flag so nodes will not be skipped
 		in the next sync, see fts_sync_write_words(). */
-		fts_sync_index_reset(index_cache);
-
-		for (j = 0; fts_index_selector[j].value; ++j) {
-
-			if (index_cache->ins_graph[j] != NULL) {
-
-				fts_que_graph_free_check_lock(
-					NULL, index_cache,
-					index_cache->ins_graph[j]);
-
-				index_cache->ins_graph[j] = NULL;
-			}
-
-			if (index_cache->sel_graph[j] != NULL) {
-
-				fts_que_graph_free_check_lock(
-					NULL, index_cache,
-					index_cache->sel_graph[j]);
-
-				index_cache->sel_graph[j] = NULL;
-			}
-		}
+		fts_sync_index_reset(index_cache->words);
+		fts_sync_index_reset(index_cache->sync_words);
+		fts_index_cache_free_graphs(index_cache);
 	}
 
 	rw_lock_x_unlock(&cache->lock);
 
+	fts_sync_end_parts(sync, false);
 	fts_sql_rollback(trx);
 
 	/* Avoid assertion in trx_free(). */
@@ -4298,9 +4703,16 @@ fts_sync_rollback(
 
 /** Run SYNC on the table, i.e., write out data from the cache to the
 FTS auxiliary INDEX table and clear the cache at the end.
+
+The contents of the cache are moved to a snapshot, and new documents
+are added to an empty cache while the snapshot is being written.
+Unless unlock_cache=false, the cache lock is not held while writing.
 @param[in,out]	sync		sync state
-@param[in]	unlock_cache	whether unlock cache lock when write node
-@param[in]	wait		whether wait when a sync is in progress
+@param[in]	unlock_cache	whether to release the cache lock while
+				writing the snapshot
+@param[in]	wait		whether wait when a sync is in progress,
+				and also write the documents that are added
+				to the cache during the SYNC
 @param[in]	has_dict	whether has dict operation lock
 @return DB_SUCCESS if all OK */
 static
@@ -4322,7 +4734,7 @@ fts_sync(
 	rw_lock_x_lock(&cache->lock);
 
 	/* Check if cache is being synced.
-	Note: we release cache lock in fts_sync_write_words() to
+	Note: we release cache lock in fts_sync_write() to
 	avoid long wait for the lock by other threads. */
 	while (sync->in_progress) {
 		rw_lock_x_unlock(&cache->lock);
@@ -4340,74 +4752,85 @@ fts_sync(
 	sync->in_progress = true;
 
 	DEBUG_SYNC_C("fts_sync_begin");
-	fts_sync_begin(sync);
 
-	/* When sync in background, we hold dict operation lock
-	to prevent DDL like DROP INDEX, etc. */
-	if (has_dict) {
-		sync->trx->dict_operation_lock_mode = RW_S_LATCH;
-	}
+	/* A background SYNC writes a snapshot of the cache, and
+	documents can be added to the cache meanwhile. An explicit or
+	forced SYNC (wait=true) writes the whole cache, including the
+	documents that are added while it is running. If a snapshot was
+	retained by an interrupted SYNC, it is committed first. */
+	for (;;) {
+		const bool	full = wait && sync->heap == NULL;
 
-begin_sync:
-	if (cache->total_size > fts_max_cache_size) {
-		/* Avoid the case: sync never finish when
-		insert/update keeps comming. */
-		ut_ad(sync->unlock_cache);
-		sync->unlock_cache = false;
-	}
+		sync->unlock_cache = unlock_cache;
+		fts_sync_begin(sync);
 
-	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		fts_index_cache_t*	index_cache;
-
-		index_cache = static_cast<fts_index_cache_t*>(
-			ib_vector_get(cache->indexes, i));
+		/* When sync in background, we hold dict operation lock
+		to prevent DDL like DROP INDEX, etc. */
+		if (has_dict) {
+			sync->trx->dict_operation_lock_mode = RW_S_LATCH;
+		}
 
-		if (index_cache->index->to_be_dropped
-		   || index_cache->index->table->to_be_dropped) {
-			continue;
+		/* If a previous SYNC was rolled back, write its
+		snapshot first. */
+		if (!full && sync->heap == NULL) {
+			fts_sync_detach(cache);
 		}
 
-		DBUG_EXECUTE_IF("fts_instrument_sync_before_syncing",
-				os_thread_sleep(300000););
-		index_cache->index->index_fts_syncing = true;
+		for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
+			fts_index_cache_t*	index_cache;
 
-		error = fts_sync_index(sync, index_cache);
+			index_cache = static_cast<fts_index_cache_t*>(
+				ib_vector_get(cache->indexes, i));
 
-		if (error != DB_SUCCESS) {
-			goto end_sync;
+			if (index_cache->index->to_be_dropped
+			    || index_cache->index->table->to_be_dropped) {
+				continue;
+			}
+
+			DBUG_EXECUTE_IF("fts_instrument_sync_before_syncing",
+					os_thread_sleep(300000););
+			index_cache->index->index_fts_syncing = true;
 		}
-	}
 
-	DBUG_EXECUTE_IF("fts_instrument_sync_interrupted",
-			sync->interrupted = true;
-			error = DB_INTERRUPTED;
-			goto end_sync;
-	);
+		if (full) {
+			error = fts_sync_write_cache(sync);
 
-	/* Make sure all the caches are synced. */
-	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		fts_index_cache_t*	index_cache;
+			/* Everything in the cache has been written.
+			Move it to the snapshot, which will be freed
+			on commit. */
+			if (error == DB_SUCCESS) {
+				fts_sync_detach(cache);
+			}
 
-		index_cache = static_cast<fts_index_cache_t*>(
-			ib_vector_get(cache->indexes, i));
+			if (sync->unlock_cache) {
+				rw_lock_x_unlock(&cache->lock);
+			}
+		} else {
+			if (sync->unlock_cache) {
+				rw_lock_x_unlock(&cache->lock);
+			}
 
-		if (index_cache->index->to_be_dropped
-		    || index_cache->index->table->to_be_dropped
-		    || fts_sync_index_check(index_cache)) {
-			continue;
+			error = fts_sync_write(sync);
 		}
 
-		goto begin_sync;
-	}
+		DBUG_EXECUTE_IF("fts_instrument_sync_interrupted",
+				sync->interrupted = true;
+				error = DB_INTERRUPTED;
+		);
 
-end_sync:
-	if (error == DB_SUCCESS && !sync->interrupted) {
-		error = fts_sync_commit(sync);
-	} else {
-		fts_sync_rollback(sync);
+		if (error == DB_SUCCESS && !sync->interrupted) {
+			error = fts_sync_commit(sync);
+		} else {
+			fts_sync_rollback(sync);
+		}
+
+		rw_lock_x_lock(&cache->lock);
+
+		if (error != DB_SUCCESS || full || !wait) {
+			break;
+		}
 	}
 
-	rw_lock_x_lock(&cache->lock);
 	/* Clear fts syncing flags of any indexes in case sync is
 	interrupted */
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
@@ -5241,6 +5664,8 @@ const ib_vector_t*
 fts_cache_find_word(
 /*================*/
 	const fts_index_cache_t*index_cache,	/*!< in: cache to search */
+	const ib_rbt_t*		words,		/*!< in: index_cache->words
+						or index_cache->sync_words */
 	const fts_string_t*	text)		/*!< in: word to search for */
 {
 	ib_rbt_bound_t		parent;
@@ -5252,8 +5677,10 @@ fts_cache_find_word(
 	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X));
 #endif /* UNIV_DEBUG */
 
+	ut_ad(words == index_cache->words || words == index_cache->sync_words);
+
 	/* Lookup the word in the rb tree */
-	if (rbt_search(index_cache->words, &parent, text) == 0) {
+	if (rbt_search(words, &parent, text) == 0) {
 		const fts_tokenizer_word_t*	word;
 
 		word = rbt_value(fts_tokenizer_word_t, parent.last);
@@ -5289,6 +5716,18 @@ fts_cache_append_deleted_doc_ids(
 		ib_vector_push(vector, &update->doc_id);
 	}
 
+	/* Include the deleted doc ids that are being written by SYNC. */
+	if (const ib_vector_t* deleted = cache->sync->deleted_doc_ids) {
+		for (ulint i = 0; i < ib_vector_size(deleted); ++i) {
+			const fts_update_t*	update;
+
+			update = static_cast<const fts_update_t*>(
+				ib_vector_get_const(deleted, i));
+
+			ib_vector_push(vector, &update->doc_id);
+		}
+	}
+
 	mutex_exit((ib_mutex_t*) &cache->deleted_lock);
 }
 
@@ -1014,6 +1014,8 @@ fts_cache_find_wildcard(
 /*====================*/
 	fts_query_t*		query,		/*!< in: query instance */
 	const fts_index_cache_t*index_cache,	/*!< in: cache to search */
+	const ib_rbt_t*		words,		/*!< in: index_cache->words
+						or index_cache->sync_words */
 	const fts_string_t*	token)		/*!< in: token to search */
 {
 	ib_rbt_bound_t		parent;
@@ -1031,7 +1033,7 @@ fts_cache_find_wildcard(
 	srch_text.f_str = term;
 
 	/* Lookup the word in the rb tree */
-	if (rbt_search_cmp(index_cache->words, &parent, &srch_text, NULL,
+	if (rbt_search_cmp(words, &parent, &srch_text, NULL,
 			   innobase_fts_text_cmp_prefix) == 0) {
 		const fts_tokenizer_word_t*     word;
 		ulint				i;
@@ -1079,11 +1081,11 @@ fts_cache_find_wildcard(
 
 			if (!forward) {
 				cur_node = rbt_prev(
-					index_cache->words, cur_node);
+					words, cur_node);
 			} else {
 cont_search:
 				cur_node = rbt_next(
-					index_cache->words, cur_node);
+					words, cur_node);
 			}
 
 			if (!cur_node) {
@@ -1103,6 +1105,50 @@ fts_cache_find_wildcard(
 	return(num_word);
 }
 
+/** Search the index cache and the snapshot that is being written by
+SYNC for a word, and add the matching documents to the query.
+@param[in,out]	query		query instance
+@param[in]	index_cache	index cache, protected by the cache lock
+@param[in]	token		token to search
+@param[in]	wildcard	whether to do a wildcard search */
+static
+void
+fts_query_search_cache(
+	fts_query_t*		query,
+	const fts_index_cache_t*index_cache,
+	const fts_string_t*	token,
+	bool			wildcard)
+{
+	const ib_rbt_t*	words[2] = {
+		index_cache->sync_words, index_cache->words
+	};
+
+	for (ulint w = 0; w < 2 && query->error == DB_SUCCESS; w++) {
+		if (words[w] == NULL) {
+			continue;
+		}
+
+		if (wildcard) {
+			fts_cache_find_wildcard(
+				query, index_cache, words[w], token);
+			continue;
+		}
+
+		const ib_vector_t*	nodes = fts_cache_find_word(
+			index_cache, words[w], token);
+
+		for (ulint i = 0; nodes && i < ib_vector_size(nodes)
+		     && query->error == DB_SUCCESS; ++i) {
+			const fts_node_t*	node;
+
+			node = static_cast<const fts_node_t*>(
+				ib_vector_get_const(nodes, i));
+
+			fts_query_check_node(query, token, node);
+		}
+	}
+}
+
 /*****************************************************************//**
 Set difference.
 @return DB_SUCCESS if all go well */
@@ -1134,9 +1180,7 @@ fts_query_difference(
 
 	/* There is nothing we can substract from an empty set. */
 	if (query->doc_ids && !rbt_empty(query->doc_ids)) {
-		ulint			i;
 		fts_fetch_t		fetch;
-		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
 		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
@@ -1150,23 +1194,10 @@ fts_query_difference(
 		ut_a(index_cache != NULL);
 
 		/* Search the cache for a matching word first. */
-		if (query->cur_node->term.wildcard
-		    && query->flags != FTS_PROXIMITY
-		    && query->flags != FTS_PHRASE) {
-			fts_cache_find_wildcard(query, index_cache, token);
-		} else {
-			nodes = fts_cache_find_word(index_cache, token);
-
-			for (i = 0; nodes && i < ib_vector_size(nodes)
-			     && query->error == DB_SUCCESS; ++i) {
-				const fts_node_t*	node;
-
-				node = static_cast<const fts_node_t*>(
-					ib_vector_get_const(nodes, i));
-
-				fts_query_check_node(query, token, node);
-			}
-		}
+		fts_query_search_cache(query, index_cache, token,
+				       query->cur_node->term.wildcard
+				       && query->flags != FTS_PROXIMITY
+				       && query->flags != FTS_PHRASE);
 
 		rw_lock_x_unlock(&cache->lock);
 
@@ -1227,9 +1258,7 @@ fts_query_intersect(
 	we know the intersection set is empty in advance. */
 	if (!(rbt_empty(query->doc_ids) && query->multi_exist)) {
 		ulint                   n_doc_ids = 0;
-		ulint			i;
 		fts_fetch_t		fetch;
-		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
 		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
@@ -1275,22 +1304,8 @@ fts_query_intersect(
 		/* Must find the index cache. */
 		ut_a(index_cache != NULL);
 
-		if (query->cur_node->term.wildcard) {
-			/* Wildcard search the index cache */
-			fts_cache_find_wildcard(query, index_cache, token);
-		} else {
-			nodes = fts_cache_find_word(index_cache, token);
-
-			for (i = 0; nodes && i < ib_vector_size(nodes)
-			     && query->error == DB_SUCCESS; ++i) {
-				const fts_node_t*	node;
-
-				node = static_cast<const fts_node_t*>(
-					ib_vector_get_const(nodes, i));
-
-				fts_query_check_node(query, token, node);
-			}
-		}
+		fts_query_search_cache(query, index_cache, token,
+				       query->cur_node->term.wildcard);
 
 		rw_lock_x_unlock(&cache->lock);
 
@@ -1354,27 +1369,10 @@ fts_query_cache(
 	/* Must find the index cache. */
 	ut_a(index_cache != NULL);
 
-	if (query->cur_node->term.wildcard
-	    && query->flags != FTS_PROXIMITY
-	    && query->flags != FTS_PHRASE) {
-		/* Wildcard search the index cache */
-		fts_cache_find_wildcard(query, index_cache, token);
-	} else {
-		const ib_vector_t*      nodes;
-		ulint			i;
-
-		nodes = fts_cache_find_word(index_cache, token);
-
-		for (i = 0; nodes && i < ib_vector_size(nodes)
-		     && query->error == DB_SUCCESS; ++i) {
-			const fts_node_t*	node;
-
-			node = static_cast<const fts_node_t*>(
-				ib_vector_get_const(nodes, i));
-
-			fts_query_check_node(query, token, node);
-		}
-	}
+	fts_query_search_cache(query, index_cache, token,
+			       query->cur_node->term.wildcard
+			       && query->flags != FTS_PROXIMITY
+			       && query->flags != FTS_PHRASE);
 
 	rw_lock_x_unlock(&cache->lock);
 
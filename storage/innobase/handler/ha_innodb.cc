@@ -394,6 +394,22 @@ static const char* innodb_lock_schedule_algorithm_names[] = {
 	NullS
 };
 
+/** Possible values of the parameter innodb_buffer_pool_lru_policy */
+static const char* innodb_buffer_pool_lru_policy_names[] = {
+	"midpoint",
+	"2q",
+	NullS
+};
+
+/** Used to define an enumerate type of the system variable
+innodb_buffer_pool_lru_policy. */
+static TYPELIB innodb_buffer_pool_lru_policy_typelib = {
+	array_elements(innodb_buffer_pool_lru_policy_names) - 1,
+	"innodb_buffer_pool_lru_policy_typelib",
+	innodb_buffer_pool_lru_policy_names,
+	NULL
+};
+
 /** Used to define an enumerate type of the system variable
 innodb_lock_schedule_algorithm. */
 static TYPELIB innodb_lock_schedule_algorithm_typelib = {
@@ -604,7 +620,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(srv_sys_mutex),
-	PSI_KEY(lock_mutex),
+	PSI_KEY(lock_rec_shard_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -641,6 +657,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(trx_purge_latch),
 	PSI_RWLOCK_KEY(index_tree_rw_lock),
 	PSI_RWLOCK_KEY(index_online_log),
+	PSI_RWLOCK_KEY(lock_sys_latch),
 	PSI_RWLOCK_KEY(dict_table_stats),
 	PSI_RWLOCK_KEY(hash_table_locks)
 };
@@ -898,6 +915,7 @@ static ibool innodb_have_lz4=IF_LZ4(1, 0);
 static ibool innodb_have_lzma=IF_LZMA(1, 0);
 static ibool innodb_have_bzip2=IF_BZIP2(1, 0);
 static ibool innodb_have_snappy=IF_SNAPPY(1, 0);
+static ibool innodb_have_zstd=IF_ZSTD(1, 0);
 static ibool innodb_have_punch_hole=IF_PUNCH_HOLE(1, 0);
 
 static
@@ -927,6 +945,12 @@ static MYSQL_THDVAR_BOOL(ft_enable_stopword, PLUGIN_VAR_OPCMDARG,
   NULL, NULL,
   /* default */ TRUE);
 
+static MYSQL_THDVAR_BOOL(bulk_insert, PLUGIN_VAR_OPCMDARG,
+  "Load INSERT...SELECT and LOAD DATA into an empty table by sorting"
+  " the rows and building the indexes bottom-up. The table will be"
+  " locked exclusively until the end of the transaction.",
+  NULL, NULL, FALSE);
+
 static MYSQL_THDVAR_ULONG(lock_wait_timeout, PLUGIN_VAR_RQCMDARG,
   "Timeout in seconds an InnoDB transaction may wait for a lock before being rolled back. Values above 100000000 disable the timeout.",
   NULL, NULL, 50, 0, 1024 * 1024 * 1024, 0);
@@ -936,6 +960,12 @@ static MYSQL_THDVAR_STR(ft_user_stopword_table,
   "User supplied stopword table name, effective in the session level.",
   innodb_stopword_table_validate, NULL, NULL);
 
+static MYSQL_THDVAR_UINT(ddl_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads for reading the table, for sorting and loading"
+  " secondary indexes and for applying the log of concurrent DML"
+  " in ALTER TABLE or CREATE INDEX (1=do it in the connection thread)",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_THDVAR_STR(tmpdir,
   PLUGIN_VAR_OPCMDARG|PLUGIN_VAR_MEMALLOC,
   "Directory for temporary non-tablespace files.",
@@ -1090,6 +1120,8 @@ static SHOW_VAR innodb_status_variables[]= {
   (char*) &innodb_have_bzip2,		  SHOW_BOOL},
   {"have_snappy",
   (char*) &innodb_have_snappy,		  SHOW_BOOL},
+  {"have_zstd",
+  (char*) &innodb_have_zstd,		  SHOW_BOOL},
   {"have_punch_hole",
   (char*) &innodb_have_punch_hole,	  SHOW_BOOL},
 
@@ -1804,6 +1836,17 @@ thd_lock_wait_timeout(
 	return(THDVAR(thd, lock_wait_timeout));
 }
 
+/** Get the value of innodb_ddl_threads.
+@param[in]	thd	thread handle, or NULL to query
+			the global innodb_ddl_threads
+@return number of threads for building secondary indexes */
+ulint
+thd_ddl_threads(
+	THD*	thd)
+{
+	return(THDVAR(thd, ddl_threads));
+}
+
 /** Get the value of innodb_tmpdir.
 @param[in]	thd	thread handle, or NULL to query
 			the global innodb_tmpdir.
@@ -3792,6 +3835,15 @@ static int innodb_init_params()
 	}
 #endif
 
+#ifndef HAVE_ZSTD
+	if (innodb_compression_algorithm == PAGE_ZSTD_ALGORITHM) {
+		sql_print_error("InnoDB: innodb_compression_algorithm = %lu unsupported.\n"
+				"InnoDB: libzstd is not installed. \n",
+				innodb_compression_algorithm);
+		DBUG_RETURN(HA_ERR_INITIALIZATION);
+	}
+#endif
+
 	if ((srv_encrypt_tables || srv_encrypt_log)
 	     && !encryption_key_id_exists(FIL_DEFAULT_ENCRYPTION_KEY)) {
 		sql_print_error("InnoDB: cannot enable encryption, "
@@ -4096,10 +4148,22 @@ static int innodb_init_params()
 		srv_use_doublewrite_buf = FALSE;
 	}
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring && !srv_use_native_aio) {
+		ib::warn() << "innodb_use_io_uring requires"
+			" innodb_use_native_aio; ignored";
+		srv_use_io_uring = FALSE;
+	}
+#endif /* LINUX_IO_URING */
+
 #ifdef LINUX_NATIVE_AIO
-	if (srv_use_native_aio) {
+	if (srv_use_native_aio && !srv_use_io_uring) {
 		ib::info() << "Using Linux native AIO";
 	}
+#elif defined LINUX_IO_URING
+	/* Without libaio, native AIO is only available through
+	io_uring. */
+	srv_use_native_aio = srv_use_io_uring;
 #elif !defined _WIN32
 	/* Currently native AIO is supported only on windows and linux
 	and that also when the support is compiled in. In all other
@@ -15357,9 +15421,92 @@ ha_innobase::end_stmt()
 	/* This is a statement level counter. */
 	m_prebuilt->autoinc_last_value = 0;
 
+	m_prebuilt->bulk_insert_pending = false;
+
+	if (m_prebuilt->bulk_insert) {
+		/* end_bulk_insert() was not invoked. The statement
+		will be rolled back. */
+		row_merge_bulk_free(m_prebuilt->bulk_insert);
+		m_prebuilt->bulk_insert = NULL;
+	}
+
 	return(0);
 }
 
+/** Prepare for inserting many rows by INSERT...SELECT or LOAD DATA.
+If innodb_bulk_insert is set and the table is empty, the rows will be
+buffered and sorted, and the indexes will be built by end_bulk_insert().
+@param[in]	rows	estimated number of rows, or 0 if unknown
+@param[in]	flags	flags */
+void
+ha_innobase::start_bulk_insert(ha_rows rows, uint flags)
+{
+	THD*	thd = ha_thd();
+
+	m_prebuilt->bulk_insert_pending = false;
+
+	if (!THDVAR(thd, bulk_insert) || srv_read_only_mode
+	    || m_prebuilt->trx->duplicates
+	    || m_prebuilt->table->is_temporary()) {
+		return;
+	}
+
+	switch (thd_sql_command(thd)) {
+	case SQLCOM_INSERT_SELECT:
+	case SQLCOM_LOAD:
+		break;
+	default:
+		return;
+	}
+
+#ifdef WITH_WSREP
+	if (wsrep_on(thd)) {
+		return;
+	}
+#endif /* WITH_WSREP */
+
+	if (table->triggers) {
+		/* A trigger could read the table before the buffered
+		rows have been loaded. */
+		return;
+	}
+
+	/* The emptiness of the table will be checked by the first
+	row_insert_for_mysql(), after the table has been locked. */
+	m_prebuilt->bulk_insert_pending = true;
+}
+
+/** Load the rows that were buffered since start_bulk_insert().
+@return error number
+@retval 0 on success */
+int
+ha_innobase::end_bulk_insert()
+{
+	m_prebuilt->bulk_insert_pending = false;
+
+	row_merge_bulk_t*	bulk = m_prebuilt->bulk_insert;
+
+	if (!bulk) {
+		return(0);
+	}
+
+	m_prebuilt->bulk_insert = NULL;
+
+	trx_t*	trx = m_prebuilt->trx;
+	dberr_t	err = row_merge_bulk_finish(bulk, trx);
+
+	if (err == DB_SUCCESS) {
+		dict_stats_update_if_needed(m_prebuilt->table,
+					    trx->mysql_thd);
+		return(0);
+	}
+
+	/* A duplicate key is reported by info(HA_STATUS_ERRKEY)
+based on trx->error_info. */
+	return(convert_error_code_to_mysql(
+		       err, m_prebuilt->table->flags, m_user_thd));
+}
+
 /**
 MySQL calls this method at the end of each statement */
 
@@ -17155,6 +17302,22 @@ innodb_io_capacity_max_update(
 	srv_max_io_capacity = in_val;
 }
 
+/** Update innodb_deadlock_detect_interval.
+Wake up lock_wait_timeout_thread(), so that the waits that were queued
+for it will be checked without delay when the interval is set to 0.
+@param[in]	save	immediate result from check function */
+static
+void
+innodb_deadlock_detect_interval_update(
+	THD*, st_mysql_sys_var*, void*, const void* save)
+{
+	innodb_deadlock_detect_interval = *static_cast<const ulong*>(save);
+
+	if (!srv_read_only_mode) {
+		lock_set_timeout_event();
+	}
+}
+
 /****************************************************************//**
 Update the system variable innodb_io_capacity using the "saved"
 value. This function is registered as a callback with MySQL. */
@@ -18991,6 +19154,13 @@ static MYSQL_SYSVAR_ULONG(page_cleaners, srv_n_page_cleaners,
   NULL,
   innodb_page_cleaners_threads_update, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(page_compression_threads,
+  innodb_page_compression_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that compress and write the pages of page_compressed"
+  " tables for the page cleaner (0=compress in the page cleaner)",
+  NULL, NULL, 0, 0, 64, 0);
+
 static MYSQL_SYSVAR_DOUBLE(max_dirty_pages_pct, srv_max_buf_pool_modified_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of dirty pages allowed in bufferpool.",
@@ -19091,6 +19261,27 @@ static MYSQL_SYSVAR_ULONGLONG(stats_modified_counter, srv_stats_modified_counter
   "The number of rows modified before we calculate new statistics (default 0 = current limits)",
   NULL, NULL, 0, 0, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(stats_threads, srv_stats_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads for sampling the indexes of a table when calculating"
+  " persistent statistics (1=sample the indexes one by one)",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_SYSVAR_ULONG(stats_incremental_recalc,
+  srv_stats_incremental_recalc,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of consecutive automatic recalculations of persistent"
+  " statistics that extrapolate the previous estimates from the change of"
+  " the index sizes instead of sampling the indexes again (0=always sample)",
+  NULL, NULL, 0, 0, 1000, 0);
+
+static MYSQL_SYSVAR_ULONG(records_in_range_cache, srv_records_in_range_cache,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of node pointers per index to cache for estimating"
+  " the number of records in a range without diving into the index"
+  " (0=always dive)",
+  NULL, NULL, 0, 0, 4096, 0);
+
 static MYSQL_SYSVAR_BOOL(stats_traditional, srv_stats_sample_traditional,
   PLUGIN_VAR_RQCMDARG,
   "Enable traditional statistic calculation based on number of configured pages (default true)",
@@ -19103,6 +19294,12 @@ static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   " Disable with --skip-innodb-adaptive-hash-index.",
   NULL, innodb_adaptive_hash_index_update, true);
 
+static MYSQL_SYSVAR_BOOL(adaptive_hash_index_auto, btr_search_auto,
+  PLUGIN_VAR_OPCMDARG,
+  "Disable the InnoDB adaptive hash index for indexes where it costs more"
+  " than it saves, and retry it later (enabled by default)",
+  NULL, NULL, TRUE);
+
 /** Number of distinct partitions of AHI.
 Each partition is protected by its own latch and so we have parts number
 of latches protecting complete search system. */
@@ -19346,6 +19543,14 @@ static MYSQL_SYSVAR_BOOL(deadlock_detect, innobase_deadlock_detect,
   " and we rely on innodb_lock_wait_timeout in case of deadlock.",
   NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(deadlock_detect_interval,
+  innodb_deadlock_detect_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Milliseconds between searches for deadlocks among all lock waits"
+  " in a background thread, or 0 to search on every lock wait"
+  " (the default).",
+  NULL, innodb_deadlock_detect_interval_update, 0, 0, 10000, 0);
+
 static MYSQL_SYSVAR_UINT(fill_factor, innobase_fill_factor,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of B-tree page filled during bulk insert",
@@ -19412,6 +19617,14 @@ static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   "Maximum modification log file size for online index creation",
   NULL, NULL, 128<<20, 65536, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONGLONG(online_alter_log_catchup_size,
+  srv_online_catchup_size,
+  PLUGIN_VAR_RQCMDARG,
+  "Size of the online table rebuild log above which it is applied while"
+  " ALTER TABLE is waiting for the exclusive table lock"
+  " (0=apply all of it under the exclusive lock)",
+  NULL, NULL, 0, 0, ~0ULL, 0);
+
 static MYSQL_SYSVAR_BOOL(optimize_fulltext_only, innodb_optimize_fulltext_only,
   PLUGIN_VAR_NOCMDARG,
   "Only optimize the Fulltext index of the table",
@@ -19427,6 +19640,11 @@ static MYSQL_SYSVAR_ULONG(write_io_threads, srv_n_write_io_threads,
   "Number of background write I/O threads in InnoDB.",
   NULL, NULL, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_n_recv_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log records to pages during crash recovery.",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Helps to save your data in case the disk image of the database becomes corrupt.",
@@ -19474,6 +19692,18 @@ static MYSQL_SYSVAR_UINT(old_blocks_time, buf_LRU_old_threshold_ms,
   " The timeout is disabled if 0.",
   NULL, NULL, 1000, 0, UINT_MAX32, 0);
 
+static MYSQL_SYSVAR_ENUM(buffer_pool_lru_policy, buf_LRU_policy,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "The buffer pool page replacement policy. Possible values are"
+  " MIDPOINT"
+  " insert pages that are read at the midpoint of the LRU list;"
+  " 2Q"
+  " like MIDPOINT, but remember pages that are evicted after they were"
+  " made young, and insert them directly into the new sublist"
+  " when they are read again.",
+  NULL, NULL, BUF_LRU_POLICY_MIDPOINT,
+  &innodb_buffer_pool_lru_policy_typelib);
+
 static MYSQL_SYSVAR_ULONG(open_files, innobase_open_files,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "How many files at the maximum InnoDB keeps open at the same time.",
@@ -19597,6 +19827,13 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
   "Use native AIO if supported on this platform.",
   NULL, NULL, TRUE);
 
+#ifdef LINUX_IO_URING
+static MYSQL_SYSVAR_BOOL(use_io_uring, srv_use_io_uring,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Use io_uring instead of libaio for native AIO.",
+  NULL, NULL, FALSE);
+#endif /* LINUX_IO_URING */
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
@@ -19617,6 +19854,13 @@ static MYSQL_SYSVAR_UINT(change_buffer_max_size,
   NULL, innodb_change_buffer_max_size_update,
   CHANGE_BUFFER_DEFAULT_SIZE, 0, 50, 0);
 
+static MYSQL_SYSVAR_ULONG(change_buffer_merge_threads,
+  innodb_change_buffer_merge_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads that merge the change buffer in the background"
+  " (0=merge in the master thread and when buffering changes)",
+  NULL, NULL, 0, 0, 32, 0);
+
 static MYSQL_SYSVAR_ENUM(stats_method, srv_innodb_stats_method,
    PLUGIN_VAR_RQCMDARG,
   "Specifies how InnoDB index statistics collection code should"
@@ -19830,7 +20074,7 @@ static MYSQL_SYSVAR_BOOL(force_primary_key,
   "Do not allow to create table without primary key (off by default)",
   NULL, NULL, FALSE);
 
-static const char *page_compression_algorithms[]= { "none", "zlib", "lz4", "lzo", "lzma", "bzip2", "snappy", 0 };
+static const char *page_compression_algorithms[]= { "none", "zlib", "lz4", "lzo", "lzma", "bzip2", "snappy", "zstd", 0 };
 static TYPELIB page_compression_algorithms_typelib=
 {
   array_elements(page_compression_algorithms) - 1, 0,
@@ -20003,6 +20247,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
   MYSQL_SYSVAR(write_io_threads),
+  MYSQL_SYSVAR(recovery_apply_threads),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(file_format), /* deprecated in MariaDB 10.2; no effect */
   MYSQL_SYSVAR(flush_log_at_timeout),
@@ -20024,6 +20269,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(locks_unsafe_for_binlog),
   MYSQL_SYSVAR(lock_wait_timeout),
   MYSQL_SYSVAR(deadlock_detect),
+  MYSQL_SYSVAR(deadlock_detect_interval),
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
   MYSQL_SYSVAR(log_file_size),
@@ -20042,6 +20288,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(max_purge_lag_delay),
   MYSQL_SYSVAR(old_blocks_pct),
   MYSQL_SYSVAR(old_blocks_time),
+  MYSQL_SYSVAR(buffer_pool_lru_policy),
   MYSQL_SYSVAR(open_files),
   MYSQL_SYSVAR(optimize_fulltext_only),
   MYSQL_SYSVAR(rollback_on_timeout),
@@ -20058,8 +20305,12 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_auto_recalc),
   MYSQL_SYSVAR(stats_modified_counter),
   MYSQL_SYSVAR(stats_traditional),
+  MYSQL_SYSVAR(stats_threads),
+  MYSQL_SYSVAR(stats_incremental_recalc),
+  MYSQL_SYSVAR(records_in_range_cache),
 #ifdef BTR_CUR_HASH_ADAPT
   MYSQL_SYSVAR(adaptive_hash_index),
+  MYSQL_SYSVAR(adaptive_hash_index_auto),
   MYSQL_SYSVAR(adaptive_hash_index_parts),
 #endif /* BTR_CUR_HASH_ADAPT */
   MYSQL_SYSVAR(stats_method),
@@ -20067,10 +20318,13 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(ddl_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
+  MYSQL_SYSVAR(online_alter_log_catchup_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
   MYSQL_SYSVAR(table_locks),
+  MYSQL_SYSVAR(bulk_insert),
   MYSQL_SYSVAR(thread_concurrency),
   MYSQL_SYSVAR(adaptive_max_sleep_delay),
   MYSQL_SYSVAR(prefix_index_cluster_optimization),
@@ -20079,11 +20333,15 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(version),
   MYSQL_SYSVAR(use_native_aio),
+#ifdef LINUX_IO_URING
+  MYSQL_SYSVAR(use_io_uring),
+#endif /* LINUX_IO_URING */
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(change_buffering),
   MYSQL_SYSVAR(change_buffer_max_size),
+  MYSQL_SYSVAR(change_buffer_merge_threads),
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
   MYSQL_SYSVAR(change_buffering_debug),
   MYSQL_SYSVAR(disable_background_merge),
@@ -20097,6 +20355,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(io_capacity),
   MYSQL_SYSVAR(io_capacity_max),
   MYSQL_SYSVAR(page_cleaners),
+  MYSQL_SYSVAR(page_compression_threads),
   MYSQL_SYSVAR(idle_flush_pct),
   MYSQL_SYSVAR(monitor_enable),
   MYSQL_SYSVAR(monitor_disable),
@@ -20220,7 +20479,9 @@ i_s_innodb_sys_virtual,
 i_s_innodb_mutexes,
 i_s_innodb_sys_semaphore_waits,
 i_s_innodb_tablespaces_encryption,
-i_s_innodb_tablespaces_scrubbing
+i_s_innodb_tablespaces_scrubbing,
+i_s_innodb_tablespaces_compression,
+i_s_innodb_adaptive_hash_indexes
 maria_declare_plugin_end;
 
 /** @brief Initialize the default value of innodb_commit_concurrency.
@@ -21285,6 +21546,17 @@ innodb_compression_algorithm_validate(
 		DBUG_RETURN(1);
 	}
 #endif
+
+#ifndef HAVE_ZSTD
+	if (compression_algorithm == PAGE_ZSTD_ALGORITHM) {
+		push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+				    HA_ERR_UNSUPPORTED,
+				    "InnoDB: innodb_compression_algorithm = %lu unsupported.\n"
+				    "InnoDB: libzstd is not installed. \n",
+				    compression_algorithm);
+		DBUG_RETURN(1);
+	}
+#endif
 	DBUG_RETURN(0);
 }
 
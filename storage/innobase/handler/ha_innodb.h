@@ -179,6 +179,10 @@ class ha_innobase: public handler
 
 	int reset();
 
+	void start_bulk_insert(ha_rows rows, uint flags);
+
+	int end_bulk_insert();
+
 	int external_lock(THD *thd, int lock_type);
 
 	int start_stmt(THD *thd, thr_lock_type lock_type);
@@ -942,6 +942,19 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 	/** The page_compression_level attribute, or 0 */
 	const uint	page_compression_level;
 
+	/** MySQL table for reporting duplicates while the rebuild log is
+	being applied in catchup_thread, or NULL */
+	TABLE*		catchup_table;
+	/** whether catchup_thread should exit */
+	volatile bool	catchup_exit;
+	/** event for waking up catchup_thread, or NULL */
+	os_event_t	catchup_event;
+	/** thread that applies the rebuild log while ALTER TABLE is
+	waiting for the exclusive lock; valid if catchup_table != NULL */
+	os_thread_id_t	catchup_thread;
+	/** error from applying the rebuild log in catchup_thread */
+	dberr_t		catchup_error;
+
 	ha_innobase_inplace_ctx(row_prebuilt_t*& prebuilt_arg,
 				dict_index_t** drop_arg,
 				ulint num_to_drop_arg,
@@ -999,7 +1012,11 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 				       ? (page_compression_level_arg
 					  ? uint(page_compression_level_arg)
 					  : page_zip_level)
-				       : 0)
+				       : 0),
+		catchup_table(NULL),
+		catchup_exit(false),
+		catchup_event(NULL),
+		catchup_error(DB_SUCCESS)
 	{
 		ut_ad(old_n_cols >= DATA_N_SYS_COLS);
 		ut_ad(page_compression_level <= 9);
@@ -1018,6 +1035,10 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 
 	~ha_innobase_inplace_ctx()
 	{
+		catchup_stop();
+		if (catchup_event) {
+			os_event_destroy(catchup_event);
+		}
 		UT_DELETE(m_stage);
 		if (instant_table) {
 			while (dict_index_t* index
@@ -1038,6 +1059,16 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 	@return whether the table will be rebuilt */
 	bool need_rebuild () const { return(old_table != new_table); }
 
+	/** Start applying the online rebuild log in catchup_thread while
+	ALTER TABLE is waiting for the exclusive lock, so that little of
+	the log is left to be applied under the lock.
+	@param[in,out]	altered_table	MySQL table for reporting duplicates */
+	void catchup_start(TABLE* altered_table);
+
+	/** Stop applying the online rebuild log in catchup_thread.
+	@return DB_SUCCESS, or the error from applying the log */
+	dberr_t catchup_stop();
+
 	/** Clear uncommmitted added indexes after a failed operation. */
 	void clear_added_indexes()
 	{
@@ -1134,6 +1165,100 @@ struct ha_innobase_inplace_ctx : public inplace_alter_handler_ctx
 	ha_innobase_inplace_ctx& operator=(const ha_innobase_inplace_ctx&);
 };
 
+/** Thread that applies the online rebuild log while ALTER TABLE is
+waiting for the exclusive lock. The log is applied whenever more than
+innodb_online_alter_log_catchup_size of it has accumulated.
+@param[in,out]	arg	ha_innobase_inplace_ctx
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(innobase_online_catchup_thread)(void* arg)
+{
+	ha_innobase_inplace_ctx*	ctx
+		= static_cast<ha_innobase_inplace_ctx*>(arg);
+	const dict_index_t*	index = dict_table_get_first_index(
+		ctx->old_table);
+	/* Progress is only reported by the ALTER TABLE thread. */
+	ut_stage_alter_t	stage(index);
+
+	for (;;) {
+		const int64_t	sig_count = os_event_reset(ctx->catchup_event);
+
+		if (ctx->catchup_exit) {
+			break;
+		}
+
+		const ulonglong	catchup_size = srv_online_catchup_size;
+
+		if (!catchup_size
+		    || row_log_table_backlog(index) < catchup_size) {
+			os_event_wait_time_low(ctx->catchup_event, 10000,
+					       sig_count);
+			continue;
+		}
+
+		ctx->catchup_error = row_log_table_apply(
+			ctx->thr, ctx->old_table, ctx->catchup_table,
+			&stage, ctx->new_table);
+		MONITOR_ATOMIC_INC(MONITOR_ONLINE_LOG_CATCHUP);
+
+		if (ctx->catchup_error != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start applying the online rebuild log in catchup_thread while
+ALTER TABLE is waiting for the exclusive lock, so that little of
+the log is left to be applied under the lock.
+@param[in,out]	altered_table	MySQL table for reporting duplicates */
+void
+ha_innobase_inplace_ctx::catchup_start(TABLE* altered_table)
+{
+	ut_ad(online);
+	ut_ad(need_rebuild());
+	ut_ad(!catchup_table);
+
+	/* Computing virtual column values requires the
+	ALTER TABLE thread. */
+	if (!srv_online_catchup_size || old_table->n_v_cols
+	    || new_table->n_v_cols) {
+		return;
+	}
+
+	if (!catchup_event) {
+		catchup_event = os_event_create(0);
+	}
+
+	catchup_table = altered_table;
+	catchup_exit = false;
+	catchup_error = DB_SUCCESS;
+
+	os_thread_create(innobase_online_catchup_thread, this,
+			 &catchup_thread);
+}
+
+/** Stop applying the online rebuild log in catchup_thread.
+@return DB_SUCCESS, or the error from applying the log */
+dberr_t
+ha_innobase_inplace_ctx::catchup_stop()
+{
+	if (!catchup_table) {
+		return(DB_SUCCESS);
+	}
+
+	catchup_exit = true;
+	os_event_set(catchup_event);
+	os_thread_join(catchup_thread);
+	catchup_table = NULL;
+
+	return(catchup_error);
+}
+
 /********************************************************************//**
 Get the upper limit of the MySQL integral and floating-point type.
 @return maximum allowed value for the field */
@@ -8419,6 +8544,11 @@ ha_innobase::inplace_alter_table(
 		ut_d(dict_table_check_for_dup_indexes(
 			     m_prebuilt->table, CHECK_PARTIAL_OK));
 		ut_d(mutex_exit(&dict_sys->mutex));
+		if (ctx->online && ctx->need_rebuild()) {
+			/* Keep applying the log while the SQL layer
+			is waiting for the exclusive lock. */
+			ctx->catchup_start(altered_table);
+		}
 		/* prebuilt->table->n_ref_count can be anything here,
 		given that we hold at most a shared lock on the table. */
 		goto ok_exit;
@@ -8611,6 +8741,10 @@ rollback_inplace_alter_table(
 
 	DBUG_ENTER("rollback_inplace_alter_table");
 
+	if (ctx) {
+		ctx->catchup_stop();
+	}
+
 	if (!ctx || !ctx->trx) {
 		/* If we have not started a transaction yet,
 		(almost) nothing has been or needs to be done. */
@@ -9831,11 +9965,17 @@ commit_try_rebuild(
 			ctx->new_table->vc_templ = s_templ;
 		}
 
-		error = row_log_table_apply(
-			ctx->thr, user_table, altered_table,
-			static_cast<ha_innobase_inplace_ctx*>(
-				ha_alter_info->handler_ctx)->m_stage,
-			ctx->new_table);
+		/* Apply the rest of the log that catchup_thread
+		did not apply. */
+		error = ctx->catchup_error;
+
+		if (error == DB_SUCCESS) {
+			error = row_log_table_apply(
+				ctx->thr, user_table, altered_table,
+				static_cast<ha_innobase_inplace_ctx*>(
+					ha_alter_info->handler_ctx)->m_stage,
+				ctx->new_table);
+		}
 
 		if (s_templ) {
 			ut_ad(ctx->need_rebuild());
@@ -10676,6 +10816,20 @@ ha_innobase::commit_inplace_alter_table(
 		ctx0->m_stage->begin_phase_end();
 	}
 
+	/* Stop applying the rebuild log in the background. The
+	exclusive lock is now held, and any error will be reported
+	by commit_try_rebuild(). */
+	if (ha_alter_info->group_commit_ctx) {
+		for (inplace_alter_handler_ctx** pctx
+			     = ha_alter_info->group_commit_ctx;
+		     *pctx; pctx++) {
+			static_cast<ha_innobase_inplace_ctx*>(*pctx)
+				->catchup_stop();
+		}
+	} else if (ctx0 != NULL) {
+		ctx0->catchup_stop();
+	}
+
 	if (!commit) {
 		/* A rollback is being requested. So far we may at
 		most have created some indexes. If any indexes were to
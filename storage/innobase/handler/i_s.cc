@@ -53,6 +53,7 @@ Modified Dec 29, 2014 Jan Lindström (Added sys_semaphore_waits)
 #include "fts0opt.h"
 #include "fts0priv.h"
 #include "btr0btr.h"
+#include "btr0sea.h"
 #include "page0zip.h"
 #include "sync0arr.h"
 #include "fil0fil.h"
@@ -3158,6 +3159,8 @@ int
 i_s_fts_index_cache_fill_one_index(
 /*===============================*/
 	fts_index_cache_t*	index_cache,	/*!< in: FTS index cache */
+	const ib_rbt_t*		words,		/*!< in: index_cache->words
+						or index_cache->sync_words */
 	THD*			thd,		/*!< in: thread */
 	fts_string_t*		conv_str,	/*!< in/out: buffer */
 	TABLE_LIST*		tables)		/*!< in/out: tables to fill */
@@ -3179,9 +3182,9 @@ i_s_fts_index_cache_fill_one_index(
 	int	ret = 0;
 
 	/* Go through each word in the index cache */
-	for (rbt_node = rbt_first(index_cache->words);
+	for (rbt_node = rbt_first(words);
 	     rbt_node;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+	     rbt_node = rbt_next(words, rbt_node)) {
 		fts_tokenizer_word_t* word;
 
 		word = rbt_value(fts_tokenizer_word_t, rbt_node);
@@ -3305,16 +3308,30 @@ i_s_fts_index_cache_fill(
 		* FTS_MAX_WORD_LEN_IN_CHAR;
 	conv_str.f_str = static_cast<byte*>(ut_malloc_nokey(conv_str.f_len));
 
+	/* Prevent a SYNC from freeing its snapshot of the cache. */
+	rw_lock_s_lock(&cache->lock);
+
 	for (ulint i = 0; i < ib_vector_size(cache->indexes); i++) {
 		fts_index_cache_t*      index_cache;
 
 		index_cache = static_cast<fts_index_cache_t*> (
 			ib_vector_get(cache->indexes, i));
 
+		/* The words that are being written by a SYNC
+		are still part of the cache. */
+		if (index_cache->sync_words) {
+			BREAK_IF(ret = i_s_fts_index_cache_fill_one_index(
+					 index_cache, index_cache->sync_words,
+					 thd, &conv_str, tables));
+		}
+
 		BREAK_IF(ret = i_s_fts_index_cache_fill_one_index(
-				 index_cache, thd, &conv_str, tables));
+				 index_cache, index_cache->words,
+				 thd, &conv_str, tables));
 	}
 
+	rw_lock_s_unlock(&cache->lock);
+
 	ut_free(conv_str.f_str);
 
 	dict_table_close(user_table, FALSE, FALSE);
@@ -8492,6 +8509,24 @@ static ST_FIELD_INFO	innodb_tablespaces_encryption_fields_info[] =
 	 STRUCT_FLD(old_name,		""),
 	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
 
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_THREADS 10
+	{STRUCT_FLD(field_name,		"KEY_ROTATION_THREADS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS 11
+	{STRUCT_FLD(field_name,		"KEY_ROTATION_ETA_SECONDS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
 	END_OF_ST_FIELD_INFO
 };
 
@@ -8549,11 +8584,26 @@ i_s_dict_fill_tablespaces_encryption(
 		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_MAX_PAGE_NUMBER]->set_notnull();
 		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_MAX_PAGE_NUMBER]->store(
 			   status.rotate_max_page_number, true));
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_THREADS]->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_THREADS]->store(
+			   status.rotate_threads, true));
 	} else {
 		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_PAGE_NUMBER]
 			->set_null();
 		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_MAX_PAGE_NUMBER]
 			->set_null();
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_THREADS]
+			->set_null();
+	}
+
+	if (status.rotating && status.rotate_eta != ULINT_UNDEFINED) {
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS]
+			->set_notnull();
+		OK(fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS]
+		   ->store(status.rotate_eta, true));
+	} else {
+		fields[TABLESPACES_ENCRYPTION_KEY_ROTATION_ETA_SECONDS]
+			->set_null();
 	}
 
 	OK(schema_table_store_record(thd, table_to_fill));
@@ -8947,6 +8997,224 @@ UNIV_INTERN struct st_maria_plugin	i_s_innodb_tablespaces_scrubbing =
 	STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE)
 };
 
+/**  TABLESPACES_COMPRESSION  ******************************************/
+/* Fields of the table INFORMATION_SCHEMA.INNODB_TABLESPACES_COMPRESSION.
+COMPRESS_OPS is the number of page_compressed page writes, COMPRESS_OPS_OK
+the number of pages that were written compressed, COMPRESSED_BYTES their
+total compressed size, and COMPRESS_TIME_US the time spent compressing
+all the pages, in microseconds. The compression ratio is
+COMPRESS_OPS_OK * @@innodb_page_size / COMPRESSED_BYTES. */
+static ST_FIELD_INFO	innodb_tablespaces_compression_fields_info[] =
+{
+#define TABLESPACES_COMPRESSION_SPACE	0
+	{STRUCT_FLD(field_name,		"SPACE"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define TABLESPACES_COMPRESSION_NAME	1
+	{STRUCT_FLD(field_name,		"NAME"),
+	 STRUCT_FLD(field_length,	MAX_FULL_NAME_LEN + 1),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_MAYBE_NULL),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define TABLESPACES_COMPRESSION_COMPRESS_OPS	2
+	{STRUCT_FLD(field_name,		"COMPRESS_OPS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define TABLESPACES_COMPRESSION_COMPRESS_OPS_OK	3
+	{STRUCT_FLD(field_name,		"COMPRESS_OPS_OK"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define TABLESPACES_COMPRESSION_COMPRESSED_BYTES	4
+	{STRUCT_FLD(field_name,		"COMPRESSED_BYTES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define TABLESPACES_COMPRESSION_COMPRESS_TIME_US	5
+	{STRUCT_FLD(field_name,		"COMPRESS_TIME_US"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+/** Fill a row of INFORMATION_SCHEMA.INNODB_TABLESPACES_COMPRESSION.
+@param[in]	thd		thread handle
+@param[in]	space		page_compressed tablespace
+@param[in,out]	table_to_fill	I_S table
+@return 0 on success */
+static
+int
+i_s_dict_fill_tablespaces_compression(
+	THD*			thd,
+	const fil_space_t*	space,
+	TABLE*			table_to_fill)
+{
+	Field**	fields = table_to_fill->field;
+
+	DBUG_ENTER("i_s_dict_fill_tablespaces_compression");
+
+	OK(fields[TABLESPACES_COMPRESSION_SPACE]->store(space->id, true));
+
+	OK(field_store_string(fields[TABLESPACES_COMPRESSION_NAME],
+			      space->name));
+
+	OK(fields[TABLESPACES_COMPRESSION_COMPRESS_OPS]->store(
+		   space->n_page_compress, true));
+
+	OK(fields[TABLESPACES_COMPRESSION_COMPRESS_OPS_OK]->store(
+		   space->n_page_compress_ok, true));
+
+	OK(fields[TABLESPACES_COMPRESSION_COMPRESSED_BYTES]->store(
+		   space->page_compress_bytes, true));
+
+	OK(fields[TABLESPACES_COMPRESSION_COMPRESS_TIME_US]->store(
+		   space->page_compress_time, true));
+
+	OK(schema_table_store_record(thd, table_to_fill));
+
+	DBUG_RETURN(0);
+}
+
+/*******************************************************************//**
+Function to populate INFORMATION_SCHEMA.INNODB_TABLESPACES_COMPRESSION
+with the page_compressed write statistics of each page_compressed
+tablespace.
+@return 0 on success */
+static
+int
+i_s_tablespaces_compression_fill_table(
+/*===================================*/
+	THD*		thd,	/*!< in: thread */
+	TABLE_LIST*	tables,	/*!< in/out: tables to fill */
+	Item*		)	/*!< in: condition (not used) */
+{
+	DBUG_ENTER("i_s_tablespaces_compression_fill_table");
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	/* deny access to user without PROCESS_ACL privilege */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+	mutex_enter(&fil_system.mutex);
+
+	for (fil_space_t* space = UT_LIST_GET_FIRST(fil_system.space_list);
+	     space; space = UT_LIST_GET_NEXT(space_list, space)) {
+		if (space->purpose == FIL_TYPE_TABLESPACE
+		    && space->is_compressed()
+		    && !space->is_stopping()) {
+			space->acquire();
+			mutex_exit(&fil_system.mutex);
+			if (int err = i_s_dict_fill_tablespaces_compression(
+				    thd, space, tables->table)) {
+				space->release();
+				DBUG_RETURN(err);
+			}
+			mutex_enter(&fil_system.mutex);
+			space->release();
+		}
+	}
+
+	mutex_exit(&fil_system.mutex);
+	DBUG_RETURN(0);
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_TABLESPACES_COMPRESSION
+@return 0 on success */
+static
+int
+innodb_tablespaces_compression_init(
+/*================================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("innodb_tablespaces_compression_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+
+	schema->fields_info = innodb_tablespaces_compression_fields_info;
+	schema->fill_table = i_s_tablespaces_compression_fill_table;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_tablespaces_compression =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_TABLESPACES_COMPRESSION"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, maria_plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB TABLESPACES_COMPRESSION"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, innodb_tablespaces_compression_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+	/* Maria extension */
+	STRUCT_FLD(version_info, INNODB_VERSION_STR),
+	STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE)
+};
+
 /**  INNODB_MUTEXES  *********************************************/
 /* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_MUTEXES */
 static ST_FIELD_INFO	innodb_mutexes_fields_info[] =
@@ -9442,3 +9710,323 @@ UNIV_INTERN struct st_maria_plugin	i_s_innodb_sys_semaphore_waits =
 	STRUCT_FLD(version_info, INNODB_VERSION_STR),
         STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
 };
+
+/**  ADAPTIVE_HASH_INDEXES  ********************************************/
+/* Fields of the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEXES */
+static ST_FIELD_INFO	innodb_adaptive_hash_indexes_fields_info[] =
+{
+#define AHI_INDEX_ID		0
+	{STRUCT_FLD(field_name,		"INDEX_ID"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_TABLE_NAME		1
+	{STRUCT_FLD(field_name,		"TABLE_NAME"),
+	 STRUCT_FLD(field_length,	MAX_FULL_NAME_LEN + 1),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_INDEX_NAME		2
+	{STRUCT_FLD(field_name,		"INDEX_NAME"),
+	 STRUCT_FLD(field_length,	NAME_LEN + 1),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_STATUS		3
+	{STRUCT_FLD(field_name,		"STATUS"),
+	 STRUCT_FLD(field_length,	8),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	0),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PAGES		4
+	{STRUCT_FLD(field_name,		"PAGES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_HITS		5
+	{STRUCT_FLD(field_name,		"HITS"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_MISSES		6
+	{STRUCT_FLD(field_name,		"MISSES"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PAGES_ADDED		7
+	{STRUCT_FLD(field_name,		"PAGES_ADDED"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_ROWS_ADDED		8
+	{STRUCT_FLD(field_name,		"ROWS_ADDED"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_PAGES_REMOVED	9
+	{STRUCT_FLD(field_name,		"PAGES_REMOVED"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_ROWS_REMOVED	10
+	{STRUCT_FLD(field_name,		"ROWS_REMOVED"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+#define AHI_TIMES_DISABLED	11
+	{STRUCT_FLD(field_name,		"TIMES_DISABLED"),
+	 STRUCT_FLD(field_length,	MY_INT64_NUM_DECIMAL_DIGITS),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_LONGLONG),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_UNSIGNED),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
+	END_OF_ST_FIELD_INFO
+};
+
+#ifdef BTR_CUR_HASH_ADAPT
+/** Adaptive hash index statistics of an index, copied while holding
+dict_sys->mutex */
+struct i_s_ahi_index_t
+{
+	/** index id */
+	index_id_t	id;
+	/** table name, allocated from the heap of the fill function */
+	const char*	table_name;
+	/** index name, allocated from the heap of the fill function */
+	const char*	index_name;
+	/** copy of index->search_info */
+	btr_search_t	info;
+};
+
+/** Copy the adaptive hash index statistics of the indexes of a table.
+@param[in]	table	table
+@param[in,out]	heap	memory heap for the names
+@param[in,out]	stats	statistics of the indexes that have used the
+			adaptive hash index */
+static
+void
+i_s_ahi_collect(
+	const dict_table_t*		table,
+	mem_heap_t*			heap,
+	std::vector<i_s_ahi_index_t>&	stats)
+{
+	ut_ad(mutex_own(&dict_sys->mutex));
+
+	for (const dict_index_t* index = dict_table_get_first_index(table);
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+		const btr_search_t*	info = index->search_info;
+
+		if (info == NULL
+		    || (!info->ref_count && !info->n_hits && !info->n_misses
+			&& !info->n_pages_added && !info->auto_disabled)) {
+			continue;
+		}
+
+		i_s_ahi_index_t	s;
+
+		s.id = index->id;
+		s.table_name = mem_heap_strdup(heap, table->name.m_name);
+		s.index_name = mem_heap_strdup(heap, index->name);
+		s.info = *info;
+		stats.push_back(s);
+	}
+}
+#endif /* BTR_CUR_HASH_ADAPT */
+
+/*******************************************************************//**
+Function to populate INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEXES.
+Loop through the tables in the dictionary cache, and fill in the adaptive
+hash index statistics of their indexes.
+@return 0 on success */
+static
+int
+i_s_innodb_adaptive_hash_indexes_fill_table(
+/*========================================*/
+	THD*		thd,	/*!< in: thread */
+	TABLE_LIST*	tables,	/*!< in/out: tables to fill */
+	Item*		)	/*!< in: condition (not used) */
+{
+	DBUG_ENTER("i_s_innodb_adaptive_hash_indexes_fill_table");
+	RETURN_IF_INNODB_NOT_STARTED(tables->schema_table_name.str);
+
+	/* deny access to user without PROCESS_ACL privilege */
+	if (check_global_access(thd, PROCESS_ACL)) {
+		DBUG_RETURN(0);
+	}
+
+#ifdef BTR_CUR_HASH_ADAPT
+	Field**				fields = tables->table->field;
+	mem_heap_t*			heap = mem_heap_create(1000);
+	std::vector<i_s_ahi_index_t>	stats;
+
+	mutex_enter(&dict_sys->mutex);
+
+	for (const dict_table_t* table = UT_LIST_GET_FIRST(
+		     dict_sys->table_LRU);
+	     table != NULL;
+	     table = UT_LIST_GET_NEXT(table_LRU, table)) {
+		i_s_ahi_collect(table, heap, stats);
+	}
+
+	for (const dict_table_t* table = UT_LIST_GET_FIRST(
+		     dict_sys->table_non_LRU);
+	     table != NULL;
+	     table = UT_LIST_GET_NEXT(table_LRU, table)) {
+		i_s_ahi_collect(table, heap, stats);
+	}
+
+	mutex_exit(&dict_sys->mutex);
+
+	int	ret = 0;
+
+	for (ulint i = 0; i < stats.size(); i++) {
+		const i_s_ahi_index_t&	s = stats[i];
+
+		if (fields[AHI_INDEX_ID]->store(longlong(s.id), true)
+		    || field_store_string(fields[AHI_TABLE_NAME],
+					  s.table_name)
+		    || field_store_string(fields[AHI_INDEX_NAME],
+					  s.index_name)
+		    || field_store_string(fields[AHI_STATUS],
+					  s.info.auto_disabled
+					  ? "DISABLED" : "ENABLED")
+		    || fields[AHI_PAGES]->store(s.info.ref_count, true)
+		    || fields[AHI_HITS]->store(s.info.n_hits, true)
+		    || fields[AHI_MISSES]->store(s.info.n_misses, true)
+		    || fields[AHI_PAGES_ADDED]->store(
+			    s.info.n_pages_added, true)
+		    || fields[AHI_ROWS_ADDED]->store(
+			    s.info.n_rows_added, true)
+		    || fields[AHI_PAGES_REMOVED]->store(
+			    s.info.n_pages_removed, true)
+		    || fields[AHI_ROWS_REMOVED]->store(
+			    s.info.n_rows_removed, true)
+		    || fields[AHI_TIMES_DISABLED]->store(
+			    s.info.n_auto_disabled, true)
+		    || schema_table_store_record(thd, tables->table)) {
+			ret = 1;
+			break;
+		}
+	}
+
+	mem_heap_free(heap);
+
+	DBUG_RETURN(ret);
+#else
+	DBUG_RETURN(0);
+#endif /* BTR_CUR_HASH_ADAPT */
+}
+
+/*******************************************************************//**
+Bind the dynamic table INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEXES
+@return 0 on success */
+static
+int
+innodb_adaptive_hash_indexes_init(
+/*==============================*/
+	void*	p)	/*!< in/out: table schema object */
+{
+	ST_SCHEMA_TABLE*	schema;
+
+	DBUG_ENTER("innodb_adaptive_hash_indexes_init");
+
+	schema = (ST_SCHEMA_TABLE*) p;
+
+	schema->fields_info = innodb_adaptive_hash_indexes_fields_info;
+	schema->fill_table = i_s_innodb_adaptive_hash_indexes_fill_table;
+
+	DBUG_RETURN(0);
+}
+
+UNIV_INTERN struct st_maria_plugin	i_s_innodb_adaptive_hash_indexes =
+{
+	/* the plugin type (a MYSQL_XXX_PLUGIN value) */
+	/* int */
+	STRUCT_FLD(type, MYSQL_INFORMATION_SCHEMA_PLUGIN),
+
+	/* pointer to type-specific plugin descriptor */
+	/* void* */
+	STRUCT_FLD(info, &i_s_info),
+
+	/* plugin name */
+	/* const char* */
+	STRUCT_FLD(name, "INNODB_ADAPTIVE_HASH_INDEXES"),
+
+	/* plugin author (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(author, maria_plugin_author),
+
+	/* general descriptive text (for SHOW PLUGINS) */
+	/* const char* */
+	STRUCT_FLD(descr, "InnoDB adaptive hash index statistics per index"),
+
+	/* the plugin license (PLUGIN_LICENSE_XXX) */
+	/* int */
+	STRUCT_FLD(license, PLUGIN_LICENSE_GPL),
+
+	/* the function to invoke when plugin is loaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(init, innodb_adaptive_hash_indexes_init),
+
+	/* the function to invoke when plugin is unloaded */
+	/* int (*)(void*); */
+	STRUCT_FLD(deinit, i_s_common_deinit),
+
+	/* plugin version (for SHOW PLUGINS) */
+	/* unsigned int */
+	STRUCT_FLD(version, INNODB_VERSION_SHORT),
+
+	/* struct st_mysql_show_var* */
+	STRUCT_FLD(status_vars, NULL),
+
+	/* struct st_mysql_sys_var** */
+	STRUCT_FLD(system_vars, NULL),
+
+        /* Maria extension */
+	STRUCT_FLD(version_info, INNODB_VERSION_STR),
+        STRUCT_FLD(maturity, MariaDB_PLUGIN_MATURITY_STABLE),
+};
@@ -192,6 +192,16 @@ uint	ibuf_debug;
 /** The insert buffer control structure */
 ibuf_t*	ibuf			= NULL;
 
+/** Number of change buffer merge threads
+(innodb_change_buffer_merge_threads) */
+ulong	innodb_change_buffer_merge_threads;
+
+/** Number of change buffer merge threads that are running */
+Atomic_counter<ulint>	ibuf_merge_n_threads_active;
+
+/** Event for waking up the change buffer merge threads */
+static os_event_t	ibuf_merge_event;
+
 /** @name Offsets to the per-page bits in the insert buffer bitmap */
 /* @{ */
 #define	IBUF_BITMAP_FREE	0	/*!< Bits indicating the
@@ -257,6 +267,10 @@ const ulint		IBUF_MERGE_THRESHOLD = 4;
 batch, in order to merge the entries for them in the insert buffer */
 const ulint		IBUF_MAX_N_PAGES_MERGED = IBUF_MERGE_AREA;
 
+/** Number of random positions in the ibuf tree that the change buffer
+merge threads look at, merging the pages with the most buffered changes */
+const ulint		IBUF_MERGE_N_SAMPLES = 3;
+
 /** If the combined size of the ibuf trees exceeds ibuf->max_size by this
 many pages, we start to contract it in connection to inserts there, using
 non-synchronous contract */
@@ -394,6 +408,11 @@ ibuf_close(void)
 
 	mutex_free(&ibuf_bitmap_mutex);
 
+	if (ibuf_merge_event) {
+		ut_ad(!ibuf_merge_n_threads_active);
+		os_event_destroy(ibuf_merge_event);
+	}
+
 	dict_table_t*	ibuf_table = ibuf->index->table;
 	rw_lock_free(&ibuf->index->lock);
 	dict_mem_index_free(ibuf->index);
@@ -2375,25 +2394,22 @@ ibuf_get_merge_pages(
 	return(volume);
 }
 
-/*********************************************************************//**
-Contracts insert buffer trees by reading pages to the buffer pool.
+/** Choose pages to merge from a random position of the change buffer.
+@param[out]	space_ids	tablespace identifiers of the pages
+@param[out]	page_nos	page numbers
+@param[out]	n_pages		number of pages
 @return a lower limit for the combined size in bytes of entries which
-will be merged from ibuf trees to the pages read, 0 if ibuf is
-empty */
+will be merged from ibuf trees to the pages, plus 1; 0 if ibuf is empty */
 static
 ulint
-ibuf_merge_pages(
-/*=============*/
-	ulint*	n_pages,	/*!< out: number of pages to which merged */
-	bool	sync)		/*!< in: true if the caller wants to wait for
-				the issued read with the highest tablespace
-				address to complete */
+ibuf_merge_sample(
+	ulint*	space_ids,
+	ulint*	page_nos,
+	ulint*	n_pages)
 {
 	mtr_t		mtr;
 	btr_pcur_t	pcur;
 	ulint		sum_sizes;
-	ulint		page_nos[IBUF_MAX_N_PAGES_MERGED];
-	ulint		space_ids[IBUF_MAX_N_PAGES_MERGED];
 
 	*n_pages = 0;
 
@@ -2430,17 +2446,67 @@ ibuf_merge_pages(
 					    btr_pcur_get_rec(&pcur), &mtr,
 					    space_ids,
 					    page_nos, n_pages);
+	ibuf_mtr_commit(&mtr);
+	btr_pcur_close(&pcur);
+
+	return(sum_sizes + 1);
+}
+
+/*********************************************************************//**
+Contracts insert buffer trees by reading pages to the buffer pool.
+@return a lower limit for the combined size in bytes of entries which
+will be merged from ibuf trees to the pages read, 0 if ibuf is
+empty */
+static
+ulint
+ibuf_merge_pages(
+/*=============*/
+	ulint*	n_pages,	/*!< out: number of pages to which merged */
+	bool	sync,		/*!< in: true if the caller wants to wait for
+				the issued read with the highest tablespace
+				address to complete */
+	ulint	n_samples)	/*!< in: number of random positions to
+				look at; the pages with the most
+				buffered changes will be merged */
+{
+	ulint		sum_sizes;
+	ulint		page_nos[IBUF_MAX_N_PAGES_MERGED];
+	ulint		space_ids[IBUF_MAX_N_PAGES_MERGED];
+
+	ut_ad(n_samples > 0);
+
+	sum_sizes = ibuf_merge_sample(space_ids, page_nos, n_pages);
+
+	for (ulint i = 1; sum_sizes && i < n_samples; i++) {
+		ulint	sample_page_nos[IBUF_MAX_N_PAGES_MERGED];
+		ulint	sample_space_ids[IBUF_MAX_N_PAGES_MERGED];
+		ulint	n_sample;
+		ulint	size = ibuf_merge_sample(
+			sample_space_ids, sample_page_nos, &n_sample);
+
+		if (size > sum_sizes) {
+			sum_sizes = size;
+			*n_pages = n_sample;
+			memcpy(page_nos, sample_page_nos,
+			       n_sample * sizeof *page_nos);
+			memcpy(space_ids, sample_space_ids,
+			       n_sample * sizeof *space_ids);
+		}
+	}
+
+	if (!sum_sizes) {
+		return(0);
+	}
+
 #if 0 /* defined UNIV_IBUF_DEBUG */
 	fprintf(stderr, "Ibuf contract sync %lu pages %lu volume %lu\n",
 		sync, *n_pages, sum_sizes);
 #endif
-	ibuf_mtr_commit(&mtr);
-	btr_pcur_close(&pcur);
 
 	buf_read_ibuf_merge_pages(
 		sync, space_ids, page_nos, *n_pages);
 
-	return(sum_sizes + 1);
+	return(sum_sizes);
 }
 
 /*********************************************************************//**
@@ -2519,6 +2585,7 @@ ibuf_merge_space(
 @param[out]	n_pages		number of pages merged
 @param[in]	sync		whether the caller waits for
 the issued reads to complete
+@param[in]	n_samples	number of random positions to look at
 @return a lower limit for the combined size in bytes of entries which
 will be merged from ibuf trees to the pages read, 0 if ibuf is
 empty */
@@ -2526,7 +2593,8 @@ static MY_ATTRIBUTE((warn_unused_result))
 ulint
 ibuf_merge(
 	ulint*		n_pages,
-	bool		sync)
+	bool		sync,
+	ulint		n_samples = 1)
 {
 	*n_pages = 0;
 
@@ -2542,7 +2610,7 @@ ibuf_merge(
 		return(0);
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
 	} else {
-		return(ibuf_merge_pages(n_pages, sync));
+		return(ibuf_merge_pages(n_pages, sync, n_samples));
 	}
 }
 
@@ -2558,7 +2626,105 @@ ibuf_contract(
 {
 	ulint	n_pages;
 
-	return(ibuf_merge_pages(&n_pages, sync));
+	return(ibuf_merge_pages(&n_pages, sync, 1));
+}
+
+/** Queue change buffer merge work for the change buffer merge threads.
+@param[in]	n_pages	number of pages to read for merging */
+static
+void
+ibuf_merge_queue(ulint n_pages)
+{
+	ut_ad(ibuf_merge_n_threads_active);
+
+	mutex_enter(&ibuf_mutex);
+	ibuf->merge_pending = std::min(ibuf->merge_pending + n_pages,
+				       ibuf->max_size);
+	mutex_exit(&ibuf_mutex);
+
+	os_event_set(ibuf_merge_event);
+}
+
+/** Claim a batch of the queued change buffer merge work.
+@return whether any work was queued */
+static
+bool
+ibuf_merge_claim()
+{
+	DBUG_EXECUTE_IF("ibuf_merge_threads_idle", return(false););
+
+	mutex_enter(&ibuf_mutex);
+	const bool	claimed = ibuf->merge_pending != 0;
+	ibuf->merge_pending -= std::min(ibuf->merge_pending,
+					IBUF_MAX_N_PAGES_MERGED);
+	mutex_exit(&ibuf_mutex);
+
+	return(claimed);
+}
+
+/** Change buffer merge thread. Reads the pages for which the change
+buffer contains the most changes, so that the changes will be merged
+in the I/O completion of those reads and not when a user thread
+happens to read the pages.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(ibuf_merge_thread)(void*)
+{
+	while (srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+		const int64_t	sig_count = os_event_reset(ibuf_merge_event);
+
+		while (srv_shutdown_state == SRV_SHUTDOWN_NONE
+		       && ibuf_merge_claim()) {
+			ulint	n_pages;
+
+			if (!ibuf_merge(&n_pages, false,
+					IBUF_MERGE_N_SAMPLES)) {
+				/* The change buffer is empty. */
+				mutex_enter(&ibuf_mutex);
+				ibuf->merge_pending = 0;
+				mutex_exit(&ibuf_mutex);
+				break;
+			}
+
+			MONITOR_INC_VALUE(MONITOR_IBUF_MERGE_THREAD_PAGES,
+					  n_pages);
+		}
+
+		os_event_wait_low(ibuf_merge_event, sig_count);
+	}
+
+	ibuf_merge_n_threads_active--;
+
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start the change buffer merge threads. */
+void
+ibuf_merge_threads_create()
+{
+	if (!innodb_change_buffer_merge_threads) {
+		return;
+	}
+
+	ibuf_merge_event = os_event_create(0);
+
+	for (ulong i = 0; i < innodb_change_buffer_merge_threads; i++) {
+		ibuf_merge_n_threads_active++;
+		os_thread_create(ibuf_merge_thread, NULL, NULL);
+	}
+}
+
+/** Wake up the change buffer merge threads, so that they will notice
+the shutdown. */
+void
+ibuf_merge_threads_wakeup()
+{
+	if (ibuf_merge_event) {
+		os_event_set(ibuf_merge_event);
+	}
 }
 
 /** Contract the change buffer by reading pages to the buffer pool.
@@ -2610,6 +2776,15 @@ ibuf_merge_in_background(
 	}
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
 
+	if (ibuf_merge_n_threads_active
+	    && srv_shutdown_state == SRV_SHUTDOWN_NONE) {
+		/* Let the change buffer merge threads read the pages.
+		During shutdown they will have exited, and the merge
+		will be completed by the caller. */
+		ibuf_merge_queue(n_pages);
+		return(0);
+	}
+
 	while (sum_pages < n_pages) {
 		ulint	n_bytes;
 
@@ -2656,6 +2831,15 @@ ibuf_contract_after_insert(
 
 	sync = (size >= max_size + IBUF_CONTRACT_ON_INSERT_SYNC);
 
+	if (!sync && ibuf_merge_n_threads_active) {
+		/* Let the change buffer merge threads do the work,
+		unless the change buffer has grown too big. */
+		ibuf_merge_queue(IBUF_MAX_N_PAGES_MERGED);
+		return;
+	}
+
+	MONITOR_INC(MONITOR_IBUF_CONTRACT_ON_INSERT);
+
 	/* Contract at least entry_size many bytes */
 	sum_sizes = 0;
 	size = 1;
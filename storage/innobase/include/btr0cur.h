@@ -613,6 +613,11 @@ btr_estimate_n_rows_in_range(
 	const dtuple_t*	tuple2,
 	page_cur_mode_t	mode2);
 
+/** Free the cached node pointers of an index.
+@param[in,out]	index	index whose range_cache to free */
+void
+btr_range_cache_free(dict_index_t* index);
+
 /*******************************************************************//**
 Estimates the number of different key values in a given index, for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
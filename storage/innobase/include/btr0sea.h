@@ -255,6 +255,34 @@ struct btr_search_t{
 				the same prefix should be indexed in the
 				hash index */
 	/*---------------------- @} */
+	/* @{ Per-index accounting of the adaptive hash index, for
+	innodb_adaptive_hash_index_auto and
+	INFORMATION_SCHEMA.INNODB_ADAPTIVE_HASH_INDEXES. Like the
+	fields above, these are not protected by any latch, and the
+	values are approximate. */
+	ulint	n_hits;		/*!< number of successful hash searches */
+	ulint	n_misses;	/*!< number of failed hash searches */
+	ulint	n_pages_added;	/*!< number of pages hashed */
+	ulint	n_rows_added;	/*!< number of records hashed when
+				building page hash indexes */
+	ulint	n_pages_removed;/*!< number of page hash indexes dropped */
+	ulint	n_rows_removed;	/*!< number of records removed from
+				the hash index when dropping page hash
+				indexes */
+	ulint	n_auto_disabled;/*!< number of times the hash index was
+				disabled for this index because it cost
+				more than it saved */
+	bool	auto_disabled;	/*!< true if the hash index is disabled
+				for this index by
+				innodb_adaptive_hash_index_auto */
+	ulint	auto_retry;	/*!< while auto_disabled, number of
+				searches until the hash index is tried
+				again */
+	ulint	auto_hits;	/*!< n_hits at the last evaluation */
+	ulint	auto_misses;	/*!< n_misses at the last evaluation */
+	ulint	auto_rows;	/*!< n_rows_added + n_rows_removed at the
+				last evaluation */
+	/* @} */
 #ifdef UNIV_SEARCH_PERF_STAT
 	ulint	n_hash_succ;	/*!< number of successful hash searches thus
 				far */
@@ -279,6 +307,10 @@ struct btr_search_sys_t{
 					to rec_t pointers on index pages */
 };
 
+/** Whether the adaptive hash index is disabled and re-enabled for each
+index automatically (innodb_adaptive_hash_index_auto) */
+extern my_bool			btr_search_auto;
+
 /** Latches protecting access to adaptive hash index. */
 extern rw_lock_t**		btr_search_latches;
 
@@ -305,6 +337,23 @@ pattern */
 the hash index */
 #define BTR_SEARCH_ON_HASH_LIMIT	3
 
+/** With innodb_adaptive_hash_index_auto, the usefulness of the hash index
+of an index is evaluated after this many hash searches or page hash index
+builds and drops */
+#define BTR_SEARCH_AUTO_WINDOW		10000
+
+/** Hashing this many records when building or dropping a page hash index
+is assumed to cost as much as a B-tree search that the hash index saves */
+#define BTR_SEARCH_AUTO_ROWS_PER_SEARCH	8
+
+/** After the hash index was disabled for an index, this many searches
+(multiplied by the number of times it was disabled, up to
+BTR_SEARCH_AUTO_RETRY_MAX) are done before it is tried again */
+#define BTR_SEARCH_AUTO_RETRY		100000
+
+/** Maximum multiplier of BTR_SEARCH_AUTO_RETRY */
+#define BTR_SEARCH_AUTO_RETRY_MAX	64
+
 /** We do this many searches before trying to keep the search latch
 over calls from MySQL. If we notice someone waiting for the latch, we
 again set this much timeout. This is to reduce contention. */
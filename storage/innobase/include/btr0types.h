@@ -36,6 +36,8 @@ struct btr_pcur_t;
 struct btr_cur_t;
 /** B-tree search information for the adaptive hash index */
 struct btr_search_t;
+/** Cached node pointers of an index, for btr_estimate_n_rows_in_range() */
+struct btr_range_cache_t;
 
 #ifdef BTR_CUR_HASH_ADAPT
 /** Is search system enabled.
@@ -156,6 +156,7 @@ struct buf_pool_info_t{
 					LIST */
 	ulint	n_pages_made_young;	/*!< number of pages made young */
 	ulint	n_pages_not_made_young;	/*!< number of pages not made young */
+	ulint	n_pages_ghost_young;	/*!< buf_pool->n_pages_ghost_young */
 	ulint	n_pages_read;		/*!< buf_pool->n_pages_read */
 	ulint	n_pages_created;	/*!< buf_pool->n_pages_created */
 	ulint	n_pages_written;	/*!< buf_pool->n_pages_written */
@@ -193,6 +194,15 @@ struct buf_pool_info_t{
 	double	pages_evicted_rate;	/*!< rate of readahead page evicted
 					without access, in pages per second */
 
+	/* Statistics about the page cleaner */
+	double	page_cleaner_lru_rate;	/*!< pages flushed from the LRU list
+					by the page cleaner per second */
+	double	page_cleaner_list_rate;	/*!< pages flushed from the
+					flush_list by the page cleaner
+					per second */
+	ulint	n_page_cleaner_stalls;	/*!< buf_pool->stat.
+					n_page_cleaner_stalls */
+
 	/* Stats about LRU eviction */
 	ulint	unzip_lru_len;		/*!< length of buf_pool->unzip_LRU
 					list */
@@ -2067,8 +2077,23 @@ struct buf_pool_stat_t{
 				young because the first access
 				was not long enough ago, in
 				buf_page_peek_if_too_old() */
+	ulint	n_pages_ghost_young; /*!< number of pages that were
+				read directly into the "new" sublist
+				because they were found in
+				buf_pool_t::LRU_ghost */
 	ulint	LRU_bytes;	/*!< LRU size in bytes */
 	ulint	flush_list_bytes;/*!< flush_list size in bytes */
+	ulint	n_page_cleaner_lru;/*!< number of pages flushed from
+				the LRU list by the page cleaner;
+				protected by the page cleaner mutex */
+	ulint	n_page_cleaner_list;/*!< number of pages flushed from
+				the flush_list by the page cleaner;
+				protected by the page cleaner mutex */
+	ulint	n_page_cleaner_stalls;/*!< number of page cleaner
+				iterations that did not wait for
+				the flushing of this instance to
+				finish; protected by the page
+				cleaner mutex */
 };
 
 /** Statistics of buddy blocks of a given size. */
@@ -2270,6 +2295,16 @@ struct buf_pool_t{
 					/*!< base node of the
 					unzip_LRU list */
 
+	ulint*		LRU_ghost;	/*!< page_id_t::fold() of pages
+					that were evicted after having
+					been in the "new" sublist of the
+					LRU list; a direct-mapped table
+					where 0 means an empty slot;
+					NULL unless
+					buf_LRU_policy
+					== BUF_LRU_POLICY_2Q */
+	ulint		LRU_ghost_size;	/*!< number of LRU_ghost[] slots */
+
 	/* @} */
 	/** @name Buddy allocator fields
 	The buddy allocator is used for allocating compressed page
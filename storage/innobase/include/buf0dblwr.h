@@ -124,15 +124,35 @@ buf_dblwr_write_single_page(
 
 /** Doublewrite control struct */
 struct buf_dblwr_t{
-	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
-				field and write_buf */
+	ib_mutex_t	mutex;	/*!< mutex protecting the batches,
+				active, s_reserved, in_use and
+				buf_block_arr */
 	ulint		block1;	/*!< the page number of the first
 				doublewrite block (64 pages) */
 	ulint		block2;	/*!< page number of the second block */
-	ulint		first_free;/*!< first free position in write_buf
-				measured in units of srv_page_size */
-	ulint		b_reserved;/*!< number of slots currently reserved
-				for batch flush. */
+	/** A batch of pages that are first written to the doublewrite
+	buffer and then to the data files. The batch owns the slots
+	[first, first + size) of write_buf and buf_block_arr. */
+	struct batch_t {
+		ulint	first;	/*!< first slot of the batch */
+		ulint	size;	/*!< number of slots in the batch */
+		ulint	first_free;/*!< number of pages posted to the
+				batch */
+		ulint	reserved;/*!< number of pages whose data file
+				write has not completed yet */
+		bool	running;/*!< set to true while the batch is
+				being written; no pages can be posted to
+				a running batch */
+	};
+	/** Number of batches. The slots for batch flushing are divided
+	between them, so that pages can be posted to one batch while
+	the doublewrite and data file writes of the other batch are
+	in progress. */
+	static const ulint N_BATCHES = 2;
+	batch_t		batches[N_BATCHES];
+	ulint		active;	/*!< index of the batch that pages
+				are being posted to; any other batch is
+				either empty or running */
 	os_event_t	b_event;/*!< event where threads wait for a
 				batch flush to end;
 				os_event_set() and os_event_reset()
@@ -144,9 +164,6 @@ struct buf_dblwr_t{
 	bool*		in_use;	/*!< flag used to indicate if a slot is
 				in use. Only used for single page
 				flushes. */
-	bool		batch_running;/*!< set to TRUE if currently a batch
-				is being written from the doublewrite
-				buffer. */
 	byte*		write_buf;/*!< write buffer used in writing to the
 				doublewrite buffer, aligned to an
 				address divisible by srv_page_size
@@ -156,6 +173,9 @@ struct buf_dblwr_t{
 	buf_page_t**	buf_block_arr;/*!< array to store pointers to
 				the buffer blocks which have been
 				cached to write_buf */
+	buf_page_t**	write_arr;/*!< copy of buf_block_arr for each
+				running batch, sorted by page identifier
+				for submitting the data file writes */
 };
 
 #endif
@@ -44,6 +44,9 @@ extern my_bool		innodb_page_cleaner_disabled_debug;
 /** Event to synchronise with the flushing. */
 extern os_event_t	buf_flush_event;
 
+/** Number of page compression threads (innodb_page_compression_threads) */
+extern ulong		innodb_page_compression_threads;
+
 class ut_stage_alter_t;
 
 /** Handled page counters for a single flush */
@@ -246,6 +249,15 @@ DECLARE_THREAD(buf_flush_page_cleaner_worker)(
 void
 buf_flush_page_cleaner_init(void);
 
+/** Start the page compression threads. */
+void
+buf_flush_compress_threads_create();
+
+/** Stop the page compression threads, after the page cleaner has
+exited. */
+void
+buf_flush_compress_threads_shutdown();
+
 /** Wait for any possible LRU flushes that are in progress to end. */
 void
 buf_flush_wait_LRU_batch_end(void);
@@ -262,6 +262,22 @@ least this many milliseconds ago.  Not protected by any mutex or latch. */
 extern uint	buf_LRU_old_threshold_ms;
 /* @} */
 
+/** Page replacement policies (innodb_buffer_pool_lru_policy) */
+enum buf_LRU_policy_t {
+	/** Pages that are read from a file are inserted at the
+	midpoint of the LRU list, and moved to the "new" end on
+	an access after buf_LRU_old_threshold_ms */
+	BUF_LRU_POLICY_MIDPOINT,
+	/** Like BUF_LRU_POLICY_MIDPOINT, but pages that are evicted
+	after having been in the "new" sublist are remembered in
+	buf_pool_t::LRU_ghost, and when such a page is read again,
+	it is inserted directly at the "new" end */
+	BUF_LRU_POLICY_2Q
+};
+
+/** innodb_buffer_pool_lru_policy; read-only after startup */
+extern ulong	buf_LRU_policy;
+
 /** @brief Statistics for selecting the LRU list for eviction.
 
 These statistics are not 'of' LRU but 'for' LRU.  We keep count of I/O
@@ -288,4 +304,10 @@ Increments the I/O counter in buf_LRU_stat_cur. */
 Increments the page_zip_decompress() counter in buf_LRU_stat_cur. */
 #define buf_LRU_stat_inc_unzip() buf_LRU_stat_cur.unzip++
 
+/** Note that a ROW_FORMAT=COMPRESSED index page had to be decompressed
+again after its uncompressed frame had been evicted.
+@param[in]	block	the block that the page was decompressed into */
+void
+buf_LRU_stat_inc_refetch(const buf_block_t* block);
+
 #endif
@@ -985,6 +985,15 @@ struct dict_index_t {
 	btr_search_t*	search_info;
 				/*!< info used in optimistic searches */
 #endif /* BTR_CUR_ADAPT */
+	btr_range_cache_t*
+			range_cache;
+				/*!< cached node pointers for estimating
+				the number of records in a range, or NULL;
+				protected by dict_table_stats_lock() */
+	bool		range_cache_building;
+				/*!< whether a thread is rebuilding
+				range_cache; protected by
+				dict_table_stats_lock() */
 	row_log_t*	online_log;
 				/*!< the log of modifications
 				during online index creation;
@@ -2036,6 +2045,11 @@ struct dict_table_t {
 	any latch, because this is only used for heuristics. */
 	ib_uint64_t				stat_modified_counter;
 
+	/** Number of automatic recalculations of the persistent
+	statistics that were extrapolated from the index sizes since
+	the indexes were last sampled. See innodb_stats_incremental_recalc. */
+	ulint					stats_n_incremental;
+
 	/** Background stats thread is not working on this table. */
 	#define BG_STAT_NONE			0
 
@@ -2111,7 +2125,7 @@ struct dict_table_t {
 	ulong					n_waiting_or_granted_auto_inc_locks;
 
 	/** The transaction that currently holds the the AUTOINC lock on this
-	table. Protected by lock_sys.mutex. */
+	table. Protected by lock_sys.latch. */
 	const trx_t*				autoinc_trx;
 
 	/* @} */
@@ -2126,8 +2140,8 @@ struct dict_table_t {
 
 	/** Count of the number of record locks on this table. We use this to
 	determine whether we can evict the table from the dictionary cache.
-	It is protected by lock_sys.mutex. */
-	ulint					n_rec_locks;
+	It is modified by lock_sys.latch holders, possibly in shared mode. */
+	Atomic_counter<ulint>			n_rec_locks;
 
 private:
 	/** Count of how many handles are opened to this table. Dropping of the
@@ -2136,7 +2150,7 @@ struct dict_table_t {
 	Atomic_counter<uint32_t>		n_ref_count;
 
 public:
-	/** List of locks on the table. Protected by lock_sys.mutex. */
+	/** List of locks on the table. Protected by lock_sys.latch. */
 	table_lock_list_t			locks;
 
 	/** Timestamp of the last modification of this table. */
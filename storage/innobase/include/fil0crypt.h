@@ -212,6 +212,9 @@ struct fil_space_crypt_status_t {
 	bool flushing;           /*!< is flush at end of rotation ongoing */
 	ulint rotate_next_page_number; /*!< next page if key rotating */
 	ulint rotate_max_page_number;  /*!< max page if key rotating */
+	ulint rotate_threads;	 /*!< threads rotating the space */
+	ulint rotate_eta;	 /*!< estimated seconds until the pages
+				 have been rotated, or ULINT_UNDEFINED */
 };
 
 /** Statistics about encryption key rotation */
@@ -177,6 +177,19 @@ struct fil_space_t {
 	punch hole */
 	bool		punch_hole;
 
+	/** @name page_compressed write statistics, shown in
+	INFORMATION_SCHEMA.INNODB_TABLESPACES_COMPRESSION */
+	/* @{ */
+	/** number of pages that were attempted to compress */
+	Atomic_counter<ulint>	n_page_compress;
+	/** number of pages that were written compressed */
+	Atomic_counter<ulint>	n_page_compress_ok;
+	/** total size of the compressed pages that were written */
+	Atomic_counter<ulint>	page_compress_bytes;
+	/** time spent compressing pages, in microseconds */
+	Atomic_counter<ulint>	page_compress_time;
+	/* @} */
+
 	ulint		magic_n;/*!< FIL_SPACE_MAGIC_N */
 
 	/** @return whether the tablespace is about to be dropped */
@@ -383,6 +396,7 @@ struct fil_space_t {
 		case PAGE_LZ4_ALGORITHM:
 		case PAGE_LZO_ALGORITHM:
 		case PAGE_SNAPPY_ALGORITHM:
+		case PAGE_ZSTD_ALGORITHM:
 			return true;
 		}
 		return false;
@@ -43,7 +43,8 @@ have a smaller fil_space_t::id. */
 #define PAGE_LZMA_ALGORITHM	4
 #define PAGE_BZIP2_ALGORITHM	5
 #define PAGE_SNAPPY_ALGORITHM	6
-#define PAGE_ALGORITHM_LAST	PAGE_SNAPPY_ALGORITHM
+#define PAGE_ZSTD_ALGORITHM	7
+#define PAGE_ALGORITHM_LAST	PAGE_ZSTD_ALGORITHM
 
 /** @name Flags for inserting records in order
 If records are inserted in order, there are the following
@@ -67,6 +67,9 @@ struct fts_index_cache_t {
 	ib_rbt_t*	words;		/*!< Nodes; indexed by fts_string_t*,
 					cells are fts_tokenizer_word_t*.*/
 
+	ib_rbt_t*	sync_words;	/*!< words being written by SYNC, or
+					NULL; like words, but read-only */
+
 	ib_vector_t*	doc_stats;	/*!< Array of the fts_doc_stats_t
 					contained in the memory buffer.
 					Must be in sorted order (ascending).
@@ -130,6 +133,17 @@ struct fts_sync_t {
 	os_event_t	event;		/*!< sync finish event;
 					only os_event_set() and os_event_wait()
 					are used */
+	mem_heap_t*	heap;		/*!< memory of the snapshot of the
+					cache that is being written, or NULL;
+					the snapshot consists of
+					fts_index_cache_t::sync_words and
+					deleted_doc_ids */
+	ib_vector_t*	deleted_doc_ids;/*!< deleted doc ids of the snapshot */
+	doc_id_t	sync_doc_id;	/*!< max_doc_id when the snapshot
+					was taken */
+	trx_t*		part_trx[FTS_NUM_AUX_INDEX];
+					/*!< transactions writing the auxiliary
+					INDEX tables in parallel, or NULL */
 };
 
 /** The cache for the FTS system. It is a memory-based inverted index
@@ -308,6 +308,14 @@ thd_lock_wait_timeout(
 /*==================*/
 	THD*	thd);	/*!< in: thread handle, or NULL to query
 			the global innodb_lock_wait_timeout */
+/** Get the value of innodb_ddl_threads.
+@param[in]	thd	thread handle, or NULL to query
+			the global innodb_ddl_threads
+@return number of threads for building secondary indexes */
+ulint
+thd_ddl_threads(
+	THD*	thd);
+
 /** Get status of innodb_tmpdir.
 @param[in]	thd	thread handle, or NULL to query
 			the global innodb_tmpdir.
@@ -64,6 +64,13 @@ extern ulong		innodb_change_buffering;
 /** The insert buffer control structure */
 extern ibuf_t*		ibuf;
 
+/** Number of change buffer merge threads
+(innodb_change_buffer_merge_threads) */
+extern ulong		innodb_change_buffer_merge_threads;
+
+/** Number of change buffer merge threads that are running */
+extern Atomic_counter<ulint>	ibuf_merge_n_threads_active;
+
 /* The purpose of the insert buffer is to reduce random disk access.
 When we wish to insert a record into a non-unique secondary index and
 the B-tree leaf page where the record belongs to is not in the buffer
@@ -357,6 +364,15 @@ ulint
 ibuf_merge_in_background(
 	bool	full);
 
+/** Start the change buffer merge threads. */
+void
+ibuf_merge_threads_create();
+
+/** Wake up the change buffer merge threads, so that they will notice
+the shutdown. */
+void
+ibuf_merge_threads_wakeup();
+
 /** Contracts insert buffer trees by reading pages referring to space_id
 to the buffer pool.
 @returns number of pages merged.*/
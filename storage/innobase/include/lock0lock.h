@@ -56,6 +56,18 @@ class ReadView;
 /** The value of innodb_deadlock_detect */
 extern my_bool	innobase_deadlock_detect;
 
+/** The value of innodb_deadlock_detect_interval: milliseconds between
+searches of the waits-for graph in lock_wait_timeout_thread(), or 0 to
+search on every lock wait */
+extern ulong	innodb_deadlock_detect_interval;
+
+/** Look for deadlocks among the waiting transactions and roll back
+a victim of each, without holding lock_sys.latch during the search.
+This is invoked by lock_wait_timeout_thread() every
+innodb_deadlock_detect_interval milliseconds. */
+void
+lock_deadlock_check_waits();
+
 /*********************************************************************//**
 Gets the size of a lock struct.
 @return size in bytes */
@@ -450,13 +462,13 @@ lock_table(
 	lock_mode	mode,	/*!< in: lock mode */
 	que_thr_t*	thr)	/*!< in: query thread */
 	MY_ATTRIBUTE((warn_unused_result));
-/*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
+/** Create a table lock object for a resurrected transaction.
+@param[in,out]	table	table
+@param[in,out]	trx	recovered transaction
+@param[in]	mode	LOCK_IX, or LOCK_X if the transaction wrote
+			a TRX_UNDO_EMPTY record for the table */
 void
-lock_table_ix_resurrect(
-/*====================*/
-	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx);	/*!< in/out: transaction */
+lock_table_resurrect(dict_table_t* table, trx_t* trx, lock_mode mode);
 
 /** Sets a lock on a table based on the given mode.
 @param[in]	table	table to lock
@@ -584,7 +596,7 @@ lock_print_info_all_transactions(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -593,7 +605,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -818,9 +830,16 @@ class lock_sys_t
   bool m_initialised;
 
 public:
-	MY_ALIGNED(CACHE_LINE_SIZE)
-	LockMutex	mutex;			/*!< Mutex protecting the
-						locks */
+	/** Latch protecting the locks. It is held in exclusive mode by
+	lock_mutex_enter(), except in the record lock fast path of
+	lock_rec_lock(), which holds it in shared mode together with the
+	rec_shards[] mutex of the rec_hash cell. It is constructed in
+	create() and destroyed in close(); being a union member, it is
+	not destroyed again by ~lock_sys_t(). */
+	union {
+		MY_ALIGNED(CACHE_LINE_SIZE)
+		rw_lock_t	latch;
+	};
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	hash_table_t*	prdt_hash;		/*!< hash table of the predicate
@@ -856,6 +875,18 @@ class lock_sys_t
 	bool		timeout_thread_active;	/*!< True if the timeout thread
 						is running */
 
+	/** Number of rec_shards[] */
+	static const ulint	N_REC_SHARDS = 64;
+
+	/** A mutex protecting the rec_hash cells whose number is
+	congruent to the shard number modulo N_REC_SHARDS, while
+	latch is being held in shared mode */
+	struct MY_ALIGNED(CACHE_LINE_SIZE) rec_shard_t {
+		LockMutex	mutex;
+	};
+
+	/** Record lock hash table shards */
+	rec_shard_t	rec_shards[N_REC_SHARDS];
 
   /**
     Constructor.
@@ -865,6 +896,9 @@ class lock_sys_t
   */
   lock_sys_t(): m_initialised(false) {}
 
+  /** The latch was already destroyed in close(). */
+  ~lock_sys_t() {}
+
 
   bool is_initialised() { return m_initialised; }
 
@@ -887,6 +921,44 @@ class lock_sys_t
 
   /** Closes the lock system at database shutdown. */
   void close();
+
+  /** Acquire latch in exclusive mode, counting the waits.
+  @param[in]	file	file name of the caller
+  @param[in]	line	line number of the caller */
+  void x_lock(const char* file, unsigned line);
+
+  /** Try to acquire latch in exclusive mode.
+  @param[in]	file	file name of the caller
+  @param[in]	line	line number of the caller
+  @return whether latch was acquired */
+  bool x_lock_nowait(const char* file, unsigned line)
+  {
+    return rw_lock_x_lock_func_nowait_inline(&latch, file, line);
+  }
+
+  /** Acquire latch in shared mode, and the shard of a rec_hash cell.
+  @param[in]	cell	rec_hash cell, buf_block_get_lock_hash_val()
+  @return the acquired shard */
+  rec_shard_t& rec_shard_enter(ulint cell);
+
+  /** Release the shard and latch acquired by rec_shard_enter().
+  @param[in,out]	shard	the shard */
+  void rec_shard_exit(rec_shard_t& shard)
+  {
+    mutex_exit(&shard.mutex);
+    rw_lock_s_unlock(&latch);
+  }
+
+#ifdef UNIV_DEBUG
+  /** @return whether latch is held in shared mode together with
+  the shard of a rec_hash cell
+  @param[in]	cell	rec_hash cell */
+  bool rec_shard_own(ulint cell) const
+  {
+    return rw_lock_own_flagged(&latch, RW_LOCK_FLAG_S)
+      && rec_shards[cell % N_REC_SHARDS].mutex.is_owned();
+  }
+#endif /* UNIV_DEBUG */
 };
 
 /*********************************************************************//**
@@ -1002,21 +1074,28 @@ lock_rec_free_all_from_discard_page(
 /** The lock system */
 extern lock_sys_t lock_sys;
 
-/** Test if lock_sys.mutex can be acquired without waiting. */
+/** Test if lock_sys.latch can be acquired in exclusive mode
+without waiting.
+@return 0 if the latch was acquired */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys.mutex.trylock(__FILE__, __LINE__))
+	(!lock_sys.x_lock_nowait(__FILE__, __LINE__))
+
+/** Test if lock_sys.latch is held in exclusive mode. */
+#define lock_mutex_own() rw_lock_own(&lock_sys.latch, RW_LOCK_X)
 
-/** Test if lock_sys.mutex is owned. */
-#define lock_mutex_own() (lock_sys.mutex.is_owned())
+/** Test if lock_sys.latch is held in exclusive mode, or in shared mode
+together with the shard of a rec_hash cell. */
+#define lock_rec_mutex_own(cell)		\
+	(lock_mutex_own() || lock_sys.rec_shard_own(cell))
 
-/** Acquire the lock_sys.mutex. */
+/** Acquire lock_sys.latch in exclusive mode. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys.mutex);		\
+	lock_sys.x_lock(__FILE__, __LINE__);	\
 } while (0)
 
-/** Release the lock_sys.mutex. */
+/** Release lock_sys.latch from exclusive mode. */
 #define lock_mutex_exit() do {			\
-	lock_sys.mutex.exit();			\
+	rw_lock_x_unlock(&lock_sys.latch);	\
 } while (0)
 
 /** Test if lock_sys.wait_mutex is owned. */
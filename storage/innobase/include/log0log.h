@@ -106,6 +106,27 @@ log_write_low(
 /*==========*/
 	const byte*	str,		/*!< in: string */
 	ulint		str_len);	/*!< in: string length */
+
+/** Reserve space for a string in the log buffer and initialize the
+headers of the log blocks that it spans, but do not copy the string.
+The caller must hold the log mutex, and must copy the string with
+log_copy_reserved() and invoke log_release_reserved() after releasing it.
+@param[in]	len	string length
+@return start of the reserved area in log_sys.buf */
+byte* log_reserve_for_copy(ulint len);
+
+/** Copy (a part of) a string to an area of the log buffer that was
+reserved by log_reserve_for_copy(). This does not acquire the log mutex.
+@param[in]	dst	start of the area, or the return value of
+			the previous log_copy_reserved() call
+@param[in]	str	string
+@param[in]	len	string length
+@return end of the copied area */
+byte* log_copy_reserved(byte* dst, const byte* str, ulint len);
+
+/** Declare that a log_reserve_for_copy() area has been completely copied
+and may be written to the log file. */
+inline void log_release_reserved();
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -509,6 +530,13 @@ struct log_t{
 	ulong		buf_free;	/*!< first free offset within the log
 					buffer in use */
 
+	/** number of mini-transactions that have reserved an area of buf
+	in log_reserve_for_copy() but not yet copied their records to it;
+	incremented while holding mutex. buf must not be written to the
+	log file nor switched or resized before this has dropped to 0. */
+	MY_ALIGNED(CACHE_LINE_SIZE)
+	std::atomic<ulint>	n_pending_copies;
+
 	MY_ALIGNED(CACHE_LINE_SIZE)
 	LogSysMutex	mutex;		/*!< mutex protecting the log */
 	MY_ALIGNED(CACHE_LINE_SIZE)
@@ -590,8 +618,19 @@ struct log_t{
     @param[in,out]	start_lsn	in: read area start,
 					out: the last read valid lsn
     @param[in]		end_lsn		read area end
+    @param[in]		prefetched	whether the segment was already read
+					to log_sys.buf, and only needs to be
+					validated
     @return	whether no invalid blocks (e.g checksum mismatch) were found */
-    bool read_log_seg(lsn_t* start_lsn, lsn_t end_lsn);
+    bool read_log_seg(lsn_t* start_lsn, lsn_t end_lsn,
+                      bool prefetched = false);
+
+    /** Read a part of the log files, without validating it.
+    This does not require log_sys.mutex.
+    @param[in]	offset	calc_lsn_offset() of the start of the area
+    @param[in]	len	length of the area, in bytes
+    @param[out]	buf	buffer to read to */
+    void read(lsn_t offset, ulint len, byte* buf) const;
 
     /** Initialize the redo log buffer.
     @param[in]	n_files		number of files */
@@ -735,6 +774,11 @@ struct log_t{
       : OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_CHECKSUM;
   }
 
+  /** Wait until all areas reserved by log_reserve_for_copy() have been
+  copied. The caller must hold mutex, so that no new areas can be
+  reserved while waiting. */
+  void wait_for_pending_copies();
+
   /** Initialise the redo log subsystem. */
   void create();
 
@@ -745,6 +789,15 @@ struct log_t{
 /** Redo log system */
 extern log_t	log_sys;
 
+/** Declare that a log_reserve_for_copy() area has been completely copied
+and may be written to the log file. */
+inline void log_release_reserved()
+{
+  ut_d(ulint n=) log_sys.n_pending_copies.fetch_sub(1,
+                                                    std::memory_order_release);
+  ut_ad(n);
+}
+
 /** Calculate the offset of a log sequence number.
 @param[in]     lsn     log sequence number
 @return offset within the log */
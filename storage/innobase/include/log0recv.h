@@ -272,6 +272,49 @@ struct recv_sys_t{
 	/** Lastly added LSN to the hash table of log records. */
 	lsn_t		last_stored_lsn;
 
+	/** number of threads applying the current batch
+	(innodb_recovery_apply_threads); protected by mutex */
+	ulint		n_apply_threads;
+	/** number of recv_apply_thread() that have not completed
+	the current batch; protected by mutex */
+	ulint		n_apply_active;
+	/** signalled when n_apply_active reaches 0 */
+	os_event_t	apply_end;
+
+	/** Read-ahead of the next redo log segment by
+	recv_read_ahead_thread() while recv_group_scan_log_recs()
+	is parsing the current one */
+	struct read_ahead_t {
+		/** signalled when a read is requested */
+		os_event_t	request;
+		/** signalled when the requested read has completed */
+		os_event_t	done;
+		/** whether a requested read has not been waited for */
+		bool		pending;
+		/** start of the requested segment */
+		lsn_t		start_lsn;
+		/** end of the requested segment */
+		lsn_t		end_lsn;
+		/** log_sys.log.calc_lsn_offset(start_lsn) */
+		lsn_t		offset;
+		/** the buffer to read to, or NULL to make
+		recv_read_ahead_thread() exit */
+		byte*		buf;
+	} read_ahead;
+
+	/** Cumulative time spent in the phases of redo log recovery,
+	in microseconds, for reporting in the error log */
+	struct phase_times {
+		/** reading the redo log files */
+		uintmax_t	scan;
+		/** parsing and hashing the redo log records */
+		uintmax_t	parse;
+		/** applying the records to the pages */
+		uintmax_t	apply;
+		/** flushing the pages between batches */
+		uintmax_t	flush;
+	} time;
+
 	/** Determine whether redo log recovery progress should be reported.
 	@param[in]	time	the current time
 	@return	whether progress should be reported
@@ -1444,10 +1444,30 @@ be other, synchronous, pending writes. */
 void
 os_aio_wait_until_no_pending_writes();
 
-/** Wakes up simulated aio i/o-handler threads if they have something to do. */
+/** Wakes up simulated aio i/o-handler threads if they have something to do.
+With io_uring, submits the requests that were posted with
+IORequest::DO_NOT_WAKE. */
 void
 os_aio_simulated_wake_handler_threads();
 
+#ifdef LINUX_IO_URING
+/** A memory area for fixed-buffer io_uring reads and writes */
+struct os_aio_buffer_t {
+	/** start of the area */
+	const byte*	mem;
+	/** size of the area in bytes */
+	ulint		size;
+};
+
+/** Register memory areas for fixed-buffer io_uring reads and writes,
+replacing any earlier registration. This is a no-op unless
+innodb_use_io_uring is in effect.
+@param[in]	buffers	memory areas
+@param[in]	n	number of elements in buffers; 0 to unregister */
+void
+os_aio_register_buffers(const os_aio_buffer_t* buffers, ulint n);
+#endif /* LINUX_IO_URING */
+
 #ifdef _WIN32
 /** This function can be called if one wants to post a batch of reads and
 prefers an i/o-handler thread to handle them all at once later. You must
@@ -177,10 +177,8 @@ class ReadView
   /**
     Creates a snapshot where exactly the transactions serialized before this
     point in time are seen in the view.
-
-    @param[in,out] trx transaction
   */
-  inline void snapshot(trx_t *trx);
+  inline void snapshot();
 
 
   /**
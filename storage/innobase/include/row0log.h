@@ -220,6 +220,16 @@ row_log_table_apply(
 	dict_table_t*		new_table)
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Determine how much of the log of a table that is being rebuilt
+has not been applied yet. The log is not latched, so the result is
+approximate.
+@param[in]	index	clustered index of the table being rebuilt
+@return number of bytes to apply */
+ulonglong
+row_log_table_backlog(
+	const dict_index_t*	index)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /******************************************************//**
 Get the latest transaction ID that has invoked row_log_online_op()
 during online creation.
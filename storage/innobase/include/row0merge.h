@@ -491,4 +491,51 @@ row_merge_read_rec(
 	row_merge_block_t*	crypt_block, /*!< in: crypt buf or NULL */
 	ulint			space)	   /*!< in: space id */
 	MY_ATTRIBUTE((warn_unused_result));
+
+/** Start a bulk insert into an empty table, if the table is eligible.
+The table will be locked exclusively, and a single TRX_UNDO_EMPTY undo
+log record will be written, so that a rollback can empty the table.
+@param[in,out]	trx		transaction
+@param[in,out]	table		table that is being inserted into
+@param[in]	mysql_table	MySQL table, for reporting duplicate keys
+@param[out]	bulk		the bulk insert, or NULL if the rows must be
+				inserted one by one
+@return error code */
+dberr_t
+row_merge_bulk_start(
+	trx_t*			trx,
+	dict_table_t*		table,
+	struct TABLE*		mysql_table,
+	row_merge_bulk_t**	bulk)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
+/** Buffer a row for a bulk insert.
+@param[in,out]	bulk	bulk insert
+@param[in]	row	row to insert, including DB_TRX_ID and DB_ROLL_PTR
+@param[in,out]	trx	transaction
+@return error code
+@retval	DB_OVERFLOW	if the row is too long to be buffered;
+			the caller must finish the bulk insert and insert
+			the row directly into the table */
+dberr_t
+row_merge_bulk_add(
+	row_merge_bulk_t*	bulk,
+	const dtuple_t*		row,
+	trx_t*			trx)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
+/** Sort the buffered rows and load them into the indexes of the table,
+and free the bulk insert.
+@param[in,out]	bulk	bulk insert
+@param[in,out]	trx	transaction
+@return error code */
+dberr_t
+row_merge_bulk_finish(row_merge_bulk_t* bulk, trx_t* trx)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
+/** Free a bulk insert without loading the buffered rows.
+@param[in,out]	bulk	bulk insert */
+void
+row_merge_bulk_free(row_merge_bulk_t* bulk)
+	MY_ATTRIBUTE((nonnull));
 #endif /* row0merge.h */
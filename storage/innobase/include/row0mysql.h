@@ -43,6 +43,7 @@ Created 9/17/2000 Heikki Tuuri
 extern ibool row_rollback_on_timeout;
 
 struct row_prebuilt_t;
+struct row_merge_bulk_t;
 class ha_innobase;
 
 /*******************************************************************//**
@@ -562,7 +563,13 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Initial number of rows in fetch_cache; the cache size is doubled each
+time a full batch was fetched from the same cursor */
 #define MYSQL_FETCH_CACHE_SIZE		8
+/* Maximum number of rows in fetch_cache */
+#define MYSQL_FETCH_CACHE_MAX_SIZE	1024
+/* Maximum amount of memory reserved for rows in fetch_cache */
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(128 << 10)
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -632,6 +639,10 @@ struct row_prebuilt_t {
 					(VARCHAR can be off-page too) */
 	unsigned	versioned_write:1;/*!< whether this is
 					a versioned write */
+	unsigned	bulk_insert_pending:1;/*!< whether the next
+					row_insert_for_mysql() should try
+					to start a bulk insert into an
+					empty table */
 	mysql_row_templ_t* mysql_template;/*!< template used to transform
 					rows fast between MySQL and Innobase
 					formats; memory for this template
@@ -642,6 +653,8 @@ struct row_prebuilt_t {
 	ins_node_t*	ins_node;	/*!< Innobase SQL insert node
 					used to perform inserts
 					to the table */
+	row_merge_bulk_t* bulk_insert;	/*!< buffered bulk insert into
+					an empty table, or NULL */
 	byte*		ins_upd_rec_buff;/*!< buffer for storing data converted
 					to the Innobase format from the MySQL
 					format */
@@ -737,16 +750,22 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte**		fetch_cache;
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
 					batch; we reserve mysql_row_len
 					bytes for each such row; these
 					pointers point 4 bytes past the
-					allocated mem buf start, because
+					start of each row buffer, because
 					there is a 4 byte magic number at the
 					start and at the end */
+	ulint		fetch_cache_size;/*!< number of allocated rows
+					in fetch_cache */
+	ulint		fetch_cache_limit;/*!< number of rows to fetch
+					in the current batch; grows from
+					MYSQL_FETCH_CACHE_SIZE as long as
+					the batches fill up */
 	bool		keep_other_fields_on_keyread; /*!< when using fetch
 					cache with HA_EXTRA_KEYREAD, don't
 					overwrite other fields in mysql row
@@ -110,6 +110,10 @@ row_sel_copy_cached_fields_for_mysql(
 	const byte*	cached_rec,
 	row_prebuilt_t*	prebuilt);
 
+/** Free the prefetch cache.
+@param[in,out]	prebuilt	prebuilt struct */
+void row_sel_prefetch_cache_free(row_prebuilt_t* prebuilt);
+
 /****************************************************************//**
 Converts a key value stored in MySQL format to an Innobase dtuple. The last
 field of the key value may be just a prefix of a fixed length field: hence
@@ -150,6 +150,8 @@ enum monitor_id_t {
 	MONITOR_TABLELOCK_CREATED,
 	MONITOR_TABLELOCK_REMOVED,
 	MONITOR_NUM_TABLELOCK,
+	MONITOR_LOCK_SYS_LATCH_WAITS,
+	MONITOR_LOCK_REC_SHARD_WAITS,
 	MONITOR_OVLD_ROW_LOCK_CURRENT_WAIT,
 	MONITOR_OVLD_LOCK_WAIT_TIME,
 	MONITOR_OVLD_LOCK_MAX_WAIT_TIME,
@@ -205,6 +207,9 @@ enum monitor_id_t {
 	MONITOR_FLUSH_ADAPTIVE_AVG_PASS,
 	MONITOR_LRU_BATCH_FLUSH_AVG_PASS,
 	MONITOR_FLUSH_AVG_PASS,
+	MONITOR_FLUSH_INSTANCE_STALLS,
+	MONITOR_FLUSH_INSTANCE_MAX_RATE,
+	MONITOR_FLUSH_INSTANCE_MIN_RATE,
 
 	MONITOR_LRU_GET_FREE_LOOPS,
 	MONITOR_LRU_GET_FREE_WAITS,
@@ -243,6 +248,10 @@ enum monitor_id_t {
 	MONITOR_LRU_UNZIP_SEARCH_SCANNED,
 	MONITOR_LRU_UNZIP_SEARCH_SCANNED_NUM_CALL,
 	MONITOR_LRU_UNZIP_SEARCH_SCANNED_PER_CALL,
+	MONITOR_LRU_GHOST_ADDED,
+	MONITOR_LRU_GHOST_HITS,
+	MONITOR_LRU_UNZIP_REFETCH,
+	MONITOR_LRU_UNZIP_KEPT,
 
 	/* Buffer Page I/O specific counters. */
 	MONITOR_MODULE_BUF_PAGE,
@@ -314,6 +323,7 @@ enum monitor_id_t {
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
+	MONITOR_PURGE_BATCH_SIZE,
 
 	/* Recovery related counters */
 	MONITOR_MODULE_RECOVERY,
@@ -358,6 +368,11 @@ enum monitor_id_t {
 	MONITOR_INDEX_REORG_ATTEMPTS,
 	MONITOR_INDEX_REORG_SUCCESSFUL,
 	MONITOR_INDEX_DISCARD,
+	MONITOR_INDEX_RANGE_CACHE_HIT,
+	MONITOR_INDEX_RANGE_CACHE_DIVE,
+	MONITOR_INDEX_RANGE_CACHE_REFRESH,
+	MONITOR_INDEX_RANGE_CACHE_CHECK,
+	MONITOR_INDEX_RANGE_CACHE_CHECK_OFF,
 
 #ifdef BTR_CUR_HASH_ADAPT
 	/* Adaptive Hash Index related counters */
@@ -372,6 +387,8 @@ enum monitor_id_t {
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVED,
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVE_NOT_FOUND,
 	MONITOR_ADAPTIVE_HASH_ROW_UPDATED,
+	MONITOR_ADAPTIVE_HASH_AUTO_DISABLED,
+	MONITOR_ADAPTIVE_HASH_AUTO_ENABLED,
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	/* Tablespace related counters */
@@ -388,6 +405,9 @@ enum monitor_id_t {
 	MONITOR_OVLD_IBUF_MERGE_DISCARD_PURGE,
 	MONITOR_OVLD_IBUF_MERGES,
 	MONITOR_OVLD_IBUF_SIZE,
+	MONITOR_OVLD_IBUF_MERGE_PENDING,
+	MONITOR_IBUF_MERGE_THREAD_PAGES,
+	MONITOR_IBUF_CONTRACT_ON_INSERT,
 
 	/* Counters for server operations */
 	MONITOR_MODULE_SERVER,
@@ -436,6 +456,7 @@ enum monitor_id_t {
 	MONITOR_PENDING_ALTER_TABLE,
 	MONITOR_ALTER_TABLE_SORT_FILES,
 	MONITOR_ALTER_TABLE_LOG_FILES,
+	MONITOR_ONLINE_LOG_CATCHUP,
 
 	MONITOR_MODULE_ICP,
 	MONITOR_ICP_ATTEMPTS,
@@ -262,12 +262,17 @@ extern ibool	srv_locks_unsafe_for_binlog;
 extern ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
+/** Size of the online table rebuild log above which the log is applied
+while ALTER TABLE is waiting for the exclusive table lock, or 0 */
+extern unsigned long long	srv_online_catchup_size;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
+/** innodb_use_io_uring */
+extern my_bool	srv_use_io_uring;
 extern my_bool	srv_numa_interleave;
 
 /* Use atomic writes i.e disable doublewrite buffer */
@@ -393,6 +398,8 @@ extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
 extern ulong	srv_n_read_io_threads;
 extern ulong	srv_n_write_io_threads;
+/** innodb_recovery_apply_threads */
+extern ulong	srv_n_recv_apply_threads;
 
 /* Defragmentation, Origianlly facebook default value is 100, but it's too high */
 #define SRV_DEFRAGMENT_FREQUENCY_DEFAULT 40
@@ -459,6 +466,9 @@ extern my_bool			srv_stats_auto_recalc;
 extern my_bool			srv_stats_include_delete_marked;
 extern unsigned long long	srv_stats_modified_counter;
 extern my_bool			srv_stats_sample_traditional;
+extern ulong			srv_stats_threads;
+extern ulong			srv_stats_incremental_recalc;
+extern ulong			srv_records_in_range_cache;
 
 extern my_bool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
@@ -145,9 +145,13 @@ V
 lock_sys_wait_mutex			Mutex protecting lock timeout data
 |
 V
-lock_sys_mutex				Mutex protecting lock_sys_t
+lock_sys.latch				Latch protecting lock_sys_t
 |
 V
+lock_sys.rec_shards[].mutex		Mutex protecting a part of
+|					lock_sys.rec_hash while lock_sys.latch
+|					is held in shared mode
+V
 trx_sys.mutex				Mutex protecting trx_sys_t
 |
 V
@@ -221,8 +225,10 @@ enum latch_level_t {
 	SYNC_REC_LOCK,
 	SYNC_THREADS,
 	SYNC_TRX,
+	SYNC_RW_TRX_HASH_IDS,
 	SYNC_RW_TRX_HASH_ELEMENT,
 	SYNC_TRX_SYS,
+	SYNC_LOCK_REC_SHARD,
 	SYNC_LOCK_SYS,
 	SYNC_LOCK_WAIT_SYS,
 
@@ -330,6 +336,7 @@ enum latch_id_t {
 	LATCH_ID_TRX,
 	LATCH_ID_LOCK_SYS,
 	LATCH_ID_LOCK_SYS_WAIT,
+	LATCH_ID_LOCK_REC_SHARD,
 	LATCH_ID_TRX_SYS,
 	LATCH_ID_SRV_SYS,
 	LATCH_ID_SRV_SYS_TASKS,
@@ -369,7 +376,9 @@ enum latch_id_t {
 	LATCH_ID_FIL_CRYPT_STAT_MUTEX,
 	LATCH_ID_FIL_CRYPT_DATA_MUTEX,
 	LATCH_ID_FIL_CRYPT_THREADS_MUTEX,
+	LATCH_ID_BUF_FLUSH_COMPRESS,
 	LATCH_ID_RW_TRX_HASH_ELEMENT,
+	LATCH_ID_RW_TRX_HASH_IDS,
 	LATCH_ID_TEST_MUTEX,
 	LATCH_ID_MAX = LATCH_ID_TEST_MUTEX
 };
@@ -61,8 +61,15 @@ trx_purge(
 /*======*/
 	ulint	n_purge_threads,	/*!< in: number of purge tasks to
 					submit to task queue. */
+	ulint	batch_size,		/*!< in: number of undo log pages
+					to handle in the batch */
 	bool	truncate);		/*!< in: truncate history if true */
 
+/** Run a purge task and account for it in purge_sys.thread_stats.
+@param[in,out]	thr	purge query thread
+@param[in]	id	purge thread: 0=coordinator, 1.. = worker */
+void trx_purge_run_task(que_thr_t* thr, ulint id);
+
 /** Rollback segements from a given transaction with trx-no
 scheduled for purge. */
 class TrxUndoRsegs {
@@ -161,6 +168,24 @@ class purge_sys_t
 	and srv_worker_thread by std::atomic. */
 	std::atomic<ulint>	n_tasks;
 
+	/** Maximum number of purge threads (innodb_purge_threads) */
+	static const ulint	MAX_THREADS = 32;
+
+	/** Statistics of a purge thread, only updated by the thread */
+	struct MY_ALIGNED(CACHE_LINE_SIZE) thread_stats_t
+	{
+		/** number of undo log records processed */
+		ulint		n_recs;
+		/** microseconds spent processing undo log records */
+		ulonglong	busy_us;
+		/** microseconds spent waiting for work */
+		ulonglong	idle_us;
+	};
+
+	/** Statistics of the purge threads, indexed by 0 for
+	srv_purge_coordinator_thread and by 1.. for srv_worker_thread */
+	thread_stats_t	thread_stats[MAX_THREADS];
+
 	/** Iterator to the undo log records of committed transactions */
 	struct iterator
 	{
@@ -166,6 +166,13 @@ trx_undo_rec_get_partial_row(
 @return	DB_SUCCESS or error code */
 dberr_t trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/** Report that a bulk insert into an empty table is starting.
+Rollback of the TRX_UNDO_EMPTY record will empty the table.
+@param[in,out]	trx	transaction
+@param[in]	table	empty table, locked exclusively by trx
+@return	DB_SUCCESS or error code */
+dberr_t trx_undo_report_empty(trx_t* trx, dict_table_t* table)
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
 /***********************************************************************//**
 Writes information to an undo log about an insert, update, or a delete marking
 of a clustered index record. This information is used in a rollback of the
@@ -317,6 +324,13 @@ record */
 					fields of the record can change */
 #define	TRX_UNDO_DEL_MARK_REC	14	/* delete marking of a record; fields
 					do not change */
+/** Bulk insert into an empty table (innodb_bulk_insert=ON); rollback
+empties the table. A server that does not know this record type would
+parse it as an update undo log record, both in the rollback of a
+recovered transaction and in purge. Before starting an older server on
+the data files, the server must be shut down with innodb_fast_shutdown=0
+and no transaction may be in the XA PREPARE state. */
+#define	TRX_UNDO_EMPTY		15
 #define	TRX_UNDO_CMPL_INFO_MULT	16U	/* compilation info is multiplied by
 					this and ORed to the type above */
 #define	TRX_UNDO_UPD_EXTERN	128U	/* This bit can be ORed to type_cmpl
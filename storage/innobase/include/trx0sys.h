@@ -384,6 +384,80 @@ class rw_trx_hash_t
   LF_HASH hash;
 
 
+  /** Number of id_shards[]; a power of 2, for snapshot() */
+  static const ulint N_ID_SHARDS= 16;
+
+
+  /** Identifier and serialisation number of a registered transaction */
+  struct id_entry_t
+  {
+    trx_id_t id;
+    /** serialisation number, TRX_ID_MAX if not assigned, or ERASED */
+    trx_id_t no;
+  };
+
+
+  /** id_entry_t::no of a transaction that was removed from the hash */
+  static const trx_id_t ERASED= 0;
+
+
+  /**
+    A partition of the registered transactions, holding those whose identifier
+    is congruent to the shard number modulo N_ID_SHARDS.
+
+    Taking an MVCC snapshot by iterating the lock-free hash visits every list
+    node. The same information is kept in these small arrays, sorted by
+    identifier, so that a snapshot is a sequential copy followed by a merge
+    of the sorted shards. Identifiers are allocated in ascending order, so
+    insertion is normally an append. Removal only marks the entry as ERASED,
+    so that no elements are moved until half of the array has been erased.
+  */
+  struct MY_ALIGNED(CACHE_LINE_SIZE) id_shard_t
+  {
+    /** Protects entries and n_erased */
+    ib_mutex_t mutex;
+    /** Registered and erased transactions in ascending order of id */
+    std::vector<id_entry_t, ut_allocator<id_entry_t> > entries;
+    /** Number of ERASED entries */
+    size_t n_erased;
+  };
+
+
+  /** Registered transactions, for MVCC snapshots */
+  id_shard_t id_shards[N_ID_SHARDS];
+
+
+  /** @return the shard of a transaction identifier */
+  id_shard_t &id_shard(trx_id_t id) { return id_shards[id % N_ID_SHARDS]; }
+
+
+  /** @return entry of a registered transaction in a latched shard */
+  static std::vector<id_entry_t, ut_allocator<id_entry_t> >::iterator
+  id_shard_find(id_shard_t &shard, trx_id_t id)
+  {
+    ut_ad(mutex_own(&shard.mutex));
+    std::vector<id_entry_t, ut_allocator<id_entry_t> >::iterator it=
+      std::lower_bound(shard.entries.begin(), shard.entries.end(), id,
+                       id_entry_less);
+    ut_a(it != shard.entries.end());
+    ut_a(it->id == id);
+    ut_ad(it->no != ERASED);
+    return it;
+  }
+
+
+  static bool id_entry_less(const id_entry_t &entry, trx_id_t id)
+  {
+    return entry.id < id;
+  }
+
+
+  static bool id_entry_erased(const id_entry_t &entry)
+  {
+    return entry.no == ERASED;
+  }
+
+
   /**
     Constructor callback for lock-free allocator.
 
@@ -550,6 +624,11 @@ class rw_trx_hash_t
     hash.alloc.destructor= rw_trx_hash_destructor;
     hash.initializer=
       reinterpret_cast<lf_hash_initializer>(rw_trx_hash_initializer);
+    for (ulint i= 0; i < N_ID_SHARDS; i++)
+    {
+      mutex_create(LATCH_ID_RW_TRX_HASH_IDS, &id_shards[i].mutex);
+      id_shards[i].n_erased= 0;
+    }
   }
 
 
@@ -557,6 +636,12 @@ class rw_trx_hash_t
   {
     hash.alloc.destructor= rw_trx_hash_shutdown_destructor;
     lf_hash_destroy(&hash);
+    for (ulint i= 0; i < N_ID_SHARDS; i++)
+    {
+      id_shards[i].entries.clear();
+      id_shards[i].n_erased= 0;
+      mutex_free(&id_shards[i].mutex);
+    }
   }
 
 
@@ -588,10 +673,10 @@ class rw_trx_hash_t
     the transaction may get committed before this method returns.
 
     With do_ref_count == false the caller may dereference returned trx pointer
-    only if lock_sys.mutex was acquired before calling find().
+    only if lock_sys.latch was acquired before calling find().
 
     With do_ref_count == true caller may dereference trx even if it is not
-    holding lock_sys.mutex. Caller is responsible for calling
+    holding lock_sys.latch. Caller is responsible for calling
     trx->release_reference() when it is done playing with trx.
 
     Ideally this method should get caller rw_trx_hash_pins along with trx
@@ -673,6 +758,17 @@ class rw_trx_hash_t
     int res= lf_hash_insert(&hash, get_pins(trx),
                             reinterpret_cast<void*>(trx));
     ut_a(res == 0);
+
+    id_entry_t entry= { trx->id, TRX_ID_MAX };
+    id_shard_t &shard= id_shard(trx->id);
+    mutex_enter(&shard.mutex);
+    if (shard.entries.empty() || shard.entries.back().id < trx->id)
+      shard.entries.push_back(entry);
+    else
+      shard.entries.insert(std::lower_bound(shard.entries.begin(),
+                                            shard.entries.end(), trx->id,
+                                            id_entry_less), entry);
+    mutex_exit(&shard.mutex);
   }
 
 
@@ -687,6 +783,19 @@ class rw_trx_hash_t
   void erase(trx_t *trx)
   {
     ut_d(validate_element(trx));
+    id_shard_t &shard= id_shard(trx->id);
+    mutex_enter(&shard.mutex);
+    id_shard_find(shard, trx->id)->no= ERASED;
+    if (++shard.n_erased * 2 > shard.entries.size())
+    {
+      /* Compact the array. This is amortised over the removals. */
+      shard.entries.erase(std::remove_if(shard.entries.begin(),
+                                         shard.entries.end(),
+                                         id_entry_erased),
+                          shard.entries.end());
+      shard.n_erased= 0;
+    }
+    mutex_exit(&shard.mutex);
     mutex_enter(&trx->rw_trx_hash_element->mutex);
     trx->rw_trx_hash_element->trx= 0;
     mutex_exit(&trx->rw_trx_hash_element->mutex);
@@ -697,6 +806,86 @@ class rw_trx_hash_t
   }
 
 
+  /**
+    Publishes the serialisation number of a registered transaction to
+    MVCC snapshots.
+
+    @param trx  transaction
+  */
+
+  void set_no(trx_t *trx)
+  {
+    trx->rw_trx_hash_element->no= trx->no;
+    id_shard_t &shard= id_shard(trx->id);
+    mutex_enter(&shard.mutex);
+    id_shard_find(shard, trx->id)->no= trx->no;
+    mutex_exit(&shard.mutex);
+  }
+
+
+  /**
+    Collects the registered transactions for an MVCC snapshot.
+
+    The shards are latched one at a time. The caller must ensure that all
+    transactions with identifiers below limit have been inserted, @sa
+    trx_sys_t::snapshot_ids().
+
+    Each shard is copied as a sorted run, and the runs are merged pairwise
+    between the two halves of ids, in log2(N_ID_SHARDS) linear passes.
+
+    @param[out]    ids     identifiers of registered transactions below limit,
+                           in ascending order
+    @param[in]     limit   snapshot high water mark
+    @param[in,out] min_no  minimum of min_no and the serialisation numbers of
+                           the collected transactions
+  */
+
+  void snapshot(trx_ids_t *ids, trx_id_t limit, trx_id_t *min_no)
+  {
+    size_t run[N_ID_SHARDS + 1];
+    run[0]= 0;
+    ids->clear();
+    for (ulint i= 0; i < N_ID_SHARDS; i++)
+    {
+      id_shard_t &shard= id_shards[i];
+      mutex_enter(&shard.mutex);
+      for (std::vector<id_entry_t, ut_allocator<id_entry_t> >::const_iterator
+           it= shard.entries.begin();
+           it != shard.entries.end() && it->id < limit; it++)
+      {
+        if (id_entry_erased(*it))
+          continue;
+        ids->push_back(it->id);
+        if (it->no < *min_no)
+          *min_no= it->no;
+      }
+      mutex_exit(&shard.mutex);
+      run[i + 1]= ids->size();
+    }
+
+    const size_t n= ids->size();
+    if (n == 0)
+      return;
+
+    compile_time_assert(!(N_ID_SHARDS & (N_ID_SHARDS - 1)));
+
+    ids->resize(2 * n);
+    trx_id_t *from= &(*ids)[0];
+    trx_id_t *to= from + n;
+    for (ulint width= 1; width < N_ID_SHARDS; width*= 2)
+    {
+      for (ulint i= 0; i < N_ID_SHARDS; i+= 2 * width)
+        std::merge(from + run[i], from + run[i + width],
+                   from + run[i + width], from + run[i + 2 * width],
+                   to + run[i]);
+      std::swap(from, to);
+    }
+    if (from != &(*ids)[0])
+      std::copy(from, from + n, to);
+    ids->resize(n);
+  }
+
+
   /**
     Returns the number of elements in the hash.
 
@@ -927,7 +1116,7 @@ class trx_sys_t
   void assign_new_trx_no(trx_t *trx)
   {
     trx->no= get_new_trx_id_no_refresh();
-    trx->rw_trx_hash_element->no= trx->no;
+    rw_trx_hash.set_no(trx);
     refresh_rw_trx_hash_version();
   }
 
@@ -935,43 +1124,33 @@ class trx_sys_t
   /**
     Takes MVCC snapshot.
 
-    To reduce malloc probablility we reserver rw_trx_hash.size() + 32 elements
-    in ids.
-
     For details about get_rw_trx_hash_version() != get_max_trx_id() spin
     @sa register_rw() and @sa assign_new_trx_no().
 
     We rely on get_rw_trx_hash_version() to issue ACQUIRE memory barrier so
     that loading of m_rw_trx_hash_version happens before accessing rw_trx_hash.
 
-    To optimise snapshot creation rw_trx_hash.iterate() is being used instead
-    of rw_trx_hash.iterate_no_dups(). It means that some transaction
-    identifiers may appear multiple times in ids.
+    The identifiers are copied from the sorted partitions of rw_trx_hash
+    rather than by iterating the lock-free hash, @sa rw_trx_hash_t::snapshot().
 
-    @param[in,out] caller_trx used to get access to rw_trx_hash_pins
-    @param[out]    ids        array to store registered transaction identifiers
+    @param[out]    ids        array to store registered transaction
+                              identifiers, in ascending order
     @param[out]    max_trx_id variable to store m_max_trx_id value
     @param[out]    mix_trx_no variable to store min(trx->no) value
   */
 
-  void snapshot_ids(trx_t *caller_trx, trx_ids_t *ids, trx_id_t *max_trx_id,
+  void snapshot_ids(trx_ids_t *ids, trx_id_t *max_trx_id,
                     trx_id_t *min_trx_no)
   {
     ut_ad(!mutex_own(&mutex));
-    snapshot_ids_arg arg(ids);
+    trx_id_t id;
 
-    while ((arg.m_id= get_rw_trx_hash_version()) != get_max_trx_id())
+    while ((id= get_rw_trx_hash_version()) != get_max_trx_id())
       ut_delay(1);
-    arg.m_no= arg.m_id;
 
-    ids->clear();
-    ids->reserve(rw_trx_hash.size() + 32);
-    rw_trx_hash.iterate(caller_trx,
-                        reinterpret_cast<my_hash_walk_action>(copy_one_id),
-                        &arg);
-
-    *max_trx_id= arg.m_id;
-    *min_trx_no= arg.m_no;
+    *max_trx_id= id;
+    *min_trx_no= id;
+    rw_trx_hash.snapshot(ids, id, min_trx_no);
   }
 
 
@@ -1117,29 +1296,6 @@ class trx_sys_t
   }
 
 
-  struct snapshot_ids_arg
-  {
-    snapshot_ids_arg(trx_ids_t *ids): m_ids(ids) {}
-    trx_ids_t *m_ids;
-    trx_id_t m_id;
-    trx_id_t m_no;
-  };
-
-
-  static my_bool copy_one_id(rw_trx_hash_element_t *element,
-                             snapshot_ids_arg *arg)
-  {
-    if (element->id < arg->m_id)
-    {
-      trx_id_t no= element->no;
-      arg->m_ids->push_back(element->id);
-      if (no < arg->m_no)
-        arg->m_no= no;
-    }
-    return 0;
-  }
-
-
   /** Getter for m_rw_trx_hash_version, must issue ACQUIRE memory barrier. */
   trx_id_t get_rw_trx_hash_version()
   {
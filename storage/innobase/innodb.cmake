@@ -24,6 +24,7 @@ INCLUDE(lzo.cmake)
 INCLUDE(lzma.cmake)
 INCLUDE(bzip2.cmake)
 INCLUDE(snappy.cmake)
+INCLUDE(zstd.cmake)
 INCLUDE(numa)
 INCLUDE(TestBigEndian)
 
@@ -32,6 +33,7 @@ MYSQL_CHECK_LZO()
 MYSQL_CHECK_LZMA()
 MYSQL_CHECK_BZIP2()
 MYSQL_CHECK_SNAPPY()
+MYSQL_CHECK_ZSTD()
 MYSQL_CHECK_NUMA()
 TEST_BIG_ENDIAN(IS_BIG_ENDIAN)
 
@@ -64,6 +66,22 @@ IF(UNIX)
       ADD_DEFINITIONS(-DLINUX_NATIVE_AIO=1)
       LINK_LIBRARIES(aio)
     ENDIF()
+
+    CHECK_C_SOURCE_COMPILES("
+    #include <linux/io_uring.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    int main()
+    {
+      struct io_uring_params p;
+      struct __kernel_timespec ts = { 0, 0 };
+      return syscall(__NR_io_uring_setup, 0, &p) + IORING_OP_TIMEOUT
+        + (int) ts.tv_sec;
+    }" HAVE_LINUX_IO_URING)
+
+    IF(HAVE_LINUX_IO_URING)
+      ADD_DEFINITIONS(-DLINUX_IO_URING=1)
+    ENDIF()
     IF(HAVE_LIBNUMA)
       LINK_LIBRARIES(numa)
     ENDIF()
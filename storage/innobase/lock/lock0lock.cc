@@ -42,8 +42,11 @@ Created 5/7/1996 Heikki Tuuri
 #include "row0mysql.h"
 #include "row0vers.h"
 #include "pars0pars.h"
+#include "sync0sync.h"
 
 #include <set>
+#include <vector>
+#include <algorithm>
 
 #ifdef WITH_WSREP
 #include <mysql/service_wsrep.h>
@@ -55,6 +58,9 @@ ulong innodb_lock_schedule_algorithm;
 /** The value of innodb_deadlock_detect */
 my_bool	innobase_deadlock_detect;
 
+/** The value of innodb_deadlock_detect_interval */
+ulong	innodb_deadlock_detect_interval;
+
 /*********************************************************************//**
 Checks if a waiting record lock request still has to wait in a queue.
 @return lock that is causing the wait */
@@ -86,6 +92,32 @@ static
 void
 lock_rec_print(FILE* file, const lock_t* lock);
 
+/** A waiting transaction in a snapshot of the waits-for graph */
+struct lock_wait_node_t {
+	/** the waiting transaction */
+	trx_t*		trx;
+	/** the lock that the transaction was waiting for */
+	const lock_t*	wait_lock;
+	/** position of the first edge in lock_wait_edges_t */
+	ulint		first_edge;
+	/** number of waiting transactions that this one waits for */
+	ulint		n_edges;
+	/** whether the node was removed from the graph */
+	bool		removed;
+
+	/** Order the nodes by transaction. */
+	bool operator<(const lock_wait_node_t& other) const
+	{
+		return(trx < other.trx);
+	}
+};
+
+/** Snapshot of the waiting transactions */
+typedef std::vector<lock_wait_node_t, ut_allocator<lock_wait_node_t> >
+	lock_wait_nodes_t;
+/** Edges of the waits-for graph, as positions in lock_wait_nodes_t */
+typedef std::vector<ulint, ut_allocator<ulint> >	lock_wait_edges_t;
+
 /** Deadlock checker. */
 class DeadlockChecker {
 public:
@@ -105,7 +137,28 @@ class DeadlockChecker {
 		const lock_t*	lock,
 		trx_t*		trx);
 
+	/** Look for deadlocks among the waiting transactions and roll
+	back a victim of each. This is used instead of check_and_resolve()
+	when innodb_deadlock_detect_interval is set. The waits are copied
+	in batches, and lock_sys.latch is not held while the copy is
+	being searched. */
+	static void check_waits();
+
 private:
+	/** Copy the waits-for graph.
+	@param[out]	nodes	waiting transactions
+	@param[out]	edges	edges between the nodes */
+	static void snapshot(lock_wait_nodes_t& nodes,
+			     lock_wait_edges_t& edges);
+
+	/** Resolve a deadlock that was found in a copy of the
+	waits-for graph, if it still exists.
+	@param[in,out]	nodes	waiting transactions
+	@param[in]	cycle	positions of the deadlocked transactions
+	in nodes, each one waiting for the next one */
+	static void resolve(lock_wait_nodes_t& nodes,
+			    const lock_wait_edges_t& cycle);
+
 	/** Do a shallow copy. Default destructor OK.
 	@param trx the start transaction (start node)
 	@param wait_lock lock that a transaction wants
@@ -256,7 +309,7 @@ class DeadlockChecker {
 		ulint		m_heap_no;	/*!< heap number if rec lock */
 	};
 
-	/** Used in deadlock tracking. Protected by lock_sys.mutex. */
+	/** Used in deadlock tracking. Protected by lock_sys.latch. */
 	static ib_uint64_t	s_lock_mark_counter;
 
 	/** Calculation steps thus far. It is the count of the nodes visited. */
@@ -462,7 +515,11 @@ void lock_sys_t::create(ulint n_cells)
 		(ut_zalloc_nokey(srv_max_n_threads * sizeof *waiting_threads));
 	last_slot = waiting_threads;
 
-	mutex_create(LATCH_ID_LOCK_SYS, &mutex);
+	rw_lock_create(lock_sys_latch_key, &latch, SYNC_LOCK_SYS);
+
+	for (ulint i = 0; i < N_REC_SHARDS; i++) {
+		mutex_create(LATCH_ID_LOCK_REC_SHARD, &rec_shards[i].mutex);
+	}
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &wait_mutex);
 
@@ -500,7 +557,7 @@ void lock_sys_t::resize(ulint n_cells)
 {
 	ut_ad(this == &lock_sys);
 
-	mutex_enter(&mutex);
+	lock_mutex_enter();
 
 	hash_table_t* old_hash = rec_hash;
 	rec_hash = hash_create(n_cells);
@@ -545,10 +602,38 @@ void lock_sys_t::resize(ulint n_cells)
 		buf_pool_mutex_exit(buf_pool);
 	}
 
-	mutex_exit(&mutex);
+	lock_mutex_exit();
 }
 
 
+/** Acquire latch in exclusive mode, counting the waits.
+@param[in]	file	file name of the caller
+@param[in]	line	line number of the caller */
+void lock_sys_t::x_lock(const char* file, unsigned line)
+{
+	if (!x_lock_nowait(file, line)) {
+		MONITOR_ATOMIC_INC(MONITOR_LOCK_SYS_LATCH_WAITS);
+		rw_lock_x_lock_inline(&latch, 0, file, line);
+	}
+}
+
+/** Acquire latch in shared mode, and the shard of a rec_hash cell.
+@param[in]	cell	rec_hash cell, buf_block_get_lock_hash_val()
+@return the acquired shard */
+lock_sys_t::rec_shard_t& lock_sys_t::rec_shard_enter(ulint cell)
+{
+	rw_lock_s_lock(&latch);
+
+	rec_shard_t& shard = rec_shards[cell % N_REC_SHARDS];
+
+	if (shard.mutex.trylock(__FILE__, __LINE__)) {
+		MONITOR_ATOMIC_INC(MONITOR_LOCK_REC_SHARD_WAITS);
+		mutex_enter(&shard.mutex);
+	}
+
+	return shard;
+}
+
 /** Closes the lock system at database shutdown. */
 void lock_sys_t::close()
 {
@@ -567,7 +652,12 @@ void lock_sys_t::close()
 
 	os_event_destroy(timeout_event);
 
-	mutex_destroy(&mutex);
+	rw_lock_free(&latch);
+
+	for (ulint i = 0; i < N_REC_SHARDS; i++) {
+		mutex_destroy(&rec_shards[i].mutex);
+	}
+
 	mutex_destroy(&wait_mutex);
 
 	for (ulint i = srv_max_n_threads; i--; ) {
@@ -1247,7 +1337,7 @@ lock_sec_rec_some_has_impl(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -1260,7 +1350,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys.mutex. */
+The caller must be holding lock_sys.latch. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -1343,7 +1433,7 @@ lock_rec_create_low(
 	ulint		n_bits;
 	ulint		n_bytes;
 
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_mutex_own(lock_rec_hash(space, page_no)));
 	ut_ad(holds_trx_mutex == trx_mutex_own(trx));
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
@@ -1505,8 +1595,8 @@ lock_rec_create_low(
 	if (!holds_trx_mutex) {
 		trx_mutex_exit(trx);
 	}
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
 	return lock;
 }
@@ -1946,13 +2036,72 @@ lock_rec_lock(
         (mode & LOCK_TYPE_MASK) == 0);
   ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
   DBUG_EXECUTE_IF("innodb_report_deadlock", return DB_DEADLOCK;);
-
-  lock_mutex_enter();
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_S ||
         lock_table_has(trx, index->table, LOCK_IS));
   ut_ad((LOCK_MODE_MASK & mode) != LOCK_X ||
          lock_table_has(trx, index->table, LOCK_IX));
 
+  {
+    /*
+      Fast path for the most common cases: there are no locks on the
+      page, or the only lock is a similar one by this transaction.
+      Only the rec_hash cell of the page and the own transaction are
+      accessed, so it suffices to hold lock_sys.latch in shared mode
+      together with the shard of the cell.
+    */
+    lock_sys_t::rec_shard_t &shard=
+      lock_sys.rec_shard_enter(buf_block_get_lock_hash_val(block));
+    lock_t *lock= lock_rec_get_first_on_page(lock_sys.rec_hash, block);
+
+    if (!lock)
+    {
+      /* Note that we don't own the trx mutex. */
+      if (!impl)
+        lock_rec_create(
+#ifdef WITH_WSREP
+          NULL, NULL,
+#endif
+          mode, block, heap_no, index, trx, false);
+
+      lock_sys.rec_shard_exit(shard);
+      MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+      return DB_SUCCESS_LOCKED_REC;
+    }
+
+    if (!lock_rec_get_next_on_page(lock) &&
+        lock->trx == trx &&
+        lock->type_mode == (ulint(mode) | LOCK_REC) &&
+        lock_rec_get_n_bits(lock) > heap_no)
+    {
+      /*
+        If the nth bit of the record lock is already set then we do not set
+        a new lock bit, otherwise we do set
+      */
+      if (!impl)
+      {
+        trx_mutex_enter(trx);
+        if (!lock_rec_get_nth_bit(lock, heap_no))
+        {
+          lock_rec_set_nth_bit(lock, heap_no);
+          err= DB_SUCCESS_LOCKED_REC;
+        }
+        trx_mutex_exit(trx);
+      }
+
+      lock_sys.rec_shard_exit(shard);
+      MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+      return err;
+    }
+
+    lock_sys.rec_shard_exit(shard);
+  }
+
+  /* The page has locks of other transactions. Checking for conflicts
+  and waiting may involve deadlock detection, which needs exclusive
+  access to all locks. The state may have changed after we released
+  the shard, so check everything again. */
+  lock_mutex_enter();
+
   if (lock_t *lock= lock_rec_get_first_on_page(lock_sys.rec_hash, block))
   {
     trx_mutex_enter(trx);
@@ -3943,17 +4092,18 @@ lock_table(
 	return(err);
 }
 
-/*********************************************************************//**
-Creates a table IX lock object for a resurrected transaction. */
+/** Create a table lock object for a resurrected transaction.
+@param[in,out]	table	table
+@param[in,out]	trx	recovered transaction
+@param[in]	mode	LOCK_IX, or LOCK_X if the transaction wrote
+			a TRX_UNDO_EMPTY record for the table */
 void
-lock_table_ix_resurrect(
-/*====================*/
-	dict_table_t*	table,	/*!< in/out: table */
-	trx_t*		trx)	/*!< in/out: transaction */
+lock_table_resurrect(dict_table_t* table, trx_t* trx, lock_mode mode)
 {
 	ut_ad(trx->is_recovered);
+	ut_ad(mode == LOCK_IX || mode == LOCK_X);
 
-	if (lock_table_has(trx, table, LOCK_IX)) {
+	if (lock_table_has(trx, table, mode)) {
 		return;
 	}
 
@@ -3963,10 +4113,10 @@ lock_table_ix_resurrect(
 	other transactions have in the table lock queue. */
 
 	ut_ad(!lock_table_other_has_incompatible(
-		      trx, LOCK_WAIT, table, LOCK_IX));
+		      trx, LOCK_WAIT, table, mode));
 
 	trx_mutex_enter(trx);
-	lock_table_create(table, LOCK_IX, trx);
+	lock_table_create(table, mode, trx);
 	lock_mutex_exit();
 	trx_mutex_exit(trx);
 }
@@ -4612,6 +4762,18 @@ lock_print_info_summary(
 		: "disabled",
 		uint32_t{trx_sys.rseg_history_len});
 
+	for (ulint i = 0; i < srv_n_purge_threads
+	     && i < purge_sys_t::MAX_THREADS; i++) {
+		const purge_sys_t::thread_stats_t&	stats
+			= purge_sys.thread_stats[i];
+
+		fprintf(file, "Purge %s " ULINTPF ": " ULINTPF " undo records,"
+			" busy %.2f s, idle %.2f s\n",
+			i ? "worker" : "coordinator", i, stats.n_recs,
+			double(stats.busy_us) / 1e6,
+			double(stats.idle_us) / 1e6);
+	}
+
 #ifdef PRINT_NUM_OF_LOCK_STRUCTS
 	fprintf(file,
 		"Total number of lock structs in row lock hash table %lu\n",
@@ -4831,8 +4993,8 @@ lock_table_queue_validate(
 
 		/* Transaction state may change from ACTIVE to PREPARED.
 		State change to COMMITTED is not possible while we are
-		holding lock_sys.mutex: it is done by lock_trx_release_locks()
-		under lock_sys.mutex protection.
+		holding lock_sys.latch: it is done by lock_trx_release_locks()
+		under lock_sys.latch protection.
 		Transaction in NOT_STARTED state cannot hold locks, and
 		lock->trx->state can only move to NOT_STARTED from COMMITTED. */
 		check_trx_state(lock->trx);
@@ -4927,7 +5089,7 @@ lock_rec_queue_validate(
 
 		ut_ad(lock_mutex_own());
 		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys.mutex */
+		because lock_trx_release_locks() acquires lock_sys.latch */
 
 		if (!impl_trx) {
 		} else if (const lock_t* other_lock
@@ -6306,11 +6468,11 @@ lock_trx_release_locks(
 
 	bool release_lock = UT_LIST_GET_LEN(trx->lock.trx_locks) > 0;
 
-	/* Don't take lock_sys.mutex if trx didn't acquire any lock. */
+	/* Don't take lock_sys.latch if trx didn't acquire any lock. */
 	if (release_lock) {
 
 		/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-		is protected by both the lock_sys.mutex and the trx->mutex. */
+		is protected by both the lock_sys.latch and the trx->mutex. */
 		lock_mutex_enter();
 	}
 
@@ -7046,6 +7208,16 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 		return(NULL);
 	}
 
+	const bool	report_waiters = trx->mysql_thd
+		&& thd_need_wait_reports(trx->mysql_thd);
+
+	/* The waits of replication threads must be reported right away,
+	so that thd_rpl_deadlock_check() can detect conflicts with the
+	commit order. Other waits are checked by check_waits(). */
+	if (innodb_deadlock_detect_interval && !report_waiters) {
+		return(NULL);
+	}
+
 	/*  Release the mutex to obey the latching order.
 	This is safe, because DeadlockChecker::check_and_resolve()
 	is invoked when a lock wait is enqueued for the currently
@@ -7057,8 +7229,6 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 	trx_mutex_exit(trx);
 
 	const trx_t*	victim_trx;
-	const bool	report_waiters = trx->mysql_thd
-		&& thd_need_wait_reports(trx->mysql_thd);
 
 	/* Try and resolve as many deadlocks as possible. */
 	do {
@@ -7114,6 +7284,403 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, trx_t* trx)
 	return(victim_trx);
 }
 
+/** Maximum number of waiting transactions whose edges are copied
+in one hold of lock_sys.latch */
+static const ulint LOCK_WAIT_SNAPSHOT_BATCH = 256;
+
+/** Maximum number of deadlocks that DeadlockChecker::check_waits()
+resolves in one round */
+static const ulint LOCK_WAIT_MAX_DEADLOCKS = 64;
+
+/** Invoke a functor on each lock of another transaction that is ahead
+of a waiting lock in its queue and that the waiting lock has to wait for,
+like DeadlockChecker::search() does.
+@param[in]	wait_lock	waiting lock
+@param[in,out]	functor		functor to invoke; returns whether
+				to continue
+@return whether all locks were visited */
+template<typename Functor>
+static
+bool
+lock_wait_for_each_blocking(const lock_t* wait_lock, Functor& functor)
+{
+	ut_ad(lock_mutex_own());
+	ut_ad(lock_get_wait(wait_lock));
+
+	ulint		heap_no = ULINT_UNDEFINED;
+	const lock_t*	lock;
+
+	if (lock_get_type_low(wait_lock) == LOCK_REC) {
+		heap_no = lock_rec_find_set_bit(wait_lock);
+
+		lock = lock_rec_get_first_on_page_addr(
+			wait_lock->type_mode & LOCK_PREDICATE
+			? lock_sys.prdt_hash
+			: lock_sys.rec_hash,
+			wait_lock->un_member.rec_lock.space,
+			wait_lock->un_member.rec_lock.page_no);
+
+		if (!lock_rec_get_nth_bit(lock, heap_no)) {
+			lock = lock_rec_get_next_const(heap_no, lock);
+		}
+	} else {
+		lock = UT_LIST_GET_FIRST(
+			wait_lock->un_member.tab_lock.table->locks);
+	}
+
+	for (; lock != NULL && lock != wait_lock;
+	     lock = heap_no == ULINT_UNDEFINED
+		     ? UT_LIST_GET_NEXT(un_member.tab_lock.locks, lock)
+		     : lock_rec_get_next_const(heap_no, lock)) {
+
+		if (lock->trx != wait_lock->trx
+		    && lock_has_to_wait(wait_lock, lock)
+		    && !functor(lock)) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/** Collect the edges of a node in a copy of the waits-for graph */
+struct lock_wait_add_edges_t {
+	/** Constructor.
+	@param[in]	nodes	waiting transactions, ordered by trx
+	@param[in,out]	edges	edges between the nodes */
+	lock_wait_add_edges_t(
+		const lock_wait_nodes_t&	nodes,
+		lock_wait_edges_t&		edges)
+		: m_nodes(nodes), m_edges(edges) {}
+
+	/** Add an edge to the transaction that holds a lock,
+	if that transaction is waiting too.
+	@return true */
+	bool operator()(const lock_t* lock)
+	{
+		lock_wait_node_t	key;
+		key.trx = lock->trx;
+
+		lock_wait_nodes_t::const_iterator	it = std::lower_bound(
+			m_nodes.begin(), m_nodes.end(), key);
+
+		if (it != m_nodes.end() && it->trx == lock->trx) {
+			m_edges.push_back(ulint(it - m_nodes.begin()));
+		}
+
+		return(true);
+	}
+
+private:
+	/** waiting transactions */
+	const lock_wait_nodes_t&	m_nodes;
+	/** edges between the nodes */
+	lock_wait_edges_t&		m_edges;
+};
+
+/** Check if a lock is held by a given transaction */
+struct lock_wait_held_by_t {
+	/** Constructor.
+	@param[in]	trx	transaction */
+	explicit lock_wait_held_by_t(const trx_t* trx) : m_trx(trx) {}
+
+	/** @return whether to keep looking */
+	bool operator()(const lock_t* lock) const
+	{
+		return(lock->trx != m_trx);
+	}
+
+private:
+	/** transaction */
+	const trx_t*	m_trx;
+};
+
+/** Copy the waits-for graph.
+@param[out]	nodes	waiting transactions
+@param[out]	edges	edges between the nodes */
+void
+DeadlockChecker::snapshot(lock_wait_nodes_t& nodes, lock_wait_edges_t& edges)
+{
+	lock_wait_mutex_enter();
+	lock_mutex_enter();
+
+	for (const srv_slot_t* slot = lock_sys.waiting_threads;
+	     slot < lock_sys.last_slot;
+	     ++slot) {
+
+		if (!slot->in_use) {
+			continue;
+		}
+
+		trx_t*	trx = thr_get_trx(slot->thr);
+
+		if (const lock_t* wait_lock = trx->lock.wait_lock) {
+			lock_wait_node_t	node = {
+				trx, wait_lock, 0, 0, false
+			};
+
+			nodes.push_back(node);
+		}
+	}
+
+	lock_mutex_exit();
+	lock_wait_mutex_exit();
+
+	std::sort(nodes.begin(), nodes.end());
+
+	/* Only edges to waiting transactions can be part of a cycle.
+	The latch is released between batches, so the copy may be
+	inconsistent; resolve() validates a cycle before acting on it. */
+	lock_wait_add_edges_t	add_edges(nodes, edges);
+
+	for (ulint i = 0; i < nodes.size(); ) {
+		const ulint	end = std::min(i + LOCK_WAIT_SNAPSHOT_BATCH,
+					       nodes.size());
+
+		lock_mutex_enter();
+
+		for (; i < end; i++) {
+			lock_wait_node_t&	node = nodes[i];
+
+			node.first_edge = edges.size();
+
+			if (node.trx->lock.wait_lock != node.wait_lock) {
+				/* The wait has ended. */
+				node.removed = true;
+				continue;
+			}
+
+			lock_wait_for_each_blocking(node.wait_lock,
+						    add_edges);
+
+			node.n_edges = edges.size() - node.first_edge;
+		}
+
+		lock_mutex_exit();
+	}
+}
+
+/** Find a cycle in a copy of the waits-for graph.
+@param[in]	nodes	waiting transactions
+@param[in]	edges	edges between the nodes
+@param[out]	cycle	positions of the deadlocked transactions
+in nodes, each one waiting for the next one
+@return whether a cycle was found */
+static
+bool
+lock_wait_find_cycle(
+	const lock_wait_nodes_t&	nodes,
+	const lock_wait_edges_t&	edges,
+	lock_wait_edges_t&		cycle)
+{
+	/* 0=not visited, 1=on the DFS stack, 2=done */
+	std::vector<byte, ut_allocator<byte> >	state(nodes.size());
+	/* DFS stack of (node, next edge to follow) */
+	std::vector<std::pair<ulint, ulint>,
+		    ut_allocator<std::pair<ulint, ulint> > >	stack;
+
+	for (ulint start = 0; start < nodes.size(); start++) {
+		if (state[start] || nodes[start].removed) {
+			continue;
+		}
+
+		state[start] = 1;
+		stack.push_back(std::make_pair(start, ulint(0)));
+
+		while (!stack.empty()) {
+			const ulint		n = stack.back().first;
+			const lock_wait_node_t&	node = nodes[n];
+
+			if (stack.back().second == node.n_edges) {
+				state[n] = 2;
+				stack.pop_back();
+				continue;
+			}
+
+			const ulint	next = edges[node.first_edge
+					     + stack.back().second++];
+
+			if (nodes[next].removed || state[next] == 2) {
+				continue;
+			}
+
+			if (state[next] == 0) {
+				state[next] = 1;
+				stack.push_back(std::make_pair(next,
+							       ulint(0)));
+				continue;
+			}
+
+			/* A back edge: the nodes from next to the top
+			of the stack form a cycle. */
+			ulint	i = stack.size();
+
+			while (stack[--i].first != next) {}
+
+			cycle.clear();
+
+			for (; i < stack.size(); i++) {
+				cycle.push_back(stack[i].first);
+			}
+
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/** Resolve a deadlock that was found in a copy of the
+waits-for graph, if it still exists.
+@param[in,out]	nodes	waiting transactions
+@param[in]	cycle	positions of the deadlocked transactions
+in nodes, each one waiting for the next one */
+void
+DeadlockChecker::resolve(
+	lock_wait_nodes_t&		nodes,
+	const lock_wait_edges_t&	cycle)
+{
+	lock_mutex_enter();
+
+	/* The same trx_t object may have started another transaction
+	that waits for a lock at the same address, so comparing
+	wait_lock is not enough. Check that every edge of the cycle
+	still exists: each member must still be waiting, blocked by a
+	lock of the next member that is ahead of it in the queue. */
+	bool	stale = false;
+
+	for (ulint i = 0; i < cycle.size(); i++) {
+		lock_wait_node_t&	node = nodes[cycle[i]];
+		const lock_t*		wait_lock = node.trx->lock.wait_lock;
+
+		if (wait_lock != node.wait_lock) {
+			/* The wait has ended. */
+			node.removed = true;
+			stale = true;
+			continue;
+		}
+
+		lock_wait_held_by_t	held_by(
+			nodes[cycle[(i + 1) % cycle.size()]].trx);
+
+		if (lock_wait_for_each_blocking(wait_lock, held_by)) {
+			/* The edge to the next member is gone. Drop the
+			node, so that it is copied again next time. */
+			node.removed = true;
+			stale = true;
+		}
+	}
+
+	if (stale) {
+		/* The waits changed after the copy was made.
+		There is no deadlock in this cycle. */
+		lock_mutex_exit();
+		return;
+	}
+
+	/* Choose the transaction with the smallest weight. */
+	ulint	victim = 0;
+
+	for (ulint i = 1; i < cycle.size(); i++) {
+		const trx_t*	trx = nodes[cycle[i]].trx;
+		const trx_t*	victim_trx = nodes[cycle[victim]].trx;
+
+#ifdef WITH_WSREP
+		if (wsrep_thd_is_BF(trx->mysql_thd, TRUE)) {
+			continue;
+		}
+
+		if (wsrep_thd_is_BF(victim_trx->mysql_thd, TRUE)) {
+			victim = i;
+			continue;
+		}
+#endif /* WITH_WSREP */
+
+		if (trx_weight_ge(victim_trx, trx)) {
+			victim = i;
+		}
+	}
+
+	start_print();
+
+	char	buf[32];
+
+	for (ulint i = 0; i < cycle.size(); i++) {
+		const lock_wait_node_t&	node = nodes[cycle[i]];
+
+		snprintf(buf, sizeof buf, "\n*** (" ULINTPF ")", i + 1);
+		print(buf);
+		print(" TRANSACTION:\n");
+		print(node.trx, 3000);
+
+		snprintf(buf, sizeof buf, "*** (" ULINTPF ")", i + 1);
+		print(buf);
+		print(" WAITING FOR THIS LOCK TO BE GRANTED:\n");
+		print(node.wait_lock);
+	}
+
+	print("*** WE ROLL BACK TRANSACTION ");
+	snprintf(buf, sizeof buf, "(" ULINTPF ")\n", victim + 1);
+	print(buf);
+
+	lock_wait_node_t&	node = nodes[cycle[victim]];
+	trx_t*			trx = node.trx;
+
+#ifdef WITH_WSREP
+	if (wsrep_on(trx->mysql_thd)) {
+		wsrep_handle_SR_rollback(
+			nodes[cycle[(victim + 1) % cycle.size()]]
+			.trx->mysql_thd, trx->mysql_thd);
+	}
+#endif /* WITH_WSREP */
+
+	trx_mutex_enter(trx);
+
+	trx->lock.was_chosen_as_deadlock_victim = true;
+
+	lock_cancel_waiting_and_release(trx->lock.wait_lock);
+
+	trx_mutex_exit(trx);
+
+	node.removed = true;
+
+	lock_deadlock_found = true;
+
+	MONITOR_INC(MONITOR_DEADLOCK);
+
+	lock_mutex_exit();
+}
+
+/** Look for deadlocks among the waiting transactions and roll back
+a victim of each. */
+void
+DeadlockChecker::check_waits()
+{
+	ut_ad(!lock_mutex_own());
+	ut_ad(!srv_read_only_mode);
+
+	lock_wait_nodes_t	nodes;
+	lock_wait_edges_t	edges;
+	lock_wait_edges_t	cycle;
+
+	snapshot(nodes, edges);
+
+	for (ulint n = 0; n < LOCK_WAIT_MAX_DEADLOCKS
+	     && lock_wait_find_cycle(nodes, edges, cycle); n++) {
+		resolve(nodes, cycle);
+	}
+}
+
+/** Look for deadlocks among the waiting transactions and roll back
+a victim of each, without holding lock_sys.latch during the search.
+This is invoked by lock_wait_timeout_thread() every
+innodb_deadlock_detect_interval milliseconds. */
+void
+lock_deadlock_check_waits()
+{
+	DeadlockChecker::check_waits();
+}
+
 /*************************************************************//**
 Updates the lock table when a page is split and merged to
 two pages. */
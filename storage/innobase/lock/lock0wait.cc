@@ -184,7 +184,7 @@ lock_wait_table_reserve_slot(
 check if lock timeout was for priority thread,
 as a side effect trigger lock monitor
 @param[in]    trx    transaction owning the lock
-@param[in]    locked true if trx and lock_sys.mutex is ownd
+@param[in]    locked true if trx and lock_sys.latch is ownd
 @return	false for regular lock timeout */
 static
 bool
@@ -527,6 +527,9 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 {
 	int64_t		sig_count = 0;
 	os_event_t	event = lock_sys.timeout_event;
+	ulint		last_deadlock_check = ut_time_ms();
+	ulint		interval = innobase_deadlock_detect
+		? innodb_deadlock_detect_interval : 0;
 
 	ut_ad(!srv_read_only_mode);
 
@@ -540,7 +543,10 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 		/* When someone is waiting for a lock, we wake up every second
 		and check if a timeout has passed for a lock wait */
 
-		os_event_wait_time_low(event, 1000000, sig_count);
+		os_event_wait_time_low(event,
+				       interval && interval < 1000
+				       ? interval * 1000 : 1000000,
+				       sig_count);
 		sig_count = os_event_reset(event);
 
 		if (srv_shutdown_state >= SRV_SHUTDOWN_CLEANUP) {
@@ -570,6 +576,25 @@ DECLARE_THREAD(lock_wait_timeout_thread)(void*)
 
 		lock_wait_mutex_exit();
 
+		const ulint	prev_interval = interval;
+
+		interval = innobase_deadlock_detect
+			? innodb_deadlock_detect_interval : 0;
+
+		if (interval) {
+			if (ut_time_ms() - last_deadlock_check >= interval) {
+				last_deadlock_check = ut_time_ms();
+				lock_deadlock_check_waits();
+			}
+		} else if (prev_interval && innobase_deadlock_detect) {
+			/* innodb_deadlock_detect_interval was set to 0.
+			New waits will be checked by
+			DeadlockChecker::check_and_resolve(), but the
+			waits that were queued for us must still be
+			checked once. */
+			lock_deadlock_check_waits();
+		}
+
 	} while (srv_shutdown_state < SRV_SHUTDOWN_CLEANUP);
 
 	lock_sys.timeout_thread_active = false;
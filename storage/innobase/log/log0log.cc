@@ -46,6 +46,7 @@ Created 12/9/1995 Heikki Tuuri
 #include "dict0boot.h"
 #include "dict0stats_bg.h"
 #include "btr0defragment.h"
+#include "ibuf0ibuf.h"
 #include "srv0srv.h"
 #include "srv0start.h"
 #include "trx0sys.h"
@@ -203,6 +204,8 @@ void log_buffer_extend(ulong len)
 		log_mutex_enter_all();
 	}
 
+	log_sys.wait_for_pending_copies();
+
 	ulong move_start = ut_2pow_round(log_sys.buf_free,
 					 ulong(OS_FILE_LOG_BLOCK_SIZE));
 	ulong move_end = log_sys.buf_free;
@@ -388,72 +391,136 @@ log_reserve_and_open(
 	return(log_sys.lsn);
 }
 
-/************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-void
-log_write_low(
-/*==========*/
-	const byte*	str,		/*!< in: string */
-	ulint		str_len)	/*!< in: string length */
+/** Reserve space for a string in the log buffer and initialize the
+headers of the log blocks that it spans.
+@param[in]	len	string length
+@return start of the reserved area in log_sys.buf */
+static byte* log_reserve_low(ulint len)
 {
-	ulint	len;
-
 	ut_ad(log_mutex_own());
+	ut_ad(len > 0);
+
 	const ulint trailer_offset = log_sys.trailer_offset();
-part_loop:
-	/* Calculate a part length */
+	byte* const start = log_sys.buf + log_sys.buf_free;
 
-	ulint data_len = (log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE) + str_len;
+	do {
+		ulint offset = log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE;
+		ulint data_len = offset + len;
+		ulint part_len;
 
-	if (data_len <= trailer_offset) {
+		if (data_len <= trailer_offset) {
+			/* The string fits within the current log block */
+			part_len = len;
+		} else {
+			data_len = trailer_offset;
+			part_len = trailer_offset - offset;
+		}
 
-		/* The string fits within the current log block */
+		len -= part_len;
 
-		len = str_len;
-	} else {
-		data_len = trailer_offset;
+		byte* log_block = static_cast<byte*>(
+			ut_align_down(log_sys.buf + log_sys.buf_free,
+				      OS_FILE_LOG_BLOCK_SIZE));
 
-		len = trailer_offset
-			- log_sys.buf_free % OS_FILE_LOG_BLOCK_SIZE;
-	}
+		log_block_set_data_len(log_block, data_len);
 
-	memcpy(log_sys.buf + log_sys.buf_free, str, len);
+		if (data_len == trailer_offset) {
+			/* This block became full */
+			log_block_set_data_len(log_block,
+					       OS_FILE_LOG_BLOCK_SIZE);
+			log_block_set_checkpoint_no(
+				log_block, log_sys.next_checkpoint_no);
+			part_len += log_sys.framing_size();
 
-	str_len -= len;
-	str = str + len;
+			log_sys.lsn += part_len;
 
-	byte* log_block = static_cast<byte*>(
-		ut_align_down(log_sys.buf + log_sys.buf_free,
-			      OS_FILE_LOG_BLOCK_SIZE));
+			/* Initialize the next block header */
+			log_block_init(log_block + OS_FILE_LOG_BLOCK_SIZE,
+				       log_sys.lsn);
+		} else {
+			log_sys.lsn += part_len;
+		}
 
-	log_block_set_data_len(log_block, data_len);
+		log_sys.buf_free += ulong(part_len);
 
-	if (data_len == trailer_offset) {
-		/* This block became full */
-		log_block_set_data_len(log_block, OS_FILE_LOG_BLOCK_SIZE);
-		log_block_set_checkpoint_no(log_block,
-					    log_sys.next_checkpoint_no);
-		len += log_sys.framing_size();
+		ut_ad(log_sys.buf_free <= srv_log_buffer_size);
+	} while (len);
 
-		log_sys.lsn += len;
+	srv_stats.log_write_requests.inc();
+	return start;
+}
 
-		/* Initialize the next block header */
-		log_block_init(log_block + OS_FILE_LOG_BLOCK_SIZE,
-			       log_sys.lsn);
-	} else {
-		log_sys.lsn += len;
+/** Copy (a part of) a string to an area of the log buffer that was
+reserved by log_reserve_low(), skipping the log block framing.
+@param[in]	dst	start of the area, or the return value of
+			the previous log_copy_reserved() call
+@param[in]	str	string
+@param[in]	len	string length
+@return end of the copied area */
+byte* log_copy_reserved(byte* dst, const byte* str, ulint len)
+{
+	const ulint trailer_offset = log_sys.trailer_offset();
+
+	while (len) {
+		ulint offset = ulint(dst - static_cast<byte*>(
+			ut_align_down(dst, OS_FILE_LOG_BLOCK_SIZE)));
+		ut_ad(offset >= LOG_BLOCK_HDR_SIZE);
+		ut_ad(offset < trailer_offset);
+		ulint part_len = std::min(len, trailer_offset - offset);
+
+		memcpy(dst, str, part_len);
+		str += part_len;
+		len -= part_len;
+		dst += part_len;
+
+		if (offset + part_len == trailer_offset) {
+			/* Skip the trailer of this block and
+			the header of the next one. */
+			dst += log_sys.framing_size();
+		}
 	}
 
-	log_sys.buf_free += ulong(len);
+	return dst;
+}
+
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+void
+log_write_low(
+/*==========*/
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	log_copy_reserved(log_reserve_low(str_len), str, str_len);
+}
+
+/** Reserve space for a string in the log buffer and initialize the
+headers of the log blocks that it spans, but do not copy the string.
+The caller must hold the log mutex, and must copy the string with
+log_copy_reserved() and invoke log_release_reserved() after releasing it.
+@param[in]	len	string length
+@return start of the reserved area in log_sys.buf */
+byte* log_reserve_for_copy(ulint len)
+{
+	ut_ad(log_mutex_own());
+	log_sys.n_pending_copies.fetch_add(1, std::memory_order_relaxed);
+	return log_reserve_low(len);
+}
 
-	ut_ad(log_sys.buf_free <= srv_log_buffer_size);
+/** Wait until all areas reserved by log_reserve_for_copy() have been
+copied. The caller must hold mutex, so that no new areas can be
+reserved while waiting. */
+void log_t::wait_for_pending_copies()
+{
+	ut_ad(this == &log_sys);
+	ut_ad(mutex.is_owned());
 
-	if (str_len > 0) {
-		goto part_loop;
+	/* The copying threads do not acquire any latches before
+	log_release_reserved(), so this wait is short. */
+	while (n_pending_copies.load(std::memory_order_acquire)) {
+		ut_delay(srv_spin_wait_delay);
 	}
-
-	srv_stats.log_write_requests.inc();
 }
 
 /************************************************************//**
@@ -607,6 +674,7 @@ void log_t::create()
   TRASH_ALLOC(buf, srv_log_buffer_size * 2);
 
   first_in_use= true;
+  n_pending_copies= 0;
 
   max_buf_free= srv_log_buffer_size / LOG_BUF_FLUSH_RATIO -
     LOG_BUF_FLUSH_MARGIN;
@@ -993,6 +1061,8 @@ void log_write_up_to(lsn_t lsn, bool flush_to_disk, bool rotate_key)
 	}
 
 	log_mutex_enter();
+	log_sys.wait_for_pending_copies();
+
 	if (!flush_to_disk
 	    && log_sys.buf_free == log_sys.buf_next_to_write) {
 		/* Nothing to write and no flush to disk requested */
@@ -1685,6 +1755,7 @@ logs_empty_and_mark_files_at_shutdown(void)
 		os_event_set(srv_error_event);
 		os_event_set(srv_monitor_event);
 		os_event_set(srv_buf_dump_event);
+		ibuf_merge_threads_wakeup();
 		if (lock_sys.timeout_thread_active) {
 			os_event_set(lock_sys.timeout_event);
 		}
@@ -1748,6 +1819,8 @@ logs_empty_and_mark_files_at_shutdown(void)
 		goto wait_suspend_loop;
 	} else if (btr_defragment_thread_active) {
 		thread_name = "btr_defragment_thread";
+	} else if (ibuf_merge_n_threads_active) {
+		thread_name = "ibuf_merge_thread";
 	} else if (srv_fast_shutdown != 2 && trx_rollback_is_active) {
 		thread_name = "rollback of recovered transactions";
 	} else {
@@ -1809,6 +1882,8 @@ logs_empty_and_mark_files_at_shutdown(void)
 		}
 	}
 
+	buf_flush_compress_threads_shutdown();
+
 	if (log_scrub_thread_active) {
 		ut_ad(!srv_read_only_mode);
 		os_event_set(log_scrub_event);
@@ -2020,6 +2095,7 @@ void log_t::close()
   if (!is_initialised()) return;
   m_initialised = false;
   log.close();
+  ut_ad(!n_pending_copies);
 
   if (!first_in_use)
     buf -= srv_log_buffer_size;
@@ -729,6 +729,15 @@ recv_sys_close()
 			os_event_destroy(recv_sys->flush_end);
 		}
 
+		if (recv_sys->apply_end != NULL) {
+			os_event_destroy(recv_sys->apply_end);
+		}
+
+		if (recv_sys->read_ahead.request != NULL) {
+			os_event_destroy(recv_sys->read_ahead.request);
+			os_event_destroy(recv_sys->read_ahead.done);
+		}
+
 		if (recv_sys->buf != NULL) {
 			ut_free_dodump(recv_sys->buf, recv_sys->buf_size);
 		}
@@ -839,6 +848,10 @@ recv_sys_init()
 		recv_sys->flush_end = os_event_create(0);
 	}
 
+	recv_sys->apply_end = os_event_create(0);
+	recv_sys->read_ahead.request = os_event_create(0);
+	recv_sys->read_ahead.done = os_event_create(0);
+
 	ulint size = buf_pool_get_curr_size();
 	/* Set appropriate value of recv_n_pool_free_frames. */
 	if (size >= 10 << 20) {
@@ -900,47 +913,72 @@ recv_sys_debug_free(void)
 	mutex_exit(&(recv_sys->mutex));
 }
 
+/** Read a part of the log files, without validating it.
+This does not require log_sys.mutex.
+@param[in]	offset	calc_lsn_offset() of the start of the area
+@param[in]	len	length of the area, in bytes
+@param[out]	buf	buffer to read to */
+void log_t::files::read(lsn_t offset, ulint len, byte* buf) const
+{
+	ut_ad(!(offset % OS_FILE_LOG_BLOCK_SIZE));
+	ut_ad(!(len % OS_FILE_LOG_BLOCK_SIZE));
+
+	while (len) {
+		const lsn_t file_end = offset - offset % file_size
+			+ file_size;
+		ulint l = len;
+
+		if (offset + l > file_end) {
+			/* If the above condition is true then l (which
+			is ulint) is > the expression below, so the
+			typecast is ok */
+			l = ulint(file_end - offset);
+		}
+
+		ut_a((offset >> srv_page_size_shift) <= ULINT_MAX);
+
+		fil_io(IORequestLogRead, true,
+		       page_id_t(SRV_LOG_SPACE_FIRST_ID,
+				 ulint(offset >> srv_page_size_shift)),
+		       0, ulint(offset & (srv_page_size - 1)),
+		       l, buf, NULL);
+
+		buf += l;
+		len -= l;
+		/* Continue after the header of the next file. */
+		offset = (file_end == file_size * n_files ? 0 : file_end)
+			+ LOG_FILE_HDR_SIZE;
+	}
+}
+
 /** Read a log segment to log_sys.buf.
 @param[in,out]	start_lsn	in: read area start,
 out: the last read valid lsn
 @param[in]	end_lsn		read area end
+@param[in]	prefetched	whether the segment was already read
+to log_sys.buf, and only needs to be validated
 @return	whether no invalid blocks (e.g checksum mismatch) were found */
-bool log_t::files::read_log_seg(lsn_t* start_lsn, lsn_t end_lsn)
+bool log_t::files::read_log_seg(lsn_t* start_lsn, lsn_t end_lsn,
+				bool prefetched)
 {
-	ulint	len;
 	bool success = true;
 	ut_ad(log_sys.mutex.is_owned());
 	ut_ad(!(*start_lsn % OS_FILE_LOG_BLOCK_SIZE));
 	ut_ad(!(end_lsn % OS_FILE_LOG_BLOCK_SIZE));
 	byte* buf = log_sys.buf;
-loop:
-	lsn_t source_offset = calc_lsn_offset(*start_lsn);
 
 	ut_a(end_lsn - *start_lsn <= ULINT_MAX);
-	len = (ulint) (end_lsn - *start_lsn);
+	const ulint len = ulint(end_lsn - *start_lsn);
 
 	ut_ad(len != 0);
 
-	const bool at_eof = (source_offset % file_size) + len > file_size;
-	if (at_eof) {
-		/* If the above condition is true then len (which is ulint)
-		is > the expression below, so the typecast is ok */
-		len = ulint(file_size - (source_offset % file_size));
-	}
-
 	log_sys.n_log_ios++;
 
 	MONITOR_INC(MONITOR_LOG_IO);
 
-	ut_a((source_offset >> srv_page_size_shift) <= ULINT_MAX);
-
-	const ulint	page_no = ulint(source_offset >> srv_page_size_shift);
-
-	fil_io(IORequestLogRead, true,
-	       page_id_t(SRV_LOG_SPACE_FIRST_ID, page_no),
-	       0,
-	       ulint(source_offset & (srv_page_size - 1)),
-	       len, buf, NULL);
+	if (!prefetched) {
+		read(calc_lsn_offset(*start_lsn), len, buf);
+	}
 
 	for (ulint l = 0; l < len; l += OS_FILE_LOG_BLOCK_SIZE,
 		     buf += OS_FILE_LOG_BLOCK_SIZE,
@@ -954,7 +992,6 @@ bool log_t::files::read_log_seg(lsn_t* start_lsn, lsn_t end_lsn)
 			writing redo log. We simply treat this as an
 			abrupt end of the redo log. */
 fail:
-			end_lsn = *start_lsn;
 			success = false;
 			break;
 		}
@@ -1004,10 +1041,6 @@ bool log_t::files::read_log_seg(lsn_t* start_lsn, lsn_t end_lsn)
 			*start_lsn);
 	}
 
-	if (*start_lsn != end_lsn) {
-		goto loop;
-	}
-
 	return(success);
 }
 
@@ -2174,70 +2207,18 @@ static void recv_read_in_area(const page_id_t page_id)
 	mutex_enter(&recv_sys->mutex);
 }
 
-/** Apply the hash table of stored log records to persistent data pages.
-@param[in]	last_batch	whether the change buffer merge will be
-				performed as part of the operation */
-void recv_apply_hashed_log_recs(bool last_batch)
+/** Read in and apply the hashed log records for the pages in some
+cells of recv_sys->addr_hash.
+@param[in,out]	mtr	mini-transaction
+@param[in]	first	the first cell to process
+@param[in]	step	distance between the cells to process */
+static void recv_apply_hashed_cells(mtr_t& mtr, ulint first, ulint step)
 {
-	ut_ad(srv_operation == SRV_OPERATION_NORMAL
-	      || srv_operation == SRV_OPERATION_RESTORE
-	      || srv_operation == SRV_OPERATION_RESTORE_EXPORT);
-
-	mutex_enter(&recv_sys->mutex);
-
-	while (recv_sys->apply_batch_on) {
-		bool abort = recv_sys->found_corrupt_log;
-		mutex_exit(&recv_sys->mutex);
-
-		if (abort) {
-			return;
-		}
-
-		os_thread_sleep(500000);
-		mutex_enter(&recv_sys->mutex);
-	}
-
-	ut_ad(!last_batch == log_mutex_own());
-
-	recv_no_ibuf_operations = !last_batch
-		|| srv_operation == SRV_OPERATION_RESTORE
-		|| srv_operation == SRV_OPERATION_RESTORE_EXPORT;
-
-	ut_d(recv_no_log_write = recv_no_ibuf_operations);
-
-	if (ulint n = recv_sys->n_addrs) {
-		if (!log_sys.log.subformat && !srv_force_recovery
-		    && srv_undo_tablespaces_open) {
-			ib::error() << "Recovery of separately logged"
-				" TRUNCATE operations is no longer supported."
-				" Set innodb_force_recovery=1"
-				" if no *trunc.log files exist";
-			recv_sys->found_corrupt_log = true;
-			mutex_exit(&recv_sys->mutex);
-			return;
-		}
-
-		const char* msg = last_batch
-			? "Starting final batch to recover "
-			: "Starting a batch to recover ";
-		ib::info() << msg << n << " pages from redo log.";
-		sd_notifyf(0, "STATUS=%s" ULINTPF " pages from redo log",
-			   msg, n);
-	}
-	recv_sys->apply_log_recs = TRUE;
-	recv_sys->apply_batch_on = TRUE;
-
-	for (ulint id = srv_undo_tablespaces_open; id--; ) {
-		recv_sys_t::trunc& t = recv_sys->truncated_undo_spaces[id];
-		if (t.lsn) {
-			recv_addr_trim(id + srv_undo_space_id_start, t.pages,
-				       t.lsn);
-		}
-	}
-
-	mtr_t mtr;
+	ut_ad(mutex_own(&recv_sys->mutex));
+	ut_ad(recv_sys->apply_batch_on);
 
-	for (ulint i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+	for (ulint i = first; i < hash_get_n_cells(recv_sys->addr_hash);
+	     i += step) {
 		for (recv_addr_t* recv_addr = static_cast<recv_addr_t*>(
 			     HASH_GET_FIRST(recv_sys->addr_hash, i));
 		     recv_addr;
@@ -2358,6 +2339,123 @@ void recv_apply_hashed_log_recs(bool last_batch)
 			}
 		}
 	}
+}
+
+/** Apply the redo log records for a share of the pages of a batch
+in recv_apply_hashed_log_recs().
+@param[in]	arg	the first hash table cell to process
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(void* arg)
+{
+	my_thread_init();
+
+	mtr_t mtr;
+	mutex_enter(&recv_sys->mutex);
+	recv_apply_hashed_cells(mtr, reinterpret_cast<ulint>(arg),
+				recv_sys->n_apply_threads);
+
+	ut_ad(recv_sys->n_apply_active);
+
+	if (!--recv_sys->n_apply_active) {
+		os_event_set(recv_sys->apply_end);
+	}
+
+	mutex_exit(&recv_sys->mutex);
+
+	my_thread_end();
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Apply the hash table of stored log records to persistent data pages.
+@param[in]	last_batch	whether the change buffer merge will be
+				performed as part of the operation */
+void recv_apply_hashed_log_recs(bool last_batch)
+{
+	ut_ad(srv_operation == SRV_OPERATION_NORMAL
+	      || srv_operation == SRV_OPERATION_RESTORE
+	      || srv_operation == SRV_OPERATION_RESTORE_EXPORT);
+
+	mutex_enter(&recv_sys->mutex);
+
+	while (recv_sys->apply_batch_on) {
+		bool abort = recv_sys->found_corrupt_log;
+		mutex_exit(&recv_sys->mutex);
+
+		if (abort) {
+			return;
+		}
+
+		os_thread_sleep(500000);
+		mutex_enter(&recv_sys->mutex);
+	}
+
+	ut_ad(!last_batch == log_mutex_own());
+
+	recv_no_ibuf_operations = !last_batch
+		|| srv_operation == SRV_OPERATION_RESTORE
+		|| srv_operation == SRV_OPERATION_RESTORE_EXPORT;
+
+	ut_d(recv_no_log_write = recv_no_ibuf_operations);
+
+	if (ulint n = recv_sys->n_addrs) {
+		if (!log_sys.log.subformat && !srv_force_recovery
+		    && srv_undo_tablespaces_open) {
+			ib::error() << "Recovery of separately logged"
+				" TRUNCATE operations is no longer supported."
+				" Set innodb_force_recovery=1"
+				" if no *trunc.log files exist";
+			recv_sys->found_corrupt_log = true;
+			mutex_exit(&recv_sys->mutex);
+			return;
+		}
+
+		const char* msg = last_batch
+			? "Starting final batch to recover "
+			: "Starting a batch to recover ";
+		ib::info() << msg << n << " pages from redo log.";
+		sd_notifyf(0, "STATUS=%s" ULINTPF " pages from redo log",
+			   msg, n);
+	}
+	recv_sys->apply_log_recs = TRUE;
+	recv_sys->apply_batch_on = TRUE;
+
+	for (ulint id = srv_undo_tablespaces_open; id--; ) {
+		recv_sys_t::trunc& t = recv_sys->truncated_undo_spaces[id];
+		if (t.lsn) {
+			recv_addr_trim(id + srv_undo_space_id_start, t.pages,
+				       t.lsn);
+		}
+	}
+
+	const uintmax_t apply_start = ut_time_us(NULL);
+
+	/* Partition the hash table cells, that is, the pages, between
+	this thread and n - 1 recv_apply_thread(). Each thread reads in
+	and applies the log records for its own pages, and the pages that
+	are read in are recovered by the I/O handler threads. */
+	const ulint n = std::min<ulint>(srv_n_recv_apply_threads,
+					hash_get_n_cells(recv_sys->addr_hash));
+	recv_sys->n_apply_threads = n;
+	recv_sys->n_apply_active = n - 1;
+	os_event_reset(recv_sys->apply_end);
+
+	for (ulint i = 1; i < n; i++) {
+		os_thread_create(recv_apply_thread,
+				 reinterpret_cast<void*>(i), NULL);
+	}
+
+	mtr_t mtr;
+	recv_apply_hashed_cells(mtr, 0, n);
+
+	while (recv_sys->n_apply_active) {
+		mutex_exit(&recv_sys->mutex);
+		os_event_wait(recv_sys->apply_end);
+		mutex_enter(&recv_sys->mutex);
+	}
 
 	/* Wait until all the pages have been processed */
 
@@ -2381,6 +2479,9 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		mutex_enter(&(recv_sys->mutex));
 	}
 
+	const uintmax_t apply_done = ut_time_us(NULL);
+	recv_sys->time.apply += apply_done - apply_start;
+
 	if (!last_batch) {
 		/* Flush all the file pages to disk and invalidate them in
 		the buffer pool */
@@ -2408,6 +2509,7 @@ void recv_apply_hashed_log_recs(bool last_batch)
 		log_mutex_enter();
 		mutex_enter(&(recv_sys->mutex));
 		mlog_init.reset();
+		recv_sys->time.flush += ut_time_us(NULL) - apply_done;
 	} else if (!recv_no_ibuf_operations) {
 		/* We skipped this in buf_page_create(). */
 		mlog_init.ibuf_merge(mtr);
@@ -3245,6 +3347,91 @@ recv_scan_log_recs(
 	return(finished);
 }
 
+/** Read the next redo log segment for recv_group_scan_log_recs()
+while the current one is being parsed.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_read_ahead_thread)(void*)
+{
+	my_thread_init();
+
+	recv_sys_t::read_ahead_t& r = recv_sys->read_ahead;
+
+	for (;;) {
+		os_event_wait(r.request);
+		os_event_reset(r.request);
+
+		if (!r.buf) {
+			break;
+		}
+
+		log_sys.log.read(r.offset, ulint(r.end_lsn - r.start_lsn),
+				 r.buf);
+		os_event_set(r.done);
+	}
+
+	os_event_set(r.done);
+
+	my_thread_end();
+	os_thread_exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Request recv_read_ahead_thread() to read a redo log segment to the
+half of the log buffer that log_sys.buf is not pointing to.
+@param[in]	start_lsn	start of the segment,
+				or 0 to make the thread exit */
+static void recv_read_ahead(lsn_t start_lsn)
+{
+	ut_ad(log_mutex_own());
+	recv_sys_t::read_ahead_t& r = recv_sys->read_ahead;
+	ut_ad(!r.pending);
+
+	if (start_lsn) {
+		r.start_lsn = start_lsn;
+		r.end_lsn = start_lsn + RECV_SCAN_SIZE;
+		r.offset = log_sys.log.calc_lsn_offset(start_lsn);
+		r.buf = log_sys.first_in_use
+			? log_sys.buf + srv_log_buffer_size
+			: log_sys.buf - srv_log_buffer_size;
+	} else {
+		r.buf = NULL;
+	}
+
+	r.pending = true;
+	os_event_reset(r.done);
+	os_event_set(r.request);
+}
+
+/** Wait for the read requested by recv_read_ahead() to complete.
+@param[in]	start_lsn	start of the segment that is needed next
+@return whether the segment was read ahead and log_sys.buf now points
+to it */
+static bool recv_read_ahead_wait(lsn_t start_lsn)
+{
+	ut_ad(log_mutex_own());
+	recv_sys_t::read_ahead_t& r = recv_sys->read_ahead;
+
+	if (!r.pending) {
+		return false;
+	}
+
+	os_event_wait(r.done);
+	r.pending = false;
+
+	if (!r.buf || r.start_lsn != start_lsn) {
+		return false;
+	}
+
+	/* Switch to the half that was read to, like log_buffer_switch().
+	The other half will be read to next. */
+	log_sys.buf = r.buf;
+	log_sys.first_in_use = !log_sys.first_in_use;
+	return true;
+}
+
 /** Scans log from a buffer and stores new log data to the parsing buffer.
 Parses and hashes the log records if new data found.
 @param[in]	checkpoint_lsn		latest checkpoint log sequence number
@@ -3291,6 +3478,8 @@ recv_group_scan_log_recs(
 	log_sys.log.scanned_lsn = end_lsn = *contiguous_lsn =
 		ut_uint64_align_down(*contiguous_lsn, OS_FILE_LOG_BLOCK_SIZE);
 
+	os_thread_create(recv_read_ahead_thread, NULL, NULL);
+
 	do {
 		if (last_phase && store_to_hash == STORE_NO) {
 			store_to_hash = STORE_IF_EXISTS;
@@ -3304,13 +3493,35 @@ recv_group_scan_log_recs(
 		start_lsn = ut_uint64_align_down(end_lsn,
 						 OS_FILE_LOG_BLOCK_SIZE);
 		end_lsn = start_lsn;
-		log_sys.log.read_log_seg(&end_lsn, start_lsn + RECV_SCAN_SIZE);
-	} while (end_lsn != start_lsn
-		 && !recv_scan_log_recs(
-			 available_mem, &store_to_hash, log_sys.buf,
-			 checkpoint_lsn,
-			 start_lsn, end_lsn,
-			 contiguous_lsn, &log_sys.log.scanned_lsn));
+		uintmax_t phase_start = ut_time_us(NULL);
+		/* Read the next segment while this one is being parsed,
+		or a batch is being applied above. */
+		const bool prefetched = recv_read_ahead_wait(start_lsn);
+		recv_read_ahead(start_lsn + RECV_SCAN_SIZE);
+		log_sys.log.read_log_seg(&end_lsn, start_lsn + RECV_SCAN_SIZE,
+					 prefetched);
+		recv_sys->time.scan += ut_time_us(NULL) - phase_start;
+
+		if (end_lsn == start_lsn) {
+			break;
+		}
+
+		phase_start = ut_time_us(NULL);
+		const bool finished = recv_scan_log_recs(
+			available_mem, &store_to_hash, log_sys.buf,
+			checkpoint_lsn,
+			start_lsn, end_lsn,
+			contiguous_lsn, &log_sys.log.scanned_lsn);
+		recv_sys->time.parse += ut_time_us(NULL) - phase_start;
+
+		if (finished) {
+			break;
+		}
+	} while (true);
+
+	recv_read_ahead_wait(0);
+	recv_read_ahead(0);
+	recv_read_ahead_wait(0);
 
 	if (recv_sys->found_corrupt_log || recv_sys->found_corrupt_fs) {
 		DBUG_RETURN(false);
@@ -3829,6 +4040,16 @@ recv_recovery_from_checkpoint_finish(void)
 		}
 	}
 
+	if (recv_needed_recovery) {
+		const recv_sys_t::phase_times& t = recv_sys->time;
+		ib::info() << "Redo log recovery took "
+			<< t.scan / 1000 << " ms to read, "
+			<< t.parse / 1000 << " ms to parse, "
+			<< t.apply / 1000 << " ms to apply with "
+			<< srv_n_recv_apply_threads << " threads, and "
+			<< t.flush / 1000 << " ms to flush";
+	}
+
 	recv_sys_debug_free();
 
 	/* Free up the flush_rbt. */
@@ -416,6 +416,18 @@ class mtr_t::Command {
 	@return number of bytes to write in finish_write() */
 	ulint prepare_write();
 
+	/** Reserve space for the redo log records in the redo log buffer.
+	Small records are appended right away; larger ones must be copied
+	by copy_reserved() after log_sys.mutex has been released.
+	@param[in]	len	number of bytes to write
+	@return the area to copy the records to
+	@retval	NULL	if the records were already appended */
+	byte* reserve_write(ulint len);
+
+	/** Copy the redo log records to the area returned by reserve_write().
+	@param[in,out]	dst	reserved area in log_sys.buf */
+	void copy_reserved(byte* dst);
+
 	/** The mini-transaction state. */
 	mtr_t::Impl*		m_impl;
 
@@ -455,6 +467,26 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the block contents to a reserved area of the redo log buffer */
+struct mtr_copy_log_t {
+	/** Constructor.
+	@param[in]	dst	area reserved by log_reserve_for_copy() */
+	explicit mtr_copy_log_t(byte* dst) : m_dst(dst) {}
+
+	/** Append a block to the reserved area.
+	@return whether the appending should continue */
+	bool operator()(const mtr_buf_t::block_t* block)
+	{
+		m_dst = log_copy_reserved(m_dst, block->begin(),
+					  block->used());
+		return(true);
+	}
+
+private:
+	/** current position in the reserved area */
+	byte*	m_dst;
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -849,6 +881,54 @@ mtr_t::Command::finish_write(
 	m_end_lsn = log_close();
 }
 
+/** Reserve space for the redo log records in the redo log buffer.
+Small records are appended right away; larger ones must be copied
+by copy_reserved() after log_sys.mutex has been released.
+@param[in]	len	number of bytes to write
+@return the area to copy the records to
+@retval	NULL	if the records were already appended */
+byte*
+mtr_t::Command::reserve_write(
+	ulint	len)
+{
+	ut_ad(m_impl->m_log_mode == MTR_LOG_ALL);
+	ut_ad(log_mutex_own());
+	ut_ad(m_impl->m_log.size() == len);
+	ut_ad(len > 0);
+
+	if (m_impl->m_log.is_small()) {
+		const mtr_buf_t::block_t*	front = m_impl->m_log.front();
+		ut_ad(len <= front->used());
+
+		m_end_lsn = log_reserve_and_write_fast(
+			front->begin(), len, &m_start_lsn);
+
+		if (m_end_lsn > 0) {
+			return(NULL);
+		}
+	}
+
+	m_start_lsn = log_reserve_and_open(len);
+
+	byte*	dst = log_reserve_for_copy(len);
+
+	m_end_lsn = log_close();
+
+	return(dst);
+}
+
+/** Copy the redo log records to the area returned by reserve_write().
+@param[in,out]	dst	reserved area in log_sys.buf */
+void
+mtr_t::Command::copy_reserved(
+	byte*	dst)
+{
+	mtr_copy_log_t	copy_log(dst);
+	m_impl->m_log.for_each_block(copy_log);
+
+	log_release_reserved();
+}
+
 /** Release the latches and blocks acquired by this mini-transaction */
 void
 mtr_t::Command::release_all()
@@ -892,8 +972,10 @@ mtr_t::Command::execute()
 {
 	ut_ad(m_impl->m_log_mode != MTR_LOG_NONE);
 
+	byte*	copy_to = NULL;
+
 	if (const ulint len = prepare_write()) {
-		finish_write(len);
+		copy_to = reserve_write(len);
 	}
 
 	if (m_impl->m_made_dirty) {
@@ -905,6 +987,14 @@ mtr_t::Command::execute()
 	to insert into the flush list. */
 	log_mutex_exit();
 
+	if (copy_to) {
+		/* The log block headers were already initialized.
+		Concurrent mini-transactions may copy their records
+		to the log buffer in parallel; log_write_up_to() will
+		wait for us in log_t::wait_for_pending_copies(). */
+		copy_reserved(copy_to);
+	}
+
 	m_impl->m_mtr->m_commit_lsn = m_end_lsn;
 
 	release_blocks();
@@ -58,6 +58,14 @@ Created 10/21/1995 Heikki Tuuri
 #include <libaio.h>
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+# include <algorithm>
+# include <linux/io_uring.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <sys/uio.h>
+#endif /* LINUX_IO_URING */
+
 #ifdef HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE
 # include <fcntl.h>
 # include <linux/falloc.h>
@@ -243,9 +251,15 @@ struct Slot {
 
 	/** aio array containing this slot */
 	AIO				*array;
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
+# ifdef LINUX_NATIVE_AIO
 	/** Linux control block for aio */
 	struct iocb		control;
+# endif /* LINUX_NATIVE_AIO */
+# ifdef LINUX_IO_URING
+	/** buffer descriptor of an io_uring request */
+	struct iovec		iov;
+# endif /* LINUX_IO_URING */
 
 	/** AIO return code */
 	int			ret;
@@ -268,6 +282,176 @@ struct Slot {
 
 };
 
+#ifdef LINUX_IO_URING
+/** An io_uring submission and completion queue pair, driven through
+the raw system calls so that no user space library is needed.
+There is one ring per AIO array, shared by all I/O handler threads of
+the array. Submission queue entries are produced and completion queue
+entries are consumed while holding the AIO::m_mutex of the array. */
+class IORing {
+public:
+	IORing() :
+		m_fd(-1),
+		m_sq_ring(MAP_FAILED),
+		m_cq_ring(MAP_FAILED),
+		m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED)),
+		m_timeout_armed(false)
+	{
+		memset(&m_params, 0x0, sizeof m_params);
+		memset(&m_timeout, 0x0, sizeof m_timeout);
+	}
+
+	~IORing() { close(); }
+
+	/** Set up the ring.
+	@param[in]	entries	maximum number of requests in flight
+	@return 0 on success, or -errno */
+	int open(unsigned entries);
+
+	/** Tear down the ring. */
+	void close();
+
+	/** Append a request to the submission queue. The request will
+	only be started by a subsequent enter().
+	Caller must hold the AIO::m_mutex.
+	@param[in]	opcode		IORING_OP_READV, IORING_OP_WRITEV,
+					IORING_OP_READ_FIXED,
+					IORING_OP_WRITE_FIXED,
+					IORING_OP_NOP or IORING_OP_TIMEOUT
+	@param[in]	fd		file descriptor, or -1
+	@param[in]	addr		buffer, iovec, or __kernel_timespec
+	@param[in]	len		length of the buffer, or number of
+					iovec or timespec elements
+	@param[in]	offset		file offset
+	@param[in]	user_data	Slot* of the request, or NULL
+	@param[in]	buf_index	index of the registered buffer */
+	void queue(
+		unsigned	opcode,
+		int		fd,
+		const void*	addr,
+		ulint		len,
+		os_offset_t	offset,
+		void*		user_data,
+		unsigned	buf_index = 0);
+
+	/** Queue a read or write of a slot, using a registered buffer
+	if the slot buffer is inside one.
+	Caller must hold the AIO::m_mutex.
+	@param[in,out]	slot	reserved slot */
+	void queue(Slot* slot);
+
+	/** @return number of queued requests that were not submitted */
+	unsigned n_unsubmitted() const
+	{
+		return(static_cast<unsigned>(
+			       my_atomic_load32_explicit(
+				       reinterpret_cast<int32*>(
+					       sq(m_params.sq_off.tail)),
+				       MY_MEMORY_ORDER_RELAXED)
+			       - my_atomic_load32_explicit(
+				       reinterpret_cast<int32*>(
+					       sq(m_params.sq_off.head)),
+				       MY_MEMORY_ORDER_ACQUIRE)));
+	}
+
+	/** Submit queued requests and optionally wait for completions.
+	@param[in]	to_submit	number of requests to submit
+	@param[in]	min_complete	number of completions to wait for
+	@return number of submitted requests, or -errno */
+	int enter(unsigned to_submit, unsigned min_complete);
+
+	/** Fetch the next completion.
+	Caller must hold the AIO::m_mutex.
+	@param[out]	user_data	user_data of the completed request
+	@param[out]	res		result of the request
+	@return whether a completion was available */
+	bool pop(void** user_data, int* res);
+
+	/** Arm the reaping timeout of the handler threads, unless it
+	is already pending. Caller must hold the AIO::m_mutex. */
+	void arm_timeout()
+	{
+		if (!m_timeout_armed) {
+			m_timeout_armed = true;
+			queue(IORING_OP_TIMEOUT, -1, &m_timeout, 1, 0, NULL);
+		}
+	}
+
+	/** Note that the reaping timeout has fired.
+	Caller must hold the AIO::m_mutex. */
+	void disarm_timeout() { m_timeout_armed = false; }
+
+	/** Register memory areas for IORING_OP_READ_FIXED and
+	IORING_OP_WRITE_FIXED, replacing any earlier registration.
+	Caller must not hold the AIO::m_mutex; the registered areas
+	are installed by the caller by invoking set_buffers().
+	@param[in]	buffers	memory areas
+	@param[in]	n	number of elements in buffers
+	@return 0 on success, or -errno */
+	int register_buffers(const os_aio_buffer_t* buffers, ulint n);
+
+	/** Install the registered memory areas for lookup by queue().
+	Caller must hold the AIO::m_mutex.
+	@param[in]	buffers	registered areas, sorted by address
+	@param[in]	n	number of elements in buffers */
+	void set_buffers(const os_aio_buffer_t* buffers, ulint n)
+	{
+		m_buffers.assign(buffers, buffers + n);
+	}
+
+	/** Check that the kernel supports what we need from io_uring.
+	@return whether io_uring can be used */
+	static bool is_supported();
+
+private:
+	/** ring file descriptor */
+	int			m_fd;
+	/** io_uring_setup() result */
+	io_uring_params		m_params;
+	/** the submission queue ring */
+	void*			m_sq_ring;
+	/** size of m_sq_ring */
+	size_t			m_sq_ring_size;
+	/** the completion queue ring */
+	void*			m_cq_ring;
+	/** size of m_cq_ring */
+	size_t			m_cq_ring_size;
+	/** the submission queue entries */
+	io_uring_sqe*		m_sqes;
+	/** whether an IORING_OP_TIMEOUT request is pending */
+	bool			m_timeout_armed;
+	/** timeout of the handler thread wait */
+	__kernel_timespec	m_timeout;
+	/** registered buffers, sorted by address */
+	std::vector<os_aio_buffer_t>	m_buffers;
+
+	/** Access a field of the submission queue ring.
+	@param[in]	offset	offset of the field
+	@return the field */
+	unsigned* sq(unsigned offset) const
+	{
+		return(reinterpret_cast<unsigned*>(
+			static_cast<byte*>(m_sq_ring) + offset));
+	}
+
+	/** Access a field of the completion queue ring.
+	@param[in]	offset	offset of the field
+	@return the field */
+	unsigned* cq(unsigned offset) const
+	{
+		return(reinterpret_cast<unsigned*>(
+			static_cast<byte*>(m_cq_ring) + offset));
+	}
+
+	/** Look up a registered buffer.
+	@param[in]	ptr	start of an I/O buffer
+	@param[in]	len	length of the I/O buffer
+	@return index of the registered buffer that contains the
+	I/O buffer, or ULINT_UNDEFINED */
+	ulint find_buffer(const byte* ptr, ulint len) const;
+};
+#endif /* LINUX_IO_URING */
+
 /** The asynchronous i/o array structure */
 class AIO {
 public:
@@ -429,6 +613,41 @@ class AIO {
 		MY_ATTRIBUTE((warn_unused_result));
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+	/** Queue an AIO request in the io_uring of the array.
+	@param[in,out]	slot	an already reserved slot
+	@param[in]	submit	whether to submit the request immediately;
+				if not, it will be submitted by the next
+				io_uring_submit() or by an I/O handler
+				thread */
+	void io_uring_dispatch(Slot* slot, bool submit);
+
+	/** Submit the requests that were queued in the io_uring. */
+	void io_uring_submit();
+
+	/** @return the io_uring of the array */
+	IORing* ring() const
+	{
+		ut_ad(m_ring != NULL);
+		return(m_ring);
+	}
+
+	/** Submit the queued io_uring requests of all arrays. */
+	static void io_uring_submit_all();
+
+	/** Wake up the I/O handler threads that are waiting for
+	io_uring completions. */
+	static void io_uring_wake_at_shutdown();
+
+	/** Register memory areas with the io_uring of the arrays
+	that are used for page I/O.
+	@param[in]	buffers	memory areas, sorted by address
+	@param[in]	n	number of elements in buffers */
+	static void io_uring_register_buffers(
+		const os_aio_buffer_t*	buffers,
+		ulint			n);
+#endif /* LINUX_IO_URING */
+
 #ifdef WIN_ASYNC_IO
 	HANDLE m_completion_port;
 	/** Wake up all AIO threads in Windows native aio */
@@ -580,6 +799,13 @@ class AIO {
 		MY_ATTRIBUTE((warn_unused_result));
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+	/** Initialise the io_uring of the array
+	@return DB_SUCCESS or error code */
+	dberr_t init_io_uring()
+		MY_ATTRIBUTE((warn_unused_result));
+#endif /* LINUX_IO_URING */
+
 private:
 	typedef std::vector<Slot> Slots;
 
@@ -622,6 +848,11 @@ class AIO {
 	IOEvents		m_events;
 #endif /* LINUX_NATIV_AIO */
 
+#ifdef LINUX_IO_URING
+	/** the io_uring, shared by all segments of the array, or NULL */
+	IORing*			m_ring;
+#endif /* LINUX_IO_URING */
+
 	/** The aio arrays for non-ibuf i/o and ibuf i/o, as well as
 	sync AIO. These are NULL when the module has not yet been
 	initialized. */
@@ -649,9 +880,12 @@ AIO*	AIO::s_ibuf;
 AIO*	AIO::s_log;
 AIO*	AIO::s_sync;
 
-#if defined(LINUX_NATIVE_AIO)
+#if defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 /** timeout for each io_getevents() call = 500ms. */
 static const ulint	OS_AIO_REAP_TIMEOUT = 500000000UL;
+#endif /* LINUX_NATIVE_AIO || LINUX_IO_URING */
+
+#if defined(LINUX_NATIVE_AIO)
 
 /** time to sleep, in microseconds if io_setup() returns EAGAIN. */
 static const ulint	OS_AIO_IO_SETUP_RETRY_SLEEP = 500000UL;
@@ -1090,10 +1324,12 @@ AIO::release(Slot* slot)
 		os_event_set(m_is_empty);
 	}
 
-#if defined(LINUX_NATIVE_AIO)
+#if defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 
 	if (srv_use_native_aio) {
+# ifdef LINUX_NATIVE_AIO
 		memset(&slot->control, 0x0, sizeof(slot->control));
+# endif /* LINUX_NATIVE_AIO */
 		slot->ret = 0;
 		slot->n_bytes = 0;
 	} else {
@@ -2072,174 +2308,1020 @@ AIO::linux_create_io_ctx(
 					<< " attempts before giving up.";
 			}
 
-			if (n_retries < OS_AIO_IO_SETUP_RETRY_ATTEMPTS) {
-
-				++n_retries;
+			if (n_retries < OS_AIO_IO_SETUP_RETRY_ATTEMPTS) {
+
+				++n_retries;
+
+				ib::warn()
+					<< "io_setup() attempt "
+					<< n_retries << ".";
+
+				os_thread_sleep(OS_AIO_IO_SETUP_RETRY_SLEEP);
+
+				continue;
+			}
+
+			/* Have tried enough. Better call it a day. */
+			ib::error()
+				<< "io_setup() failed with EAGAIN after "
+				<< OS_AIO_IO_SETUP_RETRY_ATTEMPTS
+				<< " attempts.";
+			break;
+
+		case -ENOSYS:
+			ib::error()
+				<< "Linux Native AIO interface"
+				" is not supported on this platform. Please"
+				" check your OS documentation and install"
+				" appropriate binary of InnoDB.";
+
+			break;
+
+		default:
+			ib::error()
+				<< "Linux Native AIO setup"
+				<< " returned following error["
+				<< ret << "]";
+			break;
+		}
+
+		ib::info()
+			<< "You can disable Linux Native AIO by"
+			" setting innodb_use_native_aio = 0 in my.cnf";
+
+		break;
+	}
+
+	return(false);
+}
+
+/** Checks if the system supports native linux aio. On some kernel
+versions where native aio is supported it won't work on tmpfs. In such
+cases we can't use native aio as it is not possible to mix simulated
+and native aio.
+@return: true if supported, false otherwise. */
+bool
+AIO::is_linux_native_aio_supported()
+{
+	int		fd;
+	io_context_t	io_ctx;
+	char		name[1000];
+
+	if (!linux_create_io_ctx(1, &io_ctx)) {
+
+		/* The platform does not support native aio. */
+
+		return(false);
+
+	} else if (!srv_read_only_mode) {
+
+		/* Now check if tmpdir supports native aio ops. */
+		fd = innobase_mysql_tmpfile(NULL);
+
+		if (fd < 0) {
+			ib::warn()
+				<< "Unable to create temp file to check"
+				" native AIO support.";
+
+			return(false);
+		}
+	} else {
+
+		os_normalize_path(srv_log_group_home_dir);
+
+		ulint	dirnamelen = strlen(srv_log_group_home_dir);
+
+		ut_a(dirnamelen < (sizeof name) - 10 - sizeof "ib_logfile");
+
+		memcpy(name, srv_log_group_home_dir, dirnamelen);
+
+		/* Add a path separator if needed. */
+		if (dirnamelen && name[dirnamelen - 1] != OS_PATH_SEPARATOR) {
+
+			name[dirnamelen++] = OS_PATH_SEPARATOR;
+		}
+
+		strcpy(name + dirnamelen, "ib_logfile0");
+
+		fd = open(name, O_RDONLY | O_CLOEXEC);
+
+		if (fd == -1) {
+
+			ib::warn()
+				<< "Unable to open"
+				<< " \"" << name << "\" to check native"
+				<< " AIO read support.";
+
+			return(false);
+		}
+	}
+
+	struct io_event	io_event;
+
+	memset(&io_event, 0x0, sizeof(io_event));
+
+	byte*	buf = static_cast<byte*>(ut_malloc_nokey(srv_page_size * 2));
+	byte*	ptr = static_cast<byte*>(ut_align(buf, srv_page_size));
+
+	struct iocb	iocb;
+
+	/* Suppress valgrind warning. */
+	memset(buf, 0x00, srv_page_size * 2);
+	memset(&iocb, 0x0, sizeof(iocb));
+
+	struct iocb*	p_iocb = &iocb;
+
+	if (!srv_read_only_mode) {
+
+		io_prep_pwrite(p_iocb, fd, ptr, srv_page_size, 0);
+
+	} else {
+		ut_a(srv_page_size >= 512);
+		io_prep_pread(p_iocb, fd, ptr, 512, 0);
+	}
+
+	int	err = io_submit(io_ctx, 1, &p_iocb);
+
+	if (err >= 1) {
+		/* Now collect the submitted IO request. */
+		err = io_getevents(io_ctx, 1, 1, &io_event, NULL);
+	}
+
+	ut_free(buf);
+	close(fd);
+
+	switch (err) {
+	case 1:
+		return(true);
+
+	case -EINVAL:
+	case -ENOSYS:
+		ib::error()
+			<< "Linux Native AIO not supported. You can either"
+			" move "
+			<< (srv_read_only_mode ? name : "tmpdir")
+			<< " to a file system that supports native"
+			" AIO or you can set innodb_use_native_aio to"
+			" FALSE to avoid this message.";
+
+		/* fall through. */
+	default:
+		ib::error()
+			<< "Linux Native AIO check on "
+			<< (srv_read_only_mode ? name : "tmpdir")
+			<< "returned error[" << -err << "]";
+	}
+
+	return(false);
+}
+
+#endif /* LINUX_NATIVE_AIO */
+
+#ifdef LINUX_IO_URING
+/** Maximum size of a buffer that can be registered with io_uring */
+static const ulint	OS_AIO_IO_URING_MAX_BUFFER_SIZE = 1UL << 30;
+
+/** Maximum number of buffers that can be registered with io_uring
+(UIO_MAXIOV) */
+static const ulint	OS_AIO_IO_URING_MAX_BUFFERS = 1024;
+
+/** Set up the ring.
+@param[in]	entries	maximum number of requests in flight
+@return 0 on success, or -errno */
+int
+IORing::open(unsigned entries)
+{
+	ut_ad(m_fd == -1);
+
+	memset(&m_params, 0x0, sizeof m_params);
+
+	int	fd = static_cast<int>(
+		syscall(__NR_io_uring_setup, entries, &m_params));
+
+	if (fd < 0) {
+		return(-errno);
+	}
+
+	m_fd = fd;
+
+	m_sq_ring_size = m_params.sq_off.array
+		+ m_params.sq_entries * sizeof(unsigned);
+	m_cq_ring_size = m_params.cq_off.cqes
+		+ m_params.cq_entries * sizeof(io_uring_cqe);
+
+	m_sq_ring = mmap(NULL, m_sq_ring_size, PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+	m_cq_ring = mmap(NULL, m_cq_ring_size, PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+	m_sqes = static_cast<io_uring_sqe*>(
+		mmap(NULL, m_params.sq_entries * sizeof *m_sqes,
+		     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		     m_fd, IORING_OFF_SQES));
+
+	if (m_sq_ring == MAP_FAILED || m_cq_ring == MAP_FAILED
+	    || m_sqes == MAP_FAILED) {
+		int	err = -errno;
+		close();
+		return(err);
+	}
+
+	m_timeout.tv_sec = 0;
+	m_timeout.tv_nsec = OS_AIO_REAP_TIMEOUT;
+
+	return(0);
+}
+
+/** Tear down the ring. */
+void
+IORing::close()
+{
+	if (m_sqes != MAP_FAILED) {
+		munmap(m_sqes, m_params.sq_entries * sizeof *m_sqes);
+		m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+	}
+
+	if (m_cq_ring != MAP_FAILED) {
+		munmap(m_cq_ring, m_cq_ring_size);
+		m_cq_ring = MAP_FAILED;
+	}
+
+	if (m_sq_ring != MAP_FAILED) {
+		munmap(m_sq_ring, m_sq_ring_size);
+		m_sq_ring = MAP_FAILED;
+	}
+
+	if (m_fd != -1) {
+		/* This also drops any registered buffers. */
+		::close(m_fd);
+		m_fd = -1;
+	}
+
+	m_buffers.clear();
+}
+
+/** Append a request to the submission queue. The request will
+only be started by a subsequent enter().
+Caller must hold the AIO::m_mutex.
+@param[in]	opcode		IORING_OP_READV, IORING_OP_WRITEV,
+				IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED,
+				IORING_OP_NOP or IORING_OP_TIMEOUT
+@param[in]	fd		file descriptor, or -1
+@param[in]	addr		buffer, iovec, or __kernel_timespec
+@param[in]	len		length of the buffer, or number of
+				iovec or timespec elements
+@param[in]	offset		file offset
+@param[in]	user_data	Slot* of the request, or NULL
+@param[in]	buf_index	index of the registered buffer */
+void
+IORing::queue(
+	unsigned	opcode,
+	int		fd,
+	const void*	addr,
+	ulint		len,
+	os_offset_t	offset,
+	void*		user_data,
+	unsigned	buf_index)
+{
+	ut_ad(m_fd != -1);
+
+	unsigned*	tail = sq(m_params.sq_off.tail);
+	unsigned	t = *tail;
+
+	/* The ring has room for every slot of the AIO array,
+	and for the timeout and wake-up requests. */
+	ut_a(t - static_cast<unsigned>(my_atomic_load32_explicit(
+			reinterpret_cast<int32*>(sq(m_params.sq_off.head)),
+			MY_MEMORY_ORDER_ACQUIRE))
+	     < m_params.sq_entries);
+
+	unsigned	index = t & *sq(m_params.sq_off.ring_mask);
+	io_uring_sqe*	sqe = &m_sqes[index];
+
+	memset(sqe, 0x0, sizeof *sqe);
+
+	sqe->opcode = static_cast<__u8>(opcode);
+	sqe->fd = fd;
+	sqe->off = offset;
+	sqe->addr = reinterpret_cast<uintptr_t>(addr);
+	sqe->len = static_cast<__u32>(len);
+	sqe->buf_index = static_cast<__u16>(buf_index);
+	sqe->user_data = reinterpret_cast<uintptr_t>(user_data);
+
+	sq(m_params.sq_off.array)[index] = index;
+
+	/* Publish the entry to the kernel. */
+	my_atomic_store32_explicit(reinterpret_cast<int32*>(tail),
+				   static_cast<int32>(t + 1),
+				   MY_MEMORY_ORDER_RELEASE);
+}
+
+/** Queue a read or write of a slot, using a registered buffer
+if the slot buffer is inside one.
+Caller must hold the AIO::m_mutex.
+@param[in,out]	slot	reserved slot */
+void
+IORing::queue(Slot* slot)
+{
+	ut_ad(slot->is_reserved);
+	ut_ad(!slot->io_already_done);
+
+	compile_time_assert(sizeof(off_t) >= sizeof(os_offset_t));
+
+	bool	is_read = slot->type.is_read();
+	ulint	buf_index = find_buffer(slot->ptr, slot->len);
+
+	if (buf_index != ULINT_UNDEFINED) {
+		queue(is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED,
+		      slot->file, slot->ptr, slot->len, slot->offset, slot,
+		      static_cast<unsigned>(buf_index));
+	} else {
+		slot->iov.iov_base = slot->ptr;
+		slot->iov.iov_len = slot->len;
+
+		queue(is_read ? IORING_OP_READV : IORING_OP_WRITEV,
+		      slot->file, &slot->iov, 1, slot->offset, slot);
+	}
+}
+
+/** Submit queued requests and optionally wait for completions.
+@param[in]	to_submit	number of requests to submit
+@param[in]	min_complete	number of completions to wait for
+@return number of submitted requests, or -errno */
+int
+IORing::enter(unsigned to_submit, unsigned min_complete)
+{
+	if (to_submit == 0 && min_complete == 0) {
+		return(0);
+	}
+
+	/* If another thread already submitted some of the queued
+	requests, the kernel will submit only the remaining ones. */
+	int	ret = static_cast<int>(
+		syscall(__NR_io_uring_enter, m_fd, to_submit, min_complete,
+			min_complete ? IORING_ENTER_GETEVENTS : 0,
+			NULL, 0));
+
+	return(ret < 0 ? -errno : ret);
+}
+
+/** Fetch the next completion.
+Caller must hold the AIO::m_mutex.
+@param[out]	user_data	user_data of the completed request
+@param[out]	res		result of the request
+@return whether a completion was available */
+bool
+IORing::pop(void** user_data, int* res)
+{
+	unsigned*	head = cq(m_params.cq_off.head);
+	unsigned	h = *head;
+
+	if (h == static_cast<unsigned>(my_atomic_load32_explicit(
+			reinterpret_cast<int32*>(cq(m_params.cq_off.tail)),
+			MY_MEMORY_ORDER_ACQUIRE))) {
+		return(false);
+	}
+
+	const io_uring_cqe*	cqe = reinterpret_cast<const io_uring_cqe*>(
+		static_cast<byte*>(m_cq_ring) + m_params.cq_off.cqes)
+		+ (h & *cq(m_params.cq_off.ring_mask));
+
+	*user_data = reinterpret_cast<void*>(cqe->user_data);
+	*res = cqe->res;
+
+	/* Let the kernel reuse the entry. */
+	my_atomic_store32_explicit(reinterpret_cast<int32*>(head),
+				   static_cast<int32>(h + 1),
+				   MY_MEMORY_ORDER_RELEASE);
+	return(true);
+}
+
+/** Register memory areas for IORING_OP_READ_FIXED and
+IORING_OP_WRITE_FIXED, replacing any earlier registration.
+@param[in]	buffers	memory areas
+@param[in]	n	number of elements in buffers
+@return 0 on success, or -errno */
+int
+IORing::register_buffers(const os_aio_buffer_t* buffers, ulint n)
+{
+	/* This fails with ENXIO if nothing was registered. */
+	syscall(__NR_io_uring_register, m_fd, IORING_UNREGISTER_BUFFERS,
+		NULL, 0);
+
+	if (n == 0) {
+		return(0);
+	}
+
+	std::vector<struct iovec>	iov(n);
+
+	for (ulint i = 0; i < n; ++i) {
+		iov[i].iov_base = const_cast<byte*>(buffers[i].mem);
+		iov[i].iov_len = buffers[i].size;
+	}
+
+	int	ret = static_cast<int>(
+		syscall(__NR_io_uring_register, m_fd,
+			IORING_REGISTER_BUFFERS, &iov[0],
+			static_cast<unsigned>(n)));
+
+	return(ret < 0 ? -errno : 0);
+}
+
+/** Look up a registered buffer.
+@param[in]	ptr	start of an I/O buffer
+@param[in]	len	length of the I/O buffer
+@return index of the registered buffer that contains the I/O buffer,
+or ULINT_UNDEFINED */
+ulint
+IORing::find_buffer(const byte* ptr, ulint len) const
+{
+	/* Find the last area that starts at or before ptr. */
+	ulint	low = 0;
+	ulint	high = m_buffers.size();
+
+	while (low < high) {
+		ulint	mid = (low + high) / 2;
+
+		if (m_buffers[mid].mem <= ptr) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (low == 0) {
+		return(ULINT_UNDEFINED);
+	}
+
+	const os_aio_buffer_t&	b = m_buffers[low - 1];
+
+	return(ptr + len <= b.mem + b.size ? low - 1 : ULINT_UNDEFINED);
+}
+
+/** Check that the kernel supports what we need from io_uring.
+@return whether io_uring can be used */
+bool
+IORing::is_supported()
+{
+	IORing	ring;
+	int	err = ring.open(4);
+
+	if (err != 0) {
+		ib::error() << "io_uring_setup() failed: " << strerror(-err);
+
+		if (err == -ENOMEM) {
+			ib::info() << "Consider increasing the locked memory"
+				" limit (ulimit -l).";
+		}
+
+		return(false);
+	}
+
+	/* IORING_OP_TIMEOUT is needed by the I/O handler threads.
+	Older kernels complete unknown requests with -EINVAL. */
+	__kernel_timespec	timeout;
+
+	timeout.tv_sec = 0;
+	timeout.tv_nsec = 1;
+
+	ring.queue(IORING_OP_NOP, -1, NULL, 0, 0, &ring);
+	ring.queue(IORING_OP_TIMEOUT, -1, &timeout, 1, 0, NULL);
+
+	err = ring.enter(ring.n_unsubmitted(), 2);
+
+	for (ulint n = 0; err >= 0 && n < 2; ) {
+		void*	user_data;
+		int	res;
+
+		if (!ring.pop(&user_data, &res)) {
+			err = ring.enter(0, 1);
+		} else if (res == -EINVAL) {
+			err = res;
+		} else {
+			++n;
+		}
+	}
+
+	if (err < 0) {
+		ib::error() << "io_uring does not support the required"
+			" operations: " << strerror(-err);
+		return(false);
+	}
+
+	return(true);
+}
+
+/** io_uring completion handler. All I/O handler threads of an AIO
+array share the io_uring of the array, so that any of them can reap
+and process any completed request of the array. */
+class IOUringHandler {
+public:
+	/**
+	@param[in] global_segment	The global segment*/
+	IOUringHandler(ulint global_segment)
+		:
+		m_global_segment(global_segment)
+	{
+		/* Should never be doing Sync IO here. */
+		ut_a(m_global_segment != ULINT_UNDEFINED);
+
+		/* Find the array and the local segment. */
+
+		m_segment = AIO::get_array_and_local_segment(
+			&m_array, m_global_segment);
+	}
+
+	/**
+	Process an io_uring request
+	@param[out]	m1		the messages passed with the
+	@param[out]	m2		AIO request; note that in case the
+					AIO operation failed, these output
+					parameters are valid and can be used to
+					restart the operation.
+	@param[out]	request		IO context
+	@return DB_SUCCESS or error code */
+	dberr_t poll(fil_node_t** m1, void** m2, IORequest* request);
+
+private:
+	/** Resubmit an IO request that was only partially successful
+	@param[in,out]	slot		Request to resubmit */
+	void resubmit(Slot* slot);
+
+	/** Check if the AIO succeeded
+	@param[in,out]	slot		The slot to check
+	@return DB_SUCCESS, DB_FAIL if the operation should be retried or
+		DB_IO_ERROR on all other errors */
+	dberr_t	check_state(Slot* slot);
+
+	/** @return true if a shutdown was detected */
+	bool is_shutdown() const
+	{
+		return(srv_shutdown_state == SRV_SHUTDOWN_EXIT_THREADS
+		       && !buf_page_cleaner_is_active);
+	}
+
+	/** If no slot was found then the m_array->m_mutex will be released.
+	@param[out]	n_pending	The number of pending IOs
+	@return NULL or a slot that has completed IO */
+	Slot* find_completed_slot(ulint* n_pending);
+
+	/** Submit any queued requests of the array, wait for
+	completions and mark the completed slots. The wait is bounded
+	by an IORING_OP_TIMEOUT request, so that the thread can check
+	the server status periodically. */
+	void collect();
+
+private:
+	/** Slot array */
+	AIO*			m_array;
+
+	/** The local segment, where the search for completed
+	requests starts */
+	ulint			m_segment;
+
+	/** The global segment */
+	ulint			m_global_segment;
+};
+
+/** Resubmit an IO request that was only partially successful
+@param[in,out]	slot		Request to resubmit */
+void
+IOUringHandler::resubmit(Slot* slot)
+{
+	ut_ad(m_array->is_mutex_owned());
+	ut_ad(slot->len >= static_cast<ulint>(slot->n_bytes));
+
+	slot->len -= slot->n_bytes;
+	slot->ptr += slot->n_bytes;
+	slot->offset += slot->n_bytes;
+
+	/* Resetting the bytes read/written */
+	slot->n_bytes = 0;
+	slot->io_already_done = false;
+
+	IORing*	ring = m_array->ring();
+
+	ring->queue(slot);
+
+	/* If this fails, the request remains queued, and it will be
+	submitted by the next io_uring_enter() call. */
+	ring->enter(ring->n_unsubmitted(), 0);
+}
+
+/** Check if the AIO succeeded
+@param[in,out]	slot		The slot to check
+@return DB_SUCCESS, DB_FAIL if the operation should be retried or
+	DB_IO_ERROR on all other errors */
+dberr_t
+IOUringHandler::check_state(Slot* slot)
+{
+	ut_ad(m_array->is_mutex_owned());
+
+	srv_set_io_thread_op_info(
+		m_global_segment, "processing completed aio requests");
+
+	ut_ad(slot->io_already_done);
+
+	if (slot->ret == 0) {
+		return(AIOHandler::post_io_processing(slot));
+	}
+
+	errno = -slot->ret;
+
+	os_file_handle_error(slot->name, "io_uring");
+
+	return(DB_IO_ERROR);
+}
+
+/** If no slot was found then the m_array->m_mutex will be released.
+@param[out]	n_pending		The number of pending IOs
+@return NULL or a slot that has completed IO */
+Slot*
+IOUringHandler::find_completed_slot(ulint* n_pending)
+{
+	ulint	n_slots = m_array->slots_per_segment()
+		* m_array->get_n_segments();
+	ulint	offset = m_array->slots_per_segment() * m_segment;
+
+	*n_pending = 0;
+
+	m_array->acquire();
+
+	/* Start from our own segment, so that the handler threads
+	of the array tend to pick different requests. */
+	for (ulint i = 0; i < n_slots; ++i) {
+
+		Slot*	slot = m_array->at((offset + i) % n_slots);
+
+		if (slot->is_reserved) {
+
+			++*n_pending;
+
+			if (slot->io_already_done) {
+
+				/* Something for us to work on.
+				Note: We don't release the mutex. */
+				return(slot);
+			}
+		}
+	}
+
+	m_array->release();
+
+	return(NULL);
+}
+
+/** Submit any queued requests of the array, wait for completions and
+mark the completed slots. */
+void
+IOUringHandler::collect()
+{
+	IORing*	ring = m_array->ring();
+
+	m_array->acquire();
+	ring->arm_timeout();
+	m_array->release();
+
+	int	ret = ring->enter(ring->n_unsubmitted(), 1);
+
+	switch (ret) {
+	case -EAGAIN:
+	case -EBUSY:
+		/* Not enough resources! Try again. */
+		os_thread_yield();
+		/* fall through */
+	case -EINTR:
+		/* Some completions may be available. */
+		break;
+	default:
+		if (ret < 0) {
+			ib::fatal()
+				<< "Unexpected ret_code[" << ret
+				<< "] from io_uring_enter()!";
+		}
+	}
+
+	for (;;) {
+		Slot*	slots[64];
+		int	res[64];
+		ulint	n = 0;
+
+		m_array->acquire();
+
+		void*	user_data;
+
+		while (n < UT_ARR_SIZE(slots)
+		       && ring->pop(&user_data, &res[n])) {
+			if (user_data == NULL) {
+				ring->disarm_timeout();
+			} else if (user_data != ring) {
+				/* Any other completion than a timeout
+				or a wake-up is for a slot. */
+				slots[n++] = static_cast<Slot*>(user_data);
+			}
+		}
+
+		m_array->release();
+
+		for (ulint i = 0; i < n; ++i) {
+			Slot*	slot = slots[i];
+
+			ut_a(slot->is_reserved);
+			ut_a(!slot->io_already_done);
+
+			/* Deallocate unused blocks from file system.
+			This is newer done to page 0 or to log files.*/
+			if (slot->offset > 0
+			    && !slot->type.is_log()
+			    && slot->type.is_write()
+			    && slot->type.punch_hole()) {
+
+				slot->err = slot->type.punch_hole(
+					slot->file,
+					slot->offset, slot->len);
+			} else {
+				slot->err = DB_SUCCESS;
+			}
+		}
+
+		if (n == 0) {
+			break;
+		}
+
+		/* Mark the requests as completed. The error handling
+		will be done in the calling function. */
+		m_array->acquire();
+
+		for (ulint i = 0; i < n; ++i) {
+			Slot*	slot = slots[i];
+
+			if (res[i] < 0) {
+				slot->ret = res[i];
+				slot->n_bytes = 0;
+			} else {
+				slot->ret = 0;
+				slot->n_bytes = res[i];
+			}
+
+			slot->io_already_done = true;
+		}
+
+		m_array->release();
+
+		if (n < UT_ARR_SIZE(slots)) {
+			break;
+		}
+	}
+}
+
+/** Process an io_uring request
+@param[out]	m1		the messages passed with the
+@param[out]	m2		AIO request; note that in case the
+				AIO operation failed, these output
+				parameters are valid and can be used to
+				restart the operation.
+@param[out]	request		IO context
+@return DB_SUCCESS or error code */
+dberr_t
+IOUringHandler::poll(fil_node_t** m1, void** m2, IORequest* request)
+{
+	dberr_t		err = DB_SUCCESS;
+	Slot*		slot;
+
+	/* Loop until we have found a completed request. */
+	for (;;) {
+
+		ulint	n_pending;
+
+		slot = find_completed_slot(&n_pending);
+
+		if (slot != NULL) {
+
+			ut_ad(m_array->is_mutex_owned());
+
+			err = check_state(slot);
+
+			/* DB_FAIL is not a hard error, we should retry */
+			if (err != DB_FAIL) {
+				break;
+			}
+
+			/* Partial IO, resubmit request for
+			remaining bytes to read/write */
+			resubmit(slot);
 
-				ib::warn()
-					<< "io_setup() attempt "
-					<< n_retries << ".";
+			m_array->release();
 
-				os_thread_sleep(OS_AIO_IO_SETUP_RETRY_SLEEP);
+		} else if (is_shutdown() && n_pending == 0) {
 
-				continue;
-			}
+			/* There is no completed request. If there is
+			no pending request at all, and the system is
+			being shut down, exit. */
 
-			/* Have tried enough. Better call it a day. */
-			ib::error()
-				<< "io_setup() failed with EAGAIN after "
-				<< OS_AIO_IO_SETUP_RETRY_ATTEMPTS
-				<< " attempts.";
-			break;
+			*m1 = NULL;
+			*m2 = NULL;
 
-		case -ENOSYS:
-			ib::error()
-				<< "Linux Native AIO interface"
-				" is not supported on this platform. Please"
-				" check your OS documentation and install"
-				" appropriate binary of InnoDB.";
+			return(DB_SUCCESS);
 
-			break;
+		} else {
 
-		default:
-			ib::error()
-				<< "Linux Native AIO setup"
-				<< " returned following error["
-				<< ret << "]";
-			break;
-		}
+			/* Wait for some request. Note that we return
+			from wait if we have found a request. */
 
-		ib::info()
-			<< "You can disable Linux Native AIO by"
-			" setting innodb_use_native_aio = 0 in my.cnf";
+			srv_set_io_thread_op_info(
+				m_global_segment,
+				"waiting for completed aio requests");
 
-		break;
+			collect();
+		}
 	}
 
-	return(false);
-}
+	*m1 = slot->m1;
+	*m2 = slot->m2;
 
-/** Checks if the system supports native linux aio. On some kernel
-versions where native aio is supported it won't work on tmpfs. In such
-cases we can't use native aio as it is not possible to mix simulated
-and native aio.
-@return: true if supported, false otherwise. */
-bool
-AIO::is_linux_native_aio_supported()
-{
-	int		fd;
-	io_context_t	io_ctx;
-	char		name[1000];
+	*request = slot->type;
 
-	if (!linux_create_io_ctx(1, &io_ctx)) {
+	m_array->release(slot);
 
-		/* The platform does not support native aio. */
+	m_array->release();
 
-		return(false);
+	return(err);
+}
 
-	} else if (!srv_read_only_mode) {
+/** This function is only used with io_uring.
+Waits for an aio operation to complete. NOTE: this function will also take
+care of freeing the aio slot, therefore no other thread is allowed to do the
+freeing!
+@param[in]	global_segment	segment number in the aio array
+				to wait for; any completed request
+				of the array may be returned
+@param[out]	m1		the messages passed with the
+@param[out]	m2			AIO request; note that in case the
+				AIO operation failed, these output
+				parameters are valid and can be used to
+				restart the operation.
+@param[out]	request		IO context
+@return DB_SUCCESS if the IO was successful */
+static
+dberr_t
+os_aio_io_uring_handler(
+	ulint		global_segment,
+	fil_node_t**	m1,
+	void**		m2,
+	IORequest*	request)
+{
+	return IOUringHandler(global_segment).poll(m1, m2, request);
+}
 
-		/* Now check if tmpdir supports native aio ops. */
-		fd = innobase_mysql_tmpfile(NULL);
+/** Queue an AIO request in the io_uring of the array.
+@param[in,out]	slot	an already reserved slot
+@param[in]	submit	whether to submit the request immediately */
+void
+AIO::io_uring_dispatch(Slot* slot, bool submit)
+{
+	ut_a(slot->is_reserved);
+	ut_ad(slot->type.validate());
 
-		if (fd < 0) {
-			ib::warn()
-				<< "Unable to create temp file to check"
-				" native AIO support.";
+	acquire();
+	m_ring->queue(slot);
+	release();
 
-			return(false);
-		}
-	} else {
+	if (submit) {
+		/* If this fails, the request remains queued, and it
+		will be submitted by the next io_uring_enter() call. */
+		m_ring->enter(m_ring->n_unsubmitted(), 0);
+	}
+}
 
-		os_normalize_path(srv_log_group_home_dir);
+/** Submit the requests that were queued in the io_uring. */
+void
+AIO::io_uring_submit()
+{
+	m_ring->enter(m_ring->n_unsubmitted(), 0);
+}
 
-		ulint	dirnamelen = strlen(srv_log_group_home_dir);
+/** Submit the queued io_uring requests of all arrays. */
+void
+AIO::io_uring_submit_all()
+{
+	AIO*	arrays[] = { s_reads, s_writes, s_ibuf, s_log };
 
-		ut_a(dirnamelen < (sizeof name) - 10 - sizeof "ib_logfile");
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); ++i) {
+		if (arrays[i] != NULL) {
+			arrays[i]->io_uring_submit();
+		}
+	}
+}
 
-		memcpy(name, srv_log_group_home_dir, dirnamelen);
+/** Wake up the I/O handler threads that are waiting for io_uring
+completions. */
+void
+AIO::io_uring_wake_at_shutdown()
+{
+	AIO*	arrays[] = { s_reads, s_writes, s_ibuf, s_log };
 
-		/* Add a path separator if needed. */
-		if (dirnamelen && name[dirnamelen - 1] != OS_PATH_SEPARATOR) {
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); ++i) {
+		AIO*	array = arrays[i];
 
-			name[dirnamelen++] = OS_PATH_SEPARATOR;
+		if (array == NULL) {
+			continue;
 		}
 
-		strcpy(name + dirnamelen, "ib_logfile0");
-
-		fd = open(name, O_RDONLY | O_CLOEXEC);
-
-		if (fd == -1) {
+		IORing*	ring = array->ring();
 
-			ib::warn()
-				<< "Unable to open"
-				<< " \"" << name << "\" to check native"
-				<< " AIO read support.";
+		array->acquire();
+		ring->queue(IORING_OP_NOP, -1, NULL, 0, 0, ring);
+		array->release();
 
-			return(false);
-		}
+		ring->enter(ring->n_unsubmitted(), 0);
 	}
+}
 
-	struct io_event	io_event;
-
-	memset(&io_event, 0x0, sizeof(io_event));
+/** Register memory areas with the io_uring of the arrays that are
+used for page I/O.
+@param[in]	buffers	memory areas, sorted by address
+@param[in]	n	number of elements in buffers */
+void
+AIO::io_uring_register_buffers(const os_aio_buffer_t* buffers, ulint n)
+{
+	AIO*	arrays[] = { s_reads, s_writes, s_ibuf };
 
-	byte*	buf = static_cast<byte*>(ut_malloc_nokey(srv_page_size * 2));
-	byte*	ptr = static_cast<byte*>(ut_align(buf, srv_page_size));
+	for (ulint i = 0; i < UT_ARR_SIZE(arrays); ++i) {
+		AIO*	array = arrays[i];
 
-	struct iocb	iocb;
+		if (array == NULL) {
+			continue;
+		}
 
-	/* Suppress valgrind warning. */
-	memset(buf, 0x00, srv_page_size * 2);
-	memset(&iocb, 0x0, sizeof(iocb));
+		IORing*	ring = array->ring();
 
-	struct iocb*	p_iocb = &iocb;
+		/* Stop submitting requests for the old buffers. */
+		array->acquire();
+		ring->set_buffers(NULL, 0);
+		array->release();
 
-	if (!srv_read_only_mode) {
+		int	err = ring->register_buffers(buffers, n);
 
-		io_prep_pwrite(p_iocb, fd, ptr, srv_page_size, 0);
+		if (err != 0) {
+			ib::info() << "Not using registered buffers for"
+				" io_uring: " << strerror(-err);
+			return;
+		}
 
-	} else {
-		ut_a(srv_page_size >= 512);
-		io_prep_pread(p_iocb, fd, ptr, 512, 0);
+		array->acquire();
+		ring->set_buffers(buffers, n);
+		array->release();
 	}
+}
 
-	int	err = io_submit(io_ctx, 1, &p_iocb);
+/** Compare memory areas by their start address.
+@param[in]	a	memory area
+@param[in]	b	memory area
+@return whether a starts before b */
+static
+bool
+os_aio_buffer_less(const os_aio_buffer_t& a, const os_aio_buffer_t& b)
+{
+	return(a.mem < b.mem);
+}
 
-	if (err >= 1) {
-		/* Now collect the submitted IO request. */
-		err = io_getevents(io_ctx, 1, 1, &io_event, NULL);
+/** Register memory areas for fixed-buffer io_uring reads and writes,
+replacing any earlier registration.
+@param[in]	buffers	memory areas
+@param[in]	n	number of elements in buffers; 0 to unregister */
+void
+os_aio_register_buffers(const os_aio_buffer_t* buffers, ulint n)
+{
+	if (!srv_use_io_uring) {
+		return;
 	}
 
-	ut_free(buf);
-	close(fd);
+	std::vector<os_aio_buffer_t>	areas;
 
-	switch (err) {
-	case 1:
-		return(true);
+	for (ulint i = 0; i < n; ++i) {
+		/* Split areas that exceed the kernel limit. */
+		for (ulint offset = 0; offset < buffers[i].size;
+		     offset += OS_AIO_IO_URING_MAX_BUFFER_SIZE) {
+			os_aio_buffer_t	area;
 
-	case -EINVAL:
-	case -ENOSYS:
-		ib::error()
-			<< "Linux Native AIO not supported. You can either"
-			" move "
-			<< (srv_read_only_mode ? name : "tmpdir")
-			<< " to a file system that supports native"
-			" AIO or you can set innodb_use_native_aio to"
-			" FALSE to avoid this message.";
+			area.mem = buffers[i].mem + offset;
+			area.size = std::min(buffers[i].size - offset,
+					     OS_AIO_IO_URING_MAX_BUFFER_SIZE);
+			areas.push_back(area);
+		}
+	}
 
-		/* fall through. */
-	default:
-		ib::error()
-			<< "Linux Native AIO check on "
-			<< (srv_read_only_mode ? name : "tmpdir")
-			<< "returned error[" << -err << "]";
+	std::sort(areas.begin(), areas.end(), os_aio_buffer_less);
+
+	if (areas.size() > OS_AIO_IO_URING_MAX_BUFFERS) {
+		/* I/O on the rest of the areas will not use
+		registered buffers. */
+		areas.resize(OS_AIO_IO_URING_MAX_BUFFERS);
 	}
 
-	return(false);
+	AIO::io_uring_register_buffers(
+		areas.empty() ? NULL : &areas[0], areas.size());
 }
-
-#endif /* LINUX_NATIVE_AIO */
+#endif /* LINUX_IO_URING */
 
 /** Retrieves the last error number if an error occurs in a file io function.
 The number should be retrieved before any other OS calls (because they may
@@ -5529,6 +6611,14 @@ os_aio_handler(
 {
 	dberr_t	err;
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		srv_set_io_thread_op_info(segment, "io_uring handle");
+
+		return(os_aio_io_uring_handler(segment, m1, m2, request));
+	}
+#endif /* LINUX_IO_URING */
+
 	if (srv_use_native_aio) {
 		srv_set_io_thread_op_info(segment, "native aio handle");
 
@@ -5581,6 +6671,9 @@ AIO::AIO(
 	,m_aio_ctx(),
 	m_events(m_slots.size())
 # endif /* LINUX_NATIVE_AIO */
+# ifdef LINUX_IO_URING
+	,m_ring()
+# endif /* LINUX_IO_URING */
 #ifdef WIN_ASYNC_IO
 	,m_completion_port(new_completion_port())
 #endif
@@ -5616,13 +6709,15 @@ AIO::init_slots()
 
 		slot.array = this;
 
-#elif defined(LINUX_NATIVE_AIO)
+#elif defined(LINUX_NATIVE_AIO) || defined(LINUX_IO_URING)
 
 		slot.ret = 0;
 
 		slot.n_bytes = 0;
 
+# ifdef LINUX_NATIVE_AIO
 		memset(&slot.control, 0x0, sizeof(slot.control));
+# endif /* LINUX_NATIVE_AIO */
 
 #endif /* WIN_ASYNC_IO */
 	}
@@ -5680,12 +6775,60 @@ AIO::init_linux_native_aio()
 }
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+/** Initialise the io_uring of the array */
+dberr_t
+AIO::init_io_uring()
+{
+	ut_a(m_ring == NULL);
+
+	m_ring = UT_NEW_NOKEY(IORing());
+
+	if (m_ring == NULL) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	/* Besides the slots, leave room for the timeout and
+	wake-up requests of the I/O handler threads. */
+	int	err = m_ring->open(static_cast<unsigned>(m_slots.size() + 2));
+
+	if (err != 0) {
+		/* Like in init_linux_native_aio(), fall back to
+		simulated AIO for all arrays. */
+		ib::warn()
+			<< "io_uring disabled because io_uring_setup()"
+			" failed: " << strerror(-err) << ". To get rid of"
+			" this warning you can try increasing the locked"
+			" memory limit or setting innodb_use_io_uring = 0"
+			" in my.cnf";
+
+		UT_DELETE(m_ring);
+		m_ring = NULL;
+		srv_use_io_uring = FALSE;
+		srv_use_native_aio = FALSE;
+	}
+
+	return(DB_SUCCESS);
+}
+#endif /* LINUX_IO_URING */
+
 /** Initialise the array */
 dberr_t
 AIO::init()
 {
 	ut_a(!m_slots.empty());
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		dberr_t	err = init_io_uring();
+
+		if (err != DB_SUCCESS) {
+			return(err);
+		}
+
+		return(init_slots());
+	}
+#endif /* LINUX_IO_URING */
 
 	if (srv_use_native_aio) {
 #ifdef LINUX_NATIVE_AIO
@@ -5750,6 +6893,9 @@ AIO::~AIO()
 		ut_free(m_aio_ctx);
 	}
 #endif /* LINUX_NATIVE_AIO */
+#ifdef LINUX_IO_URING
+	UT_DELETE(m_ring);
+#endif /* LINUX_IO_URING */
 #if defined(WIN_ASYNC_IO)
 	CloseHandle(m_completion_port);
 #endif
@@ -5776,9 +6922,25 @@ AIO::start(
 	ulint		n_writers,
 	ulint		n_slots_sync)
 {
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		if (IORing::is_supported()) {
+			ib::info() << "Using io_uring";
+		} else {
+			ib::warn() << "io_uring disabled.";
+
+			srv_use_io_uring = FALSE;
+# ifndef LINUX_NATIVE_AIO
+			srv_use_native_aio = FALSE;
+# endif /* !LINUX_NATIVE_AIO */
+		}
+	}
+#endif /* LINUX_IO_URING */
+
 #if defined(LINUX_NATIVE_AIO)
 	/* Check if native aio is supported on this system and tmpfs */
-	if (srv_use_native_aio && !is_linux_native_aio_supported()) {
+	if (srv_use_native_aio && !srv_use_io_uring
+	    && !is_linux_native_aio_supported()) {
 
 		ib::warn() << "Linux Native AIO disabled.";
 
@@ -5963,6 +7125,14 @@ os_aio_wake_all_threads_at_shutdown()
 	No need to do anything to wake them up. */
 #endif /* !WIN_ASYNC_AIO */
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		/* The io_uring handler threads wait with a timeout
+		as well, but let them exit without delay. */
+		AIO::io_uring_wake_at_shutdown();
+	}
+#endif /* LINUX_IO_URING */
+
 	if (srv_use_native_aio) {
 		return;
 	}
@@ -6082,6 +7252,14 @@ AIO::reserve_slot(
 
 			os_aio_simulated_wake_handler_threads();
 		}
+#ifdef LINUX_IO_URING
+		else if (srv_use_io_uring) {
+			/* Submit the requests that were posted
+			with IORequest::DO_NOT_WAKE */
+
+			io_uring_submit();
+		}
+#endif /* LINUX_IO_URING */
 
 		os_event_wait(m_not_full);
 	}
@@ -6150,8 +7328,9 @@ AIO::reserve_slot(
 	}
 #elif defined(LINUX_NATIVE_AIO)
 
-	/* If we are not using native AIO skip this part. */
-	if (srv_use_native_aio) {
+	/* If we are not using native AIO skip this part.
+	With io_uring, the request is prepared by IORing::queue(). */
+	if (srv_use_native_aio && !srv_use_io_uring) {
 
 		off_t		aio_offset;
 
@@ -6244,6 +7423,14 @@ void
 os_aio_simulated_wake_handler_threads()
 {
 	if (srv_use_native_aio) {
+#ifdef LINUX_IO_URING
+		if (srv_use_io_uring) {
+			/* Submit the batch of requests that were
+			posted with IORequest::DO_NOT_WAKE */
+
+			AIO::io_uring_submit_all();
+		}
+#endif /* LINUX_IO_URING */
 		/* We do not use simulated aio: do nothing */
 
 		return;
@@ -6542,6 +7729,25 @@ os_aio_func(
 
 	slot = array->reserve_slot(type, m1, m2, file, name, buf, offset, n);
 
+#ifdef LINUX_IO_URING
+	if (srv_use_io_uring) {
+		if (type.is_read()) {
+			++os_n_file_reads;
+			os_bytes_read_since_printout += n;
+		} else {
+			ut_ad(type.is_write());
+			++os_n_file_writes;
+		}
+
+		/* Requests that are posted with IORequest::DO_NOT_WAKE
+		will be submitted in a batch by
+		os_aio_simulated_wake_handler_threads(). */
+		array->io_uring_dispatch(slot, type.is_wake());
+
+		return(DB_SUCCESS);
+	}
+#endif /* LINUX_IO_URING */
+
 	if (type.is_read()) {
 
 
@@ -177,13 +177,10 @@ will mark their views as closed but not actually free their views.
 /**
   Creates a snapshot where exactly the transactions serialized before this
   point in time are seen in the view.
-
-  @param[in,out] trx transaction
 */
-inline void ReadView::snapshot(trx_t *trx)
+inline void ReadView::snapshot()
 {
-  trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
-  std::sort(m_ids.begin(), m_ids.end());
+  trx_sys.snapshot_ids(&m_ids, &m_low_limit_id, &m_low_limit_no);
   m_up_limit_id= m_ids.empty() ? m_low_limit_id : m_ids.front();
   ut_ad(m_up_limit_id <= m_low_limit_id);
 }
@@ -260,7 +257,7 @@ void ReadView::open(trx_t *trx)
     ut_ad(0);
   }
 
-  snapshot(trx);
+  snapshot();
 reopen:
   m_creator_trx_id= trx->id;
   m_state.store(READ_VIEW_STATE_OPEN, std::memory_order_release);
@@ -276,7 +273,7 @@ void ReadView::open(trx_t *trx)
 */
 void trx_sys_t::clone_oldest_view()
 {
-  purge_sys.view.snapshot(0);
+  purge_sys.view.snapshot();
   mutex_enter(&mutex);
   /* Find oldest view. */
   for (const trx_t *trx= UT_LIST_GET_FIRST(trx_list); trx;
@@ -2386,11 +2386,102 @@ row_log_table_apply_update(
 	goto func_exit;
 }
 
+/** Records of a row log block that are being applied in parallel by
+row_log_table_apply_block() */
+struct row_log_table_apply_ctx_t {
+	/** query graph */
+	que_thr_t*		thr;
+	/** for reporting duplicate key errors */
+	row_merge_dup_t*	dup;
+	/** position of DB_TRX_ID in the new clustered index */
+	ulint			new_trx_id_col;
+	/** first record */
+	const mrec_t*		mrec;
+	/** end of the block */
+	const mrec_t*		mrec_end;
+	/** number of threads */
+	ulint			n_parts;
+	/** number of threads that failed */
+	Atomic_counter<ulint>	n_failed;
+	/** whether the threads should exit */
+	bool			exit;
+};
+
+/** A thread of row_log_table_apply_block(), applying the records whose
+PRIMARY KEY hashes to the same partition */
+struct row_log_table_apply_job_t {
+	/** the records being applied */
+	row_log_table_apply_ctx_t*	ctx;
+	/** the partition that is applied by this thread */
+	ulint				part;
+	/** the thread, if not the calling thread */
+	os_thread_id_t			id;
+	/** set when the thread is to apply ctx or to exit */
+	os_event_t			start;
+	/** set when the thread has applied ctx */
+	os_event_t			done;
+	/** offsets of the records of the partition */
+	ulint*				offsets;
+	/** memory heap for the records of the partition */
+	mem_heap_t*			heap;
+	/** memory heap for allocating offsets */
+	mem_heap_t*			offsets_heap;
+	/** end of the last complete record of the block */
+	const mrec_t*			end;
+	/** DB_SUCCESS or error code */
+	dberr_t				error;
+};
+
+/** Determine whether a log record is to be applied by the current thread.
+If the log is applied by a single thread, account for the record in
+log->head.total.
+@param[in]	job	partition of a block, or NULL if single-threaded
+@param[in,out]	log	online rebuild log
+@param[in]	size	size of the log record, in bytes
+@param[in]	rec	record that starts with the PRIMARY KEY
+@param[in]	offsets	offsets of rec
+@return whether the record is to be applied */
+static
+bool
+row_log_table_apply_is_mine(
+	const row_log_table_apply_job_t*	job,
+	row_log_t*				log,
+	ulint					size,
+	const mrec_t*				rec,
+	const ulint*				offsets)
+{
+	if (job == NULL) {
+		log->head.total += size;
+		return(true);
+	}
+
+	/* All operations on a PRIMARY KEY value must be applied by the
+	same thread, in the order they were logged. The PRIMARY KEY is
+	unchanged and compared as a binary string; see
+	row_log_table_apply_n_parts(). The caller accounts for
+	log->head.total. */
+	ut_ad(log->same_pk);
+
+	const dict_index_t*	index = dict_table_get_first_index(log->table);
+	ulint			fold = 0;
+
+	for (ulint i = 0; i < index->n_uniq; i++) {
+		ulint		len;
+		const byte*	field = rec_get_nth_field(
+			rec, offsets, i, &len);
+
+		ut_ad(len != UNIV_SQL_NULL);
+		fold = ut_fold_ulint_pair(fold, ut_fold_binary(field, len));
+	}
+
+	return(fold % job->ctx->n_parts == job->part);
+}
+
 /******************************************************//**
 Applies an operation to a table that was rebuilt.
 @return NULL on failure (mrec corruption) or when out of data;
 pointer to next record on success */
-static MY_ATTRIBUTE((nonnull, warn_unused_result))
+static MY_ATTRIBUTE((nonnull(1,3,4,5,6,7,8,9), warn_unused_result))
 const mrec_t*
 row_log_table_apply_op(
 /*===================*/
@@ -2406,8 +2497,11 @@ row_log_table_apply_op(
 	mem_heap_t*		heap,		/*!< in/out: memory heap */
 	const mrec_t*		mrec,		/*!< in: merge record */
 	const mrec_t*		mrec_end,	/*!< in: end of buffer */
-	ulint*			offsets)	/*!< in/out: work area
+	ulint*			offsets,	/*!< in/out: work area
 						for parsing mrec */
+	const row_log_table_apply_job_t*job)	/*!< in: partition of
+						a block to apply, or NULL
+						to apply every record */
 {
 	row_log_t*	log	= dup->index->online_log;
 	dict_index_t*	new_index = dict_table_get_first_index(log->table);
@@ -2464,8 +2558,9 @@ row_log_table_apply_op(
 
 		if (next_mrec > mrec_end) {
 			return(NULL);
-		} else {
-			log->head.total += ulint(next_mrec - mrec_start);
+		} else if (row_log_table_apply_is_mine(
+				   job, log, ulint(next_mrec - mrec_start),
+				   mrec, offsets)) {
 			*error = row_log_table_apply_insert(
 				thr, mrec, offsets, offsets_heap,
 				heap, dup);
@@ -2495,11 +2590,13 @@ row_log_table_apply_op(
 			return(NULL);
 		}
 
-		log->head.total += ulint(next_mrec - mrec_start);
-
-		*error = row_log_table_apply_delete(
-			new_trx_id_col,
-			mrec, offsets, offsets_heap, heap, log);
+		if (row_log_table_apply_is_mine(
+			    job, log, ulint(next_mrec - mrec_start),
+			    mrec, offsets)) {
+			*error = row_log_table_apply_delete(
+				new_trx_id_col,
+				mrec, offsets, offsets_heap, heap, log);
+		}
 		break;
 
 	case ROW_T_UPDATE:
@@ -2649,12 +2746,16 @@ row_log_table_apply_op(
 		}
 
 		ut_ad(next_mrec <= mrec_end);
-		log->head.total += ulint(next_mrec - mrec_start);
 		dtuple_set_n_fields_cmp(old_pk, new_index->n_uniq);
 
-		*error = row_log_table_apply_update(
-			thr, new_trx_id_col,
-			mrec, offsets, offsets_heap, heap, dup, old_pk);
+		if (row_log_table_apply_is_mine(
+			    job, log, ulint(next_mrec - mrec_start),
+			    mrec, offsets)) {
+			*error = row_log_table_apply_update(
+				thr, new_trx_id_col,
+				mrec, offsets, offsets_heap, heap, dup,
+				old_pk);
+		}
 		break;
 	}
 
@@ -2717,6 +2818,285 @@ row_log_progress_inc_per_block()
 }
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
+/** Determine how many threads may apply a block of the log of a table
+that is being rebuilt. Operations on different rows can be applied in
+any order, unless the PRIMARY KEY is being changed, or a UNIQUE index
+or a FULLTEXT index could report conflicts between rows, or computing
+virtual columns would use the shared TABLE. The PRIMARY KEY values must
+be equal if and only if they are equal as binary strings.
+@param[in]	index	clustered index of the table being rebuilt
+@param[in]	trx	ALTER TABLE transaction
+@return number of threads
+@retval 1 if the log must be applied in a single thread */
+static
+ulint
+row_log_table_apply_n_parts(
+	const dict_index_t*	index,
+	const trx_t*		trx)
+{
+	const row_log_t*	log = index->online_log;
+	const ulint		n_threads = thd_ddl_threads(trx->mysql_thd);
+
+	if (n_threads <= 1 || !log->same_pk || log->table->fts
+	    || log->table->n_v_cols) {
+		return(1);
+	}
+
+	const dict_index_t*	new_index = dict_table_get_first_index(
+		log->table);
+
+	for (ulint i = 0; i < new_index->n_uniq; i++) {
+		const dict_col_t*	col = dict_index_get_nth_col(
+			new_index, i);
+
+		switch (col->mtype) {
+		case DATA_FIXBINARY:
+		case DATA_BINARY:
+			if (dtype_get_charset_coll(col->prtype)
+			    != DATA_MYSQL_BINARY_CHARSET_COLL) {
+				return(1);
+			}
+			/* fall through */
+		case DATA_INT:
+		case DATA_SYS:
+			continue;
+		}
+
+		return(1);
+	}
+
+	for (const dict_index_t* sec = dict_table_get_next_index(new_index);
+	     sec != NULL; sec = dict_table_get_next_index(sec)) {
+		if (sec->type & (DICT_UNIQUE | DICT_FTS)) {
+			return(1);
+		}
+	}
+
+	return(n_threads);
+}
+
+/** Apply the records of one partition of a block of the log of a table
+that is being rebuilt.
+@param[in,out]	job	partition of the block */
+static
+void
+row_log_table_apply_part(
+	row_log_table_apply_job_t*	job)
+{
+	row_log_table_apply_ctx_t*	ctx = job->ctx;
+	trx_t*			trx = thr_get_trx(ctx->thr);
+	const mrec_t*		mrec = ctx->mrec;
+
+	job->error = DB_SUCCESS;
+
+	while (mrec < ctx->mrec_end) {
+		if (trx_is_interrupted(trx)) {
+			job->error = DB_INTERRUPTED;
+			break;
+		}
+
+		if (ctx->n_failed) {
+			/* Another thread failed. Only its error
+			will be reported. */
+			break;
+		}
+
+		log_free_check();
+
+		const mrec_t*	next_mrec = row_log_table_apply_op(
+			ctx->thr, ctx->new_trx_id_col, ctx->dup, &job->error,
+			job->offsets_heap, job->heap, mrec, ctx->mrec_end,
+			job->offsets, job);
+
+		if (job->error != DB_SUCCESS || next_mrec == NULL) {
+			/* The last record continues in the next block;
+			the caller will apply it. */
+			break;
+		}
+
+		mrec = next_mrec;
+	}
+
+	if (job->error != DB_SUCCESS) {
+		ctx->n_failed++;
+	}
+
+	job->end = mrec;
+}
+
+/** Thread that applies its partition of each block of the log of a
+table that is being rebuilt, until row_log_table_apply_pool_free().
+@param[in,out]	arg	row_log_table_apply_job_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_log_table_apply_thread)(void* arg)
+{
+	row_log_table_apply_job_t*	job
+		= static_cast<row_log_table_apply_job_t*>(arg);
+
+	for (;;) {
+		os_event_wait(job->start);
+		os_event_reset(job->start);
+
+		if (job->ctx->exit) {
+			break;
+		}
+
+		row_log_table_apply_part(job);
+		os_event_set(job->done);
+	}
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Start the threads that apply blocks of the log of a table that is
+being rebuilt. They are kept for the whole row_log_table_apply_ops().
+@param[in]	thr		query graph
+@param[in,out]	dup		for reporting duplicate key errors
+@param[in]	new_trx_id_col	position of DB_TRX_ID in the new index
+@param[in]	n_parts		number of partitions, including the one
+				applied by the calling thread
+@return the partitions; jobs[0].ctx is the shared context */
+static
+row_log_table_apply_job_t*
+row_log_table_apply_pool_create(
+	que_thr_t*		thr,
+	row_merge_dup_t*	dup,
+	ulint			new_trx_id_col,
+	ulint			n_parts)
+{
+	ut_ad(n_parts > 1);
+
+	row_log_table_apply_ctx_t*	ctx
+		= UT_NEW_NOKEY(row_log_table_apply_ctx_t());
+
+	ctx->thr = thr;
+	ctx->dup = dup;
+	ctx->new_trx_id_col = new_trx_id_col;
+	ctx->n_parts = n_parts;
+	ctx->exit = false;
+
+	const dict_index_t*	index = dup->index;
+	const dict_index_t*	new_index = dict_table_get_first_index(
+		index->online_log->table);
+	const ulint		n_offsets = 1 + REC_OFFS_HEADER_SIZE
+		+ std::max<ulint>(index->n_fields,
+				  new_index->first_user_field());
+
+	row_log_table_apply_job_t*	jobs
+		= static_cast<row_log_table_apply_job_t*>(
+			ut_malloc_nokey(n_parts * sizeof *jobs));
+
+	for (ulint i = 0; i < n_parts; i++) {
+		jobs[i].ctx = ctx;
+		jobs[i].part = i;
+		jobs[i].start = i ? os_event_create(0) : NULL;
+		jobs[i].done = i ? os_event_create(0) : NULL;
+		jobs[i].offsets = static_cast<ulint*>(
+			ut_malloc_nokey(n_offsets * sizeof *jobs[i].offsets));
+		jobs[i].offsets[0] = n_offsets;
+		jobs[i].offsets[1] = dict_index_get_n_fields(index);
+		jobs[i].heap = mem_heap_create(srv_page_size);
+		jobs[i].offsets_heap = mem_heap_create(srv_page_size);
+	}
+
+	for (ulint i = 1; i < n_parts; i++) {
+		os_thread_create(row_log_table_apply_thread, &jobs[i],
+				 &jobs[i].id);
+	}
+
+	return(jobs);
+}
+
+/** Stop the threads that were started by
+row_log_table_apply_pool_create(), and free the partitions.
+@param[in,out]	jobs	partitions */
+static
+void
+row_log_table_apply_pool_free(
+	row_log_table_apply_job_t*	jobs)
+{
+	row_log_table_apply_ctx_t*	ctx = jobs[0].ctx;
+
+	ctx->exit = true;
+
+	for (ulint i = 1; i < ctx->n_parts; i++) {
+		os_event_set(jobs[i].start);
+	}
+
+	for (ulint i = 1; i < ctx->n_parts; i++) {
+		os_thread_join(jobs[i].id);
+		os_event_destroy(jobs[i].start);
+		os_event_destroy(jobs[i].done);
+	}
+
+	for (ulint i = 0; i < ctx->n_parts; i++) {
+		mem_heap_free(jobs[i].offsets_heap);
+		mem_heap_free(jobs[i].heap);
+		ut_free(jobs[i].offsets);
+	}
+
+	ut_free(jobs);
+	UT_DELETE(ctx);
+}
+
+/** Apply the complete records of a block of the log of a table that
+is being rebuilt, partitioned by the PRIMARY KEY among threads.
+@param[in,out]	jobs		row_log_table_apply_pool_create()
+@param[in]	mrec		first record
+@param[in]	mrec_end	end of the block
+@param[out]	error		DB_SUCCESS or error code
+@return the first record that continues in the next block,
+or mrec_end */
+static MY_ATTRIBUTE((nonnull, warn_unused_result))
+const mrec_t*
+row_log_table_apply_block(
+	row_log_table_apply_job_t*	jobs,
+	const mrec_t*			mrec,
+	const mrec_t*			mrec_end,
+	dberr_t*			error)
+{
+	row_log_table_apply_ctx_t*	ctx = jobs[0].ctx;
+	const ulint			n_parts = ctx->n_parts;
+
+	ctx->mrec = mrec;
+	ctx->mrec_end = mrec_end;
+	ctx->n_failed = 0;
+
+	for (ulint i = 1; i < n_parts; i++) {
+		os_event_reset(jobs[i].done);
+		os_event_set(jobs[i].start);
+	}
+
+	row_log_table_apply_part(&jobs[0]);
+
+	for (ulint i = 1; i < n_parts; i++) {
+		os_event_wait(jobs[i].done);
+	}
+
+	*error = DB_SUCCESS;
+
+	for (ulint i = 0; i < n_parts; i++) {
+		if (jobs[i].error != DB_SUCCESS) {
+			*error = jobs[i].error;
+			break;
+		}
+	}
+
+#ifdef UNIV_DEBUG
+	for (ulint i = 1; i < n_parts; i++) {
+		/* Unless interrupted, every thread parsed the
+		same records. */
+		ut_ad(*error != DB_SUCCESS || jobs[i].end == jobs[0].end);
+	}
+#endif /* UNIV_DEBUG */
+
+	return(jobs[0].end);
+}
+
 /** Applies operations to a table was rebuilt.
 @param[in]	thr	query graph
 @param[in,out]	dup	for reporting duplicate key errors
@@ -2751,6 +3131,9 @@ row_log_table_apply_ops(
 	const ulint	new_trx_id_col	= dict_col_get_clust_pos(
 		dict_table_get_sys_col(new_table, DATA_TRX_ID), new_index);
 	trx_t*		trx		= thr_get_trx(thr);
+	const ulint	n_parts		= row_log_table_apply_n_parts(
+		index, trx);
+	row_log_table_apply_job_t*	jobs = NULL;
 
 	ut_ad(dict_index_is_clust(index));
 	ut_ad(dict_index_is_online_ddl(index));
@@ -2921,7 +3304,7 @@ row_log_table_apply_ops(
 			thr, new_trx_id_col,
 			dup, &error, offsets_heap, heap,
 			index->online_log->head.buf,
-			(&index->online_log->head.buf)[1], offsets);
+			(&index->online_log->head.buf)[1], offsets, NULL);
 		if (error != DB_SUCCESS) {
 			goto func_exit;
 		} else if (UNIV_UNLIKELY(mrec == NULL)) {
@@ -2976,6 +3359,41 @@ row_log_table_apply_ops(
 
 	mrec_end = next_mrec_end;
 
+	if (!has_index_lock && n_parts > 1) {
+		/* Apply the complete records of a block that is no
+		longer being written to in parallel. Any record that
+		continues in the next block is applied below. */
+		if (jobs == NULL) {
+			jobs = row_log_table_apply_pool_create(
+				thr, dup, new_trx_id_col, n_parts);
+		}
+
+		next_mrec = row_log_table_apply_block(
+			jobs, next_mrec, mrec_end, &error);
+
+		if (error != DB_SUCCESS) {
+			goto func_exit;
+		}
+
+		index->online_log->head.total += ulint(
+			next_mrec - (index->online_log->head.block
+				     + index->online_log->head.bytes));
+
+		if (next_mrec == next_mrec_end) {
+			/* The last record ended on the block boundary. */
+			mrec = NULL;
+			rw_lock_x_lock(dict_index_get_lock(index));
+			has_index_lock = true;
+
+			index->online_log->head.bytes = 0;
+			index->online_log->head.blocks++;
+			goto next_block;
+		}
+
+		index->online_log->head.bytes = ulint(
+			next_mrec - index->online_log->head.block);
+	}
+
 	while (!trx_is_interrupted(trx)) {
 		mrec = next_mrec;
 		ut_ad(mrec <= mrec_end);
@@ -3026,7 +3444,7 @@ row_log_table_apply_ops(
 		next_mrec = row_log_table_apply_op(
 			thr, new_trx_id_col,
 			dup, &error, offsets_heap, heap,
-			mrec, mrec_end, offsets);
+			mrec, mrec_end, offsets, NULL);
 
 		if (error != DB_SUCCESS) {
 			goto func_exit;
@@ -3072,6 +3490,10 @@ row_log_table_apply_ops(
 interrupted:
 	error = DB_INTERRUPTED;
 func_exit:
+	if (jobs != NULL) {
+		row_log_table_apply_pool_free(jobs);
+	}
+
 	if (!has_index_lock) {
 		rw_lock_x_lock(dict_index_get_lock(index));
 	}
@@ -3146,6 +3568,29 @@ row_log_table_apply(
 	return(error);
 }
 
+/** Determine how much of the log of a table that is being rebuilt
+has not been applied yet. The log is not latched, so the result is
+approximate.
+@param[in]	index	clustered index of the table being rebuilt
+@return number of bytes to apply */
+ulonglong
+row_log_table_backlog(
+	const dict_index_t*	index)
+{
+	ut_ad(dict_index_is_clust(index));
+
+	const row_log_t*	log = index->online_log;
+
+	if (log == NULL) {
+		return(0);
+	}
+
+	const ulonglong	head = log->head.total;
+	const ulonglong	tail = log->tail.total;
+
+	return(tail > head ? tail - head : 0);
+}
+
 /******************************************************//**
 Allocate the row log for an index and flag the index
 for online creation.
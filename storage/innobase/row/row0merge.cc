@@ -49,6 +49,8 @@ Completed by Sunny Bains and Marko Makela
 #include "btr0bulk.h"
 #include "ut0stage.h"
 #include "fil0crypt.h"
+#include "trx0rec.h"
+#include "ibuf0ibuf.h"
 
 float my_log2f(float n)
 {
@@ -869,9 +871,11 @@ row_merge_dup_report(
 	row_merge_dup_t*	dup,	/*!< in/out: for reporting duplicates */
 	const dfield_t*		entry)	/*!< in: duplicate index entry */
 {
-	if (!dup->n_dup++) {
+	if (!dup->n_dup++ && dup->table) {
 		/* Only report the first duplicate record,
-		but count all duplicate records. */
+		but count all duplicate records. The threads of
+		row_merge_read_clustered_index_parallel() pass
+		table=NULL, because they must not write to it. */
 		innobase_fields_to_mysql(dup->table, dup->index, entry);
 	}
 }
@@ -3367,8 +3371,9 @@ row_merge_sort(
 	sol10-64 in buildbot.
 	*/
 #ifndef UNIV_SOLARIS
-	/* Progress report only for "normal" indexes. */
-	if (!(dup->index->type & DICT_FTS)) {
+	/* Progress report only for "normal" indexes, and only
+	from the connection thread. */
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_init(trx->mysql_thd, 1);
 	}
 #endif /* UNIV_SOLARIS */
@@ -3385,7 +3390,7 @@ row_merge_sort(
 		show processlist progress field */
 		/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-		if (!(dup->index->type & DICT_FTS)) {
+		if (update_progress && !(dup->index->type & DICT_FTS)) {
 			thd_progress_report(trx->mysql_thd, file->offset - num_runs, file->offset);
 		}
 #endif /* UNIV_SOLARIS */
@@ -3414,7 +3419,7 @@ row_merge_sort(
 
 	/* Progress report only for "normal" indexes. */
 #ifndef UNIV_SOLARIS
-	if (!(dup->index->type & DICT_FTS)) {
+	if (update_progress && !(dup->index->type & DICT_FTS)) {
 		thd_progress_end(trx->mysql_thd);
 	}
 #endif /* UNIV_SOLARIS */
@@ -4534,247 +4539,1235 @@ void row_merge_write_redo(const dict_index_t* index)
 	mtr.commit();
 }
 
-/** Build indexes on a table by reading a clustered index, creating a temporary
-file containing index entries, merge sorting these index entries and inserting
-sorted index entries to indexes.
-@param[in]	trx		transaction
-@param[in]	old_table	table where rows are read from
-@param[in]	new_table	table where indexes are created; identical to
-old_table unless creating a PRIMARY KEY
-@param[in]	online		true if creating indexes online
-@param[in]	indexes		indexes to be created
-@param[in]	key_numbers	MySQL key numbers
-@param[in]	n_indexes	size of indexes[]
-@param[in,out]	table		MySQL table, for reporting erroneous key value
-if applicable
-@param[in]	defaults	default values of added, changed columns, or NULL
-@param[in]	col_map		mapping of old column numbers to new ones, or
-NULL if old_table == new_table
-@param[in]	add_autoinc	number of added AUTO_INCREMENT columns, or
-ULINT_UNDEFINED if none is added
-@param[in,out]	sequence	autoinc sequence
-@param[in]	skip_pk_sort	whether the new PRIMARY KEY will follow
-existing order
-@param[in,out]	stage		performance schema accounting object, used by
-ALTER TABLE. stage->begin_phase_read_pk() will be called at the beginning of
-this function and it will be passed to other functions for further accounting.
-@param[in]	add_v		new virtual columns added along with indexes
-@param[in]	eval_table	mysql table used to evaluate virtual column
-				value, see innobase_get_computed_value().
-@param[in]	allow_not_null	allow the conversion from null to not-null
-@return DB_SUCCESS or error code */
-dberr_t
-row_merge_build_indexes(
-	trx_t*			trx,
-	dict_table_t*		old_table,
-	dict_table_t*		new_table,
-	bool			online,
-	dict_index_t**		indexes,
-	const ulint*		key_numbers,
-	ulint			n_indexes,
-	struct TABLE*		table,
-	const dtuple_t*		defaults,
-	const ulint*		col_map,
-	ulint			add_autoinc,
-	ib_sequence_t&		sequence,
-	bool			skip_pk_sort,
-	ut_stage_alter_t*	stage,
-	const dict_add_v_col_t*	add_v,
-	struct TABLE*		eval_table,
-	bool			allow_not_null)
+/** A secondary index that is sorted and loaded by row_merge_build_thread() */
+struct row_merge_build_job_t
 {
-	merge_file_t*		merge_files;
-	row_merge_block_t*	block;
-	ut_new_pfx_t		block_pfx;
-	size_t			block_size;
-	ut_new_pfx_t		crypt_pfx;
-	row_merge_block_t*	crypt_block = NULL;
-	ulint			i;
-	ulint			j;
-	dberr_t			error;
-	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
-	dict_index_t*		fts_sort_idx = NULL;
-	fts_psort_t*		psort_info = NULL;
-	fts_psort_t*		merge_info = NULL;
-	int64_t			sig_count = 0;
-	bool			fts_psort_initiated = false;
-
-	double total_static_cost = 0;
-	double total_dynamic_cost = 0;
-	ulint total_index_blocks = 0;
-	double pct_cost=0;
-	double pct_progress=0;
-
-	DBUG_ENTER("row_merge_build_indexes");
+	/** the index being created */
+	dict_index_t*	index;
+	/** the merge file containing the index entries */
+	merge_file_t*	file;
+	/** outcome of sorting and loading the index */
+	dberr_t		error;
+};
 
-	ut_ad(!srv_read_only_mode);
-	ut_ad((old_table == new_table) == !col_map);
-	ut_ad(!defaults || col_map);
+/** The parameters of row_merge_build_thread(), shared by all threads */
+struct row_merge_build_ctx_t
+{
+	/** the ALTER TABLE transaction */
+	trx_t*			trx;
+	/** the table where rows are read from */
+	const dict_table_t*	old_table;
+	/** MySQL table, for reporting erroneous key value */
+	struct TABLE*		table;
+	/** mapping of old column numbers to new ones, or NULL */
+	const ulint*		col_map;
+	/** location of temporary files, or NULL */
+	const char*		path;
+	/** tablespace ID for encryption */
+	ulint			space;
+	/** the indexes to build */
+	row_merge_build_job_t*	jobs;
+	/** number of jobs[] */
+	ulint			n_jobs;
+	/** the next element of jobs[] to pick */
+	Atomic_counter<ulint>	next;
+	/** innodb_onlineddl_pct_progress when the threads were started */
+	double			pct_progress;
+};
 
-	stage->begin_phase_read_pk(skip_pk_sort && new_table != old_table
-				   ? n_indexes - 1
-				   : n_indexes);
+/** Find the job that built a secondary index in row_merge_build_thread().
+@param[in]	jobs	the jobs, or NULL
+@param[in]	n_jobs	number of jobs
+@param[in]	index	index being created
+@return the job
+@retval NULL if the index is built in the calling thread */
+static
+row_merge_build_job_t*
+row_merge_build_find_job(
+	row_merge_build_job_t*	jobs,
+	ulint			n_jobs,
+	const dict_index_t*	index)
+{
+	for (ulint i = 0; i < n_jobs; i++) {
+		if (jobs[i].index == index) {
+			return(&jobs[i]);
+		}
+	}
 
-	/* Allocate memory for merge file data structure and initialize
-	fields */
+	return(NULL);
+}
 
+/** Worker thread that merge sorts the entries of secondary indexes and
+bulk loads them into the index trees, one index at a time, while other
+threads are doing the same for other indexes.
+@param[in,out]	arg	row_merge_build_ctx_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_build_thread)(void* arg)
+{
+	row_merge_build_ctx_t*	ctx = static_cast<row_merge_build_ctx_t*>(arg);
 	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	const size_t		block_size = 3 * srv_sort_buf_size;
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	crypt_block = NULL;
+	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
+	dberr_t			error = DB_SUCCESS;
 
-	/* This will allocate "3 * srv_sort_buf_size" elements of type
-	row_merge_block_t. The latter is defined as byte. */
-	block_size = 3 * srv_sort_buf_size;
-	block = alloc.allocate_large(block_size, &block_pfx);
+	row_merge_block_t*	block = alloc.allocate_large(
+		block_size, &block_pfx);
 
 	if (block == NULL) {
-		DBUG_RETURN(DB_OUT_OF_MEMORY);
-	}
-
-	crypt_pfx.m_size = 0; /* silence bogus -Wmaybe-uninitialized */
-	TRASH_ALLOC(&crypt_pfx, sizeof crypt_pfx);
-
-	if (log_tmp_is_encrypted()) {
-		crypt_block = static_cast<row_merge_block_t*>(
-			alloc.allocate_large(block_size,
-					     &crypt_pfx));
+		error = DB_OUT_OF_MEMORY;
+	} else if (log_tmp_is_encrypted()) {
+		crypt_block = alloc.allocate_large(block_size, &crypt_pfx);
 
 		if (crypt_block == NULL) {
-			DBUG_RETURN(DB_OUT_OF_MEMORY);
+			error = DB_OUT_OF_MEMORY;
 		}
 	}
 
-	trx_start_if_not_started_xa(trx, true);
-	ulint	n_merge_files = 0;
+	for (ulint i; (i = ctx->next++) < ctx->n_jobs;) {
+		row_merge_build_job_t&	job = ctx->jobs[i];
 
-	for (ulint i = 0; i < n_indexes; i++)
-	{
-		if (!dict_index_is_spatial(indexes[i])) {
-			n_merge_files++;
+		if (error != DB_SUCCESS) {
+			job.error = error;
+			continue;
+		}
+
+		if (!row_merge_tmpfile_if_needed(&tmpfd, ctx->path)) {
+			job.error = DB_OUT_OF_MEMORY;
+			continue;
+		}
+
+		/* Only non-unique indexes are built in these threads,
+		so that no duplicate key can be reported to ctx->table
+		concurrently. */
+		ut_ad(!dict_index_is_unique(job.index));
+		row_merge_dup_t	dup = {
+			job.index, ctx->table, ctx->col_map, 0};
+
+		/* Progress is only reported by the calling thread. */
+		job.error = row_merge_sort(
+			ctx->trx, &dup, job.file, block, &tmpfd, false,
+			ctx->pct_progress, 0, crypt_block, ctx->space, NULL);
+
+		if (job.error == DB_SUCCESS) {
+			BtrBulk	btr_bulk(job.index, ctx->trx,
+					 ctx->trx->get_flush_observer());
+
+			job.error = row_merge_insert_index_tuples(
+				job.index, ctx->old_table, job.file->fd,
+				block, NULL, &btr_bulk, job.file->n_rec,
+				ctx->pct_progress, 0, crypt_block,
+				ctx->space);
+
+			job.error = btr_bulk.finish(job.error);
 		}
 	}
 
-	merge_files = static_cast<merge_file_t*>(
-		ut_malloc_nokey(n_merge_files * sizeof *merge_files));
+	row_merge_file_destroy_low(tmpfd);
 
-	/* Initialize all the merge file descriptors, so that we
-	don't call row_merge_file_destroy() on uninitialized
-	merge file descriptor */
+	if (block != NULL) {
+		alloc.deallocate_large(block, &block_pfx, block_size);
+	}
 
-	for (i = 0; i < n_merge_files; i++) {
-		merge_files[i].fd = OS_FILE_CLOSED;
-		merge_files[i].offset = 0;
-		merge_files[i].n_rec = 0;
+	if (crypt_block != NULL) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx, block_size);
 	}
 
-	total_static_cost = COST_BUILD_INDEX_STATIC * n_indexes + COST_READ_CLUSTERED_INDEX;
-	total_dynamic_cost = COST_BUILD_INDEX_DYNAMIC * n_indexes;
-	for (i = 0; i < n_indexes; i++) {
-		if (indexes[i]->type & DICT_FTS) {
-			ibool	opt_doc_id_size = FALSE;
+	os_thread_exit(false);
 
-			/* To build FTS index, we would need to extract
-			doc's word, Doc ID, and word's position, so
-			we need to build a "fts sort index" indexing
-			on above three 'fields' */
-			fts_sort_idx = row_merge_create_fts_sort_index(
-				indexes[i], old_table, &opt_doc_id_size);
+	OS_THREAD_DUMMY_RETURN;
+}
 
-			row_merge_dup_t*	dup
-				= static_cast<row_merge_dup_t*>(
-					ut_malloc_nokey(sizeof *dup));
-			dup->index = fts_sort_idx;
-			dup->table = table;
-			dup->col_map = col_map;
-			dup->n_dup = 0;
+/** A range of the clustered index that is read by row_merge_scan_thread() */
+struct row_merge_scan_job_t
+{
+	/** the smallest PRIMARY KEY of the range, or NULL */
+	const dtuple_t*	low;
+	/** the smallest PRIMARY KEY after the range, or NULL */
+	const dtuple_t*	high;
+	/** number of clustered index records read */
+	ulint		n_recs;
+	/** number of clustered index leaf pages read */
+	ulint		n_pages;
+	/** outcome of reading the range */
+	dberr_t		error;
+	/** the index on which error occurred */
+	ulint		error_index;
+	/** copy of the duplicate entry, if error == DB_DUPLICATE_KEY */
+	const dfield_t*	dup;
+	/** memory heap for dup, or NULL */
+	mem_heap_t*	heap;
+};
 
-			/* This can fail e.g. if temporal files can't be
-			created */
-			if (!row_fts_psort_info_init(
-					trx, dup, new_table, opt_doc_id_size,
-					&psort_info, &merge_info)) {
-				error = DB_CORRUPTION;
-				goto func_exit;
-			}
+/** The parameters of row_merge_scan_thread(), shared by all threads */
+struct row_merge_scan_ctx_t
+{
+	/** the ALTER TABLE transaction */
+	trx_t*			trx;
+	/** the table where the indexes are created */
+	dict_table_t*		table;
+	/** whether the indexes are being created online */
+	bool			online;
+	/** the secondary indexes to create */
+	dict_index_t**		index;
+	/** number of index[] */
+	ulint			n_index;
+	/** the merge files of index[] */
+	merge_file_t*		files;
+	/** number of blocks allocated in each of files[] */
+	Atomic_counter<ulint>*	n_blocks;
+	/** number of entries written to each of files[] */
+	Atomic_counter<ulint>*	n_rec;
+	/** the ranges of the clustered index */
+	row_merge_scan_job_t*	jobs;
+	/** number of jobs[] */
+	ulint			n_jobs;
+	/** the next element of jobs[] to pick */
+	Atomic_counter<ulint>	next;
+	/** number of jobs that failed */
+	Atomic_counter<ulint>	n_failed;
+};
 
-			/* We need to ensure that we free the resources
-			allocated */
-			fts_psort_initiated = true;
+/** Walk a non-leaf level of the clustered index for row_merge_scan_split().
+@param[in]	index	clustered index, S-latched by mtr
+@param[in]	level	level of the B-tree (1=above the leaf level)
+@param[in]	n_parts	number of ranges, or 0 to only count the records
+@param[in]	n_recs	number of node pointers on the level, or 0
+@param[in,out]	heap	memory heap for bounds[], or NULL
+@param[out]	bounds	n_parts - 1 boundaries, or NULL
+@param[in,out]	mtr	mini-transaction
+@return number of node pointers on the level */
+static
+ulint
+row_merge_scan_level(
+	dict_index_t*		index,
+	ulint			level,
+	ulint			n_parts,
+	ulint			n_recs,
+	mem_heap_t*		heap,
+	const dtuple_t**	bounds,
+	mtr_t*			mtr)
+{
+	btr_pcur_t	pcur;
+	ulint		n = 0;
+
+	btr_pcur_open_at_index_side(
+		true, index, BTR_SEARCH_TREE_ALREADY_S_LATCHED,
+		&pcur, true, level, mtr);
+	btr_pcur_move_to_next_on_page(&pcur);
+
+	for (ulint j = 1; btr_pcur_is_on_user_rec(&pcur);
+	     btr_pcur_move_to_next_user_rec(&pcur, mtr), n++) {
+		/* The first node pointer of the level carries
+		REC_INFO_MIN_REC_FLAG, so it is never picked (n > 0). */
+		if (j < n_parts && n == j * n_recs / n_parts) {
+			dtuple_t*	tuple = dict_index_build_data_tuple(
+				btr_pcur_get_rec(&pcur), index, false,
+				dict_index_get_n_unique_in_tree_nonleaf(index),
+				heap);
+			tuple->info_bits = 0;
+			bounds[j++ - 1] = tuple;
 		}
 	}
 
-	if (global_system_variables.log_warnings > 2) {
-		sql_print_information("InnoDB: Online DDL : Start reading"
-				      " clustered index of the table"
-				      " and create temporary files");
-	}
+	btr_pcur_close(&pcur);
 
-	pct_cost = COST_READ_CLUSTERED_INDEX * 100 / (total_static_cost + total_dynamic_cost);
+	return(n);
+}
 
-	/* Do not continue if we can't encrypt table pages */
-	if (!old_table->is_readable() ||
-	    !new_table->is_readable()) {
-		error = DB_DECRYPTION_FAILED;
-		ib_push_warning(trx->mysql_thd, DB_DECRYPTION_FAILED,
-			"Table %s is encrypted but encryption service or"
-			" used key_id is not available. "
-			" Can't continue reading table.",
-			!old_table->is_readable() ? old_table->name.m_name :
-				new_table->name.m_name);
-		goto func_exit;
+/** Choose the PRIMARY KEY values that divide the clustered index into
+ranges for row_merge_read_clustered_index_parallel(). The boundaries
+are node pointers on the highest level of the B-tree that contains at
+least n_parts records, so that the ranges cover about the same number
+of leaf pages.
+@param[in]	old_table	table where rows are read from
+@param[in]	new_table	table where indexes are created
+@param[in]	index		indexes to be created
+@param[in]	n_index		number of indexes to create
+@param[in]	add_v		newly added virtual columns, or NULL
+@param[in]	n_parts		desired number of ranges
+@param[in,out]	heap		memory heap for bounds[]
+@param[out]	bounds		n_parts - 1 boundaries, in ascending order
+@return number of ranges
+@retval 1 if the clustered index must be read by
+row_merge_read_clustered_index() */
+static
+ulint
+row_merge_scan_split(
+	const dict_table_t*	old_table,
+	const dict_table_t*	new_table,
+	dict_index_t**		index,
+	ulint			n_index,
+	const dict_add_v_col_t*	add_v,
+	ulint			n_parts,
+	mem_heap_t*		heap,
+	const dtuple_t**	bounds)
+{
+	/* Rebuilding the table involves converting the rows and
+	reporting errors via TABLE, and FULLTEXT, SPATIAL and virtual
+	column indexes are built by the connection thread. */
+	if (old_table != new_table || add_v) {
+		return(1);
 	}
 
-	/* Read clustered index of the table and create files for
-	secondary index entries for merge sort */
-	error = row_merge_read_clustered_index(
-		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
-		n_indexes, defaults, add_v, col_map, add_autoinc,
-		sequence, block, skip_pk_sort, &tmpfd, stage,
-		pct_cost, crypt_block, eval_table, allow_not_null);
-
-	stage->end_phase_read_pk();
+	for (ulint i = 0; i < n_index; i++) {
+		if ((index[i]->type & (DICT_FTS | DICT_SPATIAL))
+		    || index[i]->has_virtual()) {
+			return(1);
+		}
+	}
 
-	pct_progress += pct_cost;
+	dict_index_t*	clust_index = dict_table_get_first_index(old_table);
+	mtr_t		mtr;
 
-	if (global_system_variables.log_warnings > 2) {
-		sql_print_information("InnoDB: Online DDL : End of reading "
-				      "clustered index of the table"
-				      " and create temporary files");
-	}
+	mtr.start();
+	mtr_s_lock(dict_index_get_lock(clust_index), &mtr);
 
-	for (i = 0; i < n_merge_files; i++) {
-		total_index_blocks += merge_files[i].offset;
-	}
+	ulint	level = btr_height_get(clust_index, &mtr);
+	ulint	n_recs = 0;
 
-	if (error != DB_SUCCESS) {
-		goto func_exit;
-	}
+	if (level) {
+		/* Each page of a level is pointed to by a record on
+		the level above. Thus, we will visit fewer than n_parts
+		pages on each level below the root. */
+		for (;;) {
+			n_recs = row_merge_scan_level(
+				clust_index, level, 0, 0, NULL, NULL, &mtr);
 
-	DEBUG_SYNC_C("row_merge_after_scan");
+			if (n_recs >= n_parts || level == 1) {
+				break;
+			}
 
-	/* Now we have files containing index entries ready for
-	sorting and inserting. */
+			level--;
+		}
 
-	for (ulint k = 0, i = 0; i < n_indexes; i++) {
-		dict_index_t*	sort_idx = indexes[i];
+		n_parts = std::min(n_parts, n_recs);
 
-		if (dict_index_is_spatial(sort_idx)) {
-			continue;
+		if (n_parts > 1) {
+			row_merge_scan_level(clust_index, level, n_parts,
+					     n_recs, heap, bounds, &mtr);
 		}
+	} else {
+		/* The clustered index consists of the root page only. */
+		n_parts = 1;
+	}
 
-		if (indexes[i]->type & DICT_FTS) {
-			os_event_t	fts_parallel_merge_event;
+	mtr.commit();
 
-			sort_idx = fts_sort_idx;
+	return(n_parts);
+}
 
-			fts_parallel_merge_event
-				= merge_info[0].psort_common->merge_event;
+/** Find a duplicate key in a sorted buffer of a UNIQUE index.
+@param[in]	buf	buffer that was sorted by row_merge_buf_sort()
+@return the first of two equal entries
+@retval NULL if there are no duplicates */
+static
+const dfield_t*
+row_merge_buf_find_dup(const row_merge_buf_t* buf)
+{
+	const ulint	n_uniq = dict_index_get_n_unique(buf->index);
 
-			if (FTS_PLL_MERGE) {
-				ulint	trial_count = 0;
-				bool	all_exit = false;
+	for (ulint i = 1; i < buf->n_tuples; i++) {
+		const dfield_t*	a = buf->tuples[i - 1].fields;
+		const dfield_t*	b = buf->tuples[i].fields;
+		ulint		n = 0;
 
-				os_event_reset(fts_parallel_merge_event);
-				row_fts_start_parallel_merge(merge_info);
+		/* NULL columns are logically inequal. */
+		while (n < n_uniq && !dfield_is_null(&a[n])
+		       && !cmp_dfield_dfield(&a[n], &b[n])) {
+			n++;
+		}
+
+		if (n == n_uniq) {
+			return(a);
+		}
+	}
+
+	return(NULL);
+}
+
+/** Sort a buffer of index entries and write it as a block to the merge
+file that is shared by the threads of row_merge_read_clustered_index_parallel().
+@param[in,out]	ctx		shared parameters
+@param[in,out]	job		the current range
+@param[in]	i		index of the buffer in ctx->index[]
+@param[in,out]	buf		buffer of entries
+@param[out]	block		file buffer
+@param[out]	crypt_block	encrypted file buffer, or NULL
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_scan_write(
+	row_merge_scan_ctx_t*	ctx,
+	row_merge_scan_job_t&	job,
+	ulint			i,
+	row_merge_buf_t*	buf,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block)
+{
+	if (dict_index_is_unique(buf->index)) {
+		row_merge_dup_t	dup = {buf->index, NULL, NULL, 0};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			/* Copy the entry, so that the connection
+			thread can report it after the buffer is gone. */
+			const dfield_t*	entry = row_merge_buf_find_dup(buf);
+			const ulint	n_fields = dict_index_get_n_fields(
+				buf->index);
+			ut_ad(entry);
+
+			job.heap = mem_heap_create(1024);
+			dfield_t*	fields = static_cast<dfield_t*>(
+				mem_heap_dup(job.heap, entry,
+					     n_fields * sizeof *fields));
+
+			for (ulint f = 0; f < n_fields; f++) {
+				dfield_dup(&fields[f], job.heap);
+			}
+
+			job.dup = fields;
+			job.error_index = i;
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	const merge_file_t*	file = &ctx->files[i];
+
+	row_merge_buf_write(buf, file, block);
+
+	/* Every block is a sorted run for row_merge_sort(). The
+	blocks of different threads may be interleaved in the file. */
+	if (!row_merge_write(file->fd, ctx->n_blocks[i]++, block,
+			     crypt_block, ctx->table->space_id)) {
+		job.error_index = i;
+		return(DB_TEMP_FILE_WRITE_FAIL);
+	}
+
+	UNIV_MEM_INVALID(&block[0], srv_sort_buf_size);
+	return(DB_SUCCESS);
+}
+
+/** Read a range of the clustered index and buffer the entries of the
+secondary indexes, for row_merge_scan_thread().
+@param[in,out]	ctx		shared parameters
+@param[in,out]	job		the range to read
+@param[in,out]	merge_buf	buffers for ctx->index[]
+@param[in,out]	n_rec		number of entries buffered for ctx->index[]
+@param[out]	block		file buffer
+@param[out]	crypt_block	encrypted file buffer, or NULL
+@return DB_SUCCESS or error code */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_scan_range(
+	row_merge_scan_ctx_t*	ctx,
+	row_merge_scan_job_t&	job,
+	row_merge_buf_t**	merge_buf,
+	ulint*			n_rec,
+	row_merge_block_t*	block,
+	row_merge_block_t*	crypt_block)
+{
+	trx_t*		trx = ctx->trx;
+	dict_table_t*	table = ctx->table;
+	dict_index_t*	clust_index = dict_table_get_first_index(table);
+	mem_heap_t*	row_heap = mem_heap_create(sizeof(mrec_buf_t));
+	mem_heap_t*	v_heap = NULL;
+	doc_id_t	doc_id = 0;
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+	dberr_t		err = DB_SUCCESS;
+
+	mtr.start();
+
+	if (job.low) {
+		btr_pcur_open(clust_index, job.low, PAGE_CUR_GE,
+			      BTR_SEARCH_LEAF, &pcur, &mtr);
+		/* The loop below will advance to the first record. */
+		btr_pcur_move_to_prev_on_page(&pcur);
+	} else {
+		btr_pcur_open_at_index_side(
+			true, clust_index, BTR_SEARCH_LEAF, &pcur, true, 0,
+			&mtr);
+		btr_pcur_move_to_next_user_rec(&pcur, &mtr);
+		if (rec_is_metadata(btr_pcur_get_rec(&pcur), *clust_index)) {
+			ut_ad(btr_pcur_is_on_user_rec(&pcur));
+			/* Skip the metadata pseudo-record. */
+		} else {
+			ut_ad(!clust_index->is_instant());
+			btr_pcur_move_to_prev_on_page(&pcur);
+		}
+	}
+
+	for (;;) {
+		const rec_t*	rec;
+		ulint*		offsets;
+		const dtuple_t*	row;
+		row_ext_t*	ext;
+		page_cur_t*	cur	= btr_pcur_get_page_cur(&pcur);
+
+		mem_heap_empty(row_heap);
+
+		page_cur_move_to_next(cur);
+
+		if (page_cur_is_after_last(cur)) {
+			job.n_pages++;
+
+			if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			if (!table->is_readable()) {
+				err = DB_DECRYPTION_FAILED;
+				break;
+			}
+
+			if (ctx->n_failed) {
+				/* Another thread failed. Its error
+				will be reported. */
+				break;
+			}
+
+			if (clust_index->lock.waiters.load(
+				    std::memory_order_relaxed)) {
+				/* Yield to the waiters on the clustered
+				index tree lock, as in
+				row_merge_read_clustered_index(). */
+				btr_pcur_move_to_prev_on_page(&pcur);
+				btr_pcur_store_position(&pcur, &mtr);
+				mtr.commit();
+				os_thread_yield();
+				mtr.start();
+				btr_pcur_restore_position(
+					BTR_SEARCH_LEAF, &pcur, &mtr);
+				if (!btr_pcur_move_to_next_user_rec(
+					    &pcur, &mtr)) {
+					break;
+				}
+			} else {
+				const ulint	next_page_no
+					= btr_page_get_next(
+						page_cur_get_page(cur), &mtr);
+
+				if (next_page_no == FIL_NULL) {
+					break;
+				}
+
+				const buf_block_t*	prev
+					= page_cur_get_block(cur);
+				buf_block_t*	next = btr_block_get(
+					page_id_t(prev->page.id.space(),
+						  next_page_no),
+					prev->zip_size(),
+					BTR_SEARCH_LEAF,
+					clust_index, &mtr);
+
+				btr_leaf_page_release(page_cur_get_block(cur),
+						      BTR_SEARCH_LEAF, &mtr);
+				page_cur_set_before_first(next, cur);
+				page_cur_move_to_next(cur);
+
+				ut_ad(!page_cur_is_after_last(cur));
+			}
+		}
+
+		rec = page_cur_get_rec(cur);
+		offsets = rec_get_offsets(rec, clust_index, NULL, true,
+					  ULINT_UNDEFINED, &row_heap);
+
+		if (job.high && cmp_dtuple_rec(job.high, rec, offsets) <= 0) {
+			/* This record belongs to the next range. */
+			break;
+		}
+
+		job.n_recs++;
+
+		if (ctx->online) {
+			/* Perform a REPEATABLE READ, like
+			row_merge_read_clustered_index() does. */
+			const trx_id_t	rec_trx_id = row_get_rec_trx_id(
+				rec, clust_index, offsets);
+
+			ut_ad(trx->read_view.is_open());
+			ut_ad(rec_trx_id != trx->id);
+
+			if (!trx->read_view.changes_visible(
+				    rec_trx_id, table->name)) {
+				rec_t*	old_vers;
+
+				row_vers_build_for_consistent_read(
+					rec, &mtr, clust_index, &offsets,
+					&trx->read_view, &row_heap,
+					row_heap, &old_vers, NULL);
+
+				if (!old_vers) {
+					continue;
+				}
+
+				rec = old_vers;
+			}
+		}
+
+		if (rec_get_deleted_flag(rec, dict_table_is_comp(table))) {
+			continue;
+		}
+
+		ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+		row = row_build_w_add_vcol(ROW_COPY_POINTERS, clust_index,
+					   rec, offsets, table, NULL, NULL,
+					   NULL, &ext, row_heap);
+
+		for (ulint i = 0; i < ctx->n_index; i++) {
+			row_merge_buf_t*	buf = merge_buf[i];
+			ulint			rows_added = row_merge_buf_add(
+				buf, NULL, table, table, NULL, row, ext,
+				&doc_id, NULL, &err, &v_heap, NULL, trx);
+
+			if (!rows_added) {
+				/* The buffer is full. */
+				err = row_merge_scan_write(
+					ctx, job, i, buf, block, crypt_block);
+
+				if (err != DB_SUCCESS) {
+					break;
+				}
+
+				merge_buf[i] = buf = row_merge_buf_empty(buf);
+
+				rows_added = row_merge_buf_add(
+					buf, NULL, table, table, NULL, row,
+					ext, &doc_id, NULL, &err, &v_heap,
+					NULL, trx);
+				/* An empty buffer should have enough
+				room for at least one record. */
+				ut_a(rows_added);
+			}
+
+			ut_ad(err == DB_SUCCESS);
+			n_rec[i] += rows_added;
+		}
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	if (mtr.is_active()) {
+		mtr.commit();
+	}
+
+	btr_pcur_close(&pcur);
+	mem_heap_free(row_heap);
+
+	if (v_heap) {
+		mem_heap_free(v_heap);
+	}
+
+	return(err);
+}
+
+/** Worker thread that reads ranges of the clustered index and writes
+sorted blocks of the secondary index entries to the merge files.
+@param[in,out]	arg	row_merge_scan_ctx_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_scan_thread)(void* arg)
+{
+	row_merge_scan_ctx_t*	ctx = static_cast<row_merge_scan_ctx_t*>(arg);
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	crypt_block = NULL;
+	dberr_t			error = DB_SUCCESS;
+	row_merge_scan_job_t*	last_job = NULL;
+
+	row_merge_buf_t**	merge_buf = static_cast<row_merge_buf_t**>(
+		ut_malloc_nokey(ctx->n_index * sizeof *merge_buf));
+	ulint*			n_rec = static_cast<ulint*>(
+		ut_zalloc_nokey(ctx->n_index * sizeof *n_rec));
+
+	for (ulint i = 0; i < ctx->n_index; i++) {
+		merge_buf[i] = row_merge_buf_create(ctx->index[i]);
+	}
+
+	row_merge_block_t*	block = alloc.allocate_large(
+		srv_sort_buf_size, &block_pfx);
+
+	if (block == NULL) {
+		error = DB_OUT_OF_MEMORY;
+	} else if (log_tmp_is_encrypted()) {
+		crypt_block = alloc.allocate_large(
+			srv_sort_buf_size, &crypt_pfx);
+
+		if (crypt_block == NULL) {
+			error = DB_OUT_OF_MEMORY;
+		}
+	}
+
+	/* The buffers are kept across the ranges, because a block
+	does not need to cover a contiguous range of the table. */
+	for (ulint j; (j = ctx->next++) < ctx->n_jobs;) {
+		row_merge_scan_job_t&	job = ctx->jobs[j];
+
+		job.error = error == DB_SUCCESS
+			? row_merge_scan_range(ctx, job, merge_buf, n_rec,
+					       block, crypt_block)
+			: error;
+
+		if (job.error != DB_SUCCESS) {
+			ctx->n_failed++;
+			break;
+		}
+
+		last_job = &job;
+	}
+
+	/* Write out the remaining entries, on behalf of the last
+	range that was read successfully. */
+	for (ulint i = 0; last_job && !ctx->n_failed && i < ctx->n_index;
+	     i++) {
+		if (merge_buf[i]->n_tuples) {
+			last_job->error = row_merge_scan_write(
+				ctx, *last_job, i, merge_buf[i], block,
+				crypt_block);
+
+			if (last_job->error != DB_SUCCESS) {
+				ctx->n_failed++;
+				break;
+			}
+		}
+
+		ctx->n_rec[i] += n_rec[i];
+	}
+
+	for (ulint i = 0; i < ctx->n_index; i++) {
+		row_merge_buf_free(merge_buf[i]);
+	}
+
+	ut_free(merge_buf);
+	ut_free(n_rec);
+
+	if (block != NULL) {
+		alloc.deallocate_large(block, &block_pfx, srv_sort_buf_size);
+	}
+
+	if (crypt_block != NULL) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx,
+				       srv_sort_buf_size);
+	}
+
+	os_thread_exit(false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Read the clustered index in multiple threads and write the entries
+of the secondary indexes to merge files. Each thread reads ranges of the
+clustered index that were chosen by row_merge_scan_split(), and writes
+each full sort buffer as a sorted block to the merge file of the index.
+The blocks are merged by row_merge_sort() like the blocks that are
+written by row_merge_read_clustered_index().
+@param[in]	trx		transaction
+@param[in,out]	table		MySQL table, for reporting duplicate keys
+@param[in]	old_table	table where indexes are created
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in,out]	files		temporary files
+@param[in]	key_numbers	MySQL key numbers to create
+@param[in]	n_index		number of indexes to create
+@param[in]	bounds		boundaries of the ranges
+@param[in]	n_parts		number of ranges
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	stage		performance schema accounting object
+@param[in]	pct_cost	percent of task weight out of total alter job
+@return DB_SUCCESS or error */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_parallel(
+	trx_t*			trx,
+	struct TABLE*		table,
+	dict_table_t*		old_table,
+	bool			online,
+	dict_index_t**		index,
+	merge_file_t*		files,
+	const ulint*		key_numbers,
+	ulint			n_index,
+	const dtuple_t**	bounds,
+	ulint			n_parts,
+	pfs_os_file_t*		tmpfd,
+	ut_stage_alter_t*	stage,
+	double			pct_cost)
+{
+	dberr_t		err = DB_SUCCESS;
+	const char*	path = thd_innodb_tmpdir(trx->mysql_thd);
+
+	DBUG_ENTER("row_merge_read_clustered_index_parallel");
+
+	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE));
+	ut_ad(n_parts > 1);
+
+	trx->op_info = "reading clustered index";
+
+	/* The threads share the merge files, which must exist first. */
+	for (ulint i = 0; i < n_index; i++) {
+		if (!row_merge_file_create_if_needed(
+			    &files[i], tmpfd, 0, path)) {
+			trx->error_key_num = i;
+			trx->op_info = "";
+			DBUG_RETURN(DB_OUT_OF_MEMORY);
+		}
+	}
+
+	row_merge_scan_job_t*	jobs = static_cast<row_merge_scan_job_t*>(
+		ut_zalloc_nokey(n_parts * sizeof *jobs));
+
+	for (ulint p = 0; p < n_parts; p++) {
+		jobs[p].low = p ? bounds[p - 1] : NULL;
+		jobs[p].high = p + 1 < n_parts ? bounds[p] : NULL;
+		jobs[p].error = DB_SUCCESS;
+	}
+
+	row_merge_scan_ctx_t	ctx = {
+		trx, old_table, online, index, n_index, files,
+		UT_NEW_ARRAY_NOKEY(Atomic_counter<ulint>, n_index),
+		UT_NEW_ARRAY_NOKEY(Atomic_counter<ulint>, n_index),
+		jobs, n_parts, 0, 0};
+
+	for (ulint i = 0; i < n_index; i++) {
+		ctx.n_blocks[i] = 0;
+		ctx.n_rec[i] = 0;
+	}
+
+	DEBUG_SYNC_C("row_merge_read_clustered_index_parallel");
+
+	const ulint	n_threads = std::min(
+		thd_ddl_threads(trx->mysql_thd), n_parts);
+
+	os_thread_id_t*	thread_ids = static_cast<os_thread_id_t*>(
+		ut_malloc_nokey(n_threads * sizeof *thread_ids));
+
+	for (ulint t = 0; t < n_threads; t++) {
+		os_thread_create(row_merge_scan_thread, &ctx, &thread_ids[t]);
+	}
+
+	for (ulint t = 0; t < n_threads; t++) {
+		os_thread_join(thread_ids[t]);
+	}
+
+	ut_free(thread_ids);
+
+	/* Report the error of the first failed range. */
+	for (ulint p = 0; p < n_parts; p++) {
+		row_merge_scan_job_t&	job = jobs[p];
+
+		for (ulint n = job.n_recs; n--; ) {
+			stage->n_pk_recs_inc();
+		}
+
+		for (ulint n = job.n_pages; n--; ) {
+			stage->inc();
+		}
+
+		if (job.error == DB_SUCCESS || err != DB_SUCCESS) {
+			/* Only the first error is reported. */
+		} else if (job.error == DB_DUPLICATE_KEY) {
+			err = job.error;
+			innobase_fields_to_mysql(
+				table, index[job.error_index], job.dup);
+			trx->error_key_num = key_numbers[job.error_index];
+		} else {
+			err = job.error;
+			trx->error_key_num = err == DB_TEMP_FILE_WRITE_FAIL
+				? job.error_index : 0;
+		}
+
+		if (job.heap) {
+			mem_heap_free(job.heap);
+		}
+	}
+
+	for (ulint i = 0; err == DB_SUCCESS && i < n_index; i++) {
+		files[i].offset = ctx.n_blocks[i];
+		files[i].n_rec = ctx.n_rec[i];
+
+		if (!files[i].n_rec) {
+			/* The table is empty; row_merge_build_indexes()
+			will skip the index. */
+			row_merge_file_destroy(&files[i]);
+		}
+
+		if (online) {
+			/* Note the newest transaction that modified
+			this index when the scan was completed, like
+			row_merge_read_clustered_index() does. */
+			rw_lock_x_lock(dict_index_get_lock(index[i]));
+			ut_a(dict_index_get_online_status(index[i])
+			     == ONLINE_INDEX_CREATION);
+
+			trx_id_t	max_trx_id = row_log_get_max_trx(
+				index[i]);
+
+			if (max_trx_id > index[i]->trx_id) {
+				index[i]->trx_id = max_trx_id;
+			}
+
+			rw_lock_x_unlock(dict_index_get_lock(index[i]));
+		}
+	}
+
+	if (err == DB_SUCCESS && files[0].n_rec && innodb_log_optimize_ddl) {
+		/* Set the page flush observer for the transaction
+		before the indexes are loaded. */
+		trx->set_flush_observer(old_table->space, stage);
+	}
+
+	onlineddl_pct_progress = ulint(pct_cost * 100);
+
+	UT_DELETE_ARRAY(ctx.n_blocks);
+	UT_DELETE_ARRAY(ctx.n_rec);
+	ut_free(jobs);
+
+	trx->op_info = "";
+
+	DBUG_RETURN(err);
+}
+
+/** Build indexes on a table by reading a clustered index, creating a temporary
+file containing index entries, merge sorting these index entries and inserting
+sorted index entries to indexes.
+@param[in]	trx		transaction
+@param[in]	old_table	table where rows are read from
+@param[in]	new_table	table where indexes are created; identical to
+old_table unless creating a PRIMARY KEY
+@param[in]	online		true if creating indexes online
+@param[in]	indexes		indexes to be created
+@param[in]	key_numbers	MySQL key numbers
+@param[in]	n_indexes	size of indexes[]
+@param[in,out]	table		MySQL table, for reporting erroneous key value
+if applicable
+@param[in]	defaults	default values of added, changed columns, or NULL
+@param[in]	col_map		mapping of old column numbers to new ones, or
+NULL if old_table == new_table
+@param[in]	add_autoinc	number of added AUTO_INCREMENT columns, or
+ULINT_UNDEFINED if none is added
+@param[in,out]	sequence	autoinc sequence
+@param[in]	skip_pk_sort	whether the new PRIMARY KEY will follow
+existing order
+@param[in,out]	stage		performance schema accounting object, used by
+ALTER TABLE. stage->begin_phase_read_pk() will be called at the beginning of
+this function and it will be passed to other functions for further accounting.
+@param[in]	add_v		new virtual columns added along with indexes
+@param[in]	eval_table	mysql table used to evaluate virtual column
+				value, see innobase_get_computed_value().
+@param[in]	allow_not_null	allow the conversion from null to not-null
+@return DB_SUCCESS or error code */
+dberr_t
+row_merge_build_indexes(
+	trx_t*			trx,
+	dict_table_t*		old_table,
+	dict_table_t*		new_table,
+	bool			online,
+	dict_index_t**		indexes,
+	const ulint*		key_numbers,
+	ulint			n_indexes,
+	struct TABLE*		table,
+	const dtuple_t*		defaults,
+	const ulint*		col_map,
+	ulint			add_autoinc,
+	ib_sequence_t&		sequence,
+	bool			skip_pk_sort,
+	ut_stage_alter_t*	stage,
+	const dict_add_v_col_t*	add_v,
+	struct TABLE*		eval_table,
+	bool			allow_not_null)
+{
+	merge_file_t*		merge_files;
+	row_merge_block_t*	block;
+	ut_new_pfx_t		block_pfx;
+	size_t			block_size;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	crypt_block = NULL;
+	ulint			i;
+	ulint			j;
+	dberr_t			error;
+	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
+	dict_index_t*		fts_sort_idx = NULL;
+	fts_psort_t*		psort_info = NULL;
+	fts_psort_t*		merge_info = NULL;
+	int64_t			sig_count = 0;
+	bool			fts_psort_initiated = false;
+	row_merge_build_job_t*	jobs = NULL;
+	ulint			n_jobs = 0;
+	mem_heap_t*		scan_heap = NULL;
+	const dtuple_t**	scan_bounds = NULL;
+	ulint			n_scan_parts = 1;
+
+	double total_static_cost = 0;
+	double total_dynamic_cost = 0;
+	ulint total_index_blocks = 0;
+	double pct_cost=0;
+	double pct_progress=0;
+
+	DBUG_ENTER("row_merge_build_indexes");
+
+	ut_ad(!srv_read_only_mode);
+	ut_ad((old_table == new_table) == !col_map);
+	ut_ad(!defaults || col_map);
+
+	stage->begin_phase_read_pk(skip_pk_sort && new_table != old_table
+				   ? n_indexes - 1
+				   : n_indexes);
+
+	/* Allocate memory for merge file data structure and initialize
+	fields */
+
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+
+	/* This will allocate "3 * srv_sort_buf_size" elements of type
+	row_merge_block_t. The latter is defined as byte. */
+	block_size = 3 * srv_sort_buf_size;
+	block = alloc.allocate_large(block_size, &block_pfx);
+
+	if (block == NULL) {
+		DBUG_RETURN(DB_OUT_OF_MEMORY);
+	}
+
+	crypt_pfx.m_size = 0; /* silence bogus -Wmaybe-uninitialized */
+	TRASH_ALLOC(&crypt_pfx, sizeof crypt_pfx);
+
+	if (log_tmp_is_encrypted()) {
+		crypt_block = static_cast<row_merge_block_t*>(
+			alloc.allocate_large(block_size,
+					     &crypt_pfx));
+
+		if (crypt_block == NULL) {
+			DBUG_RETURN(DB_OUT_OF_MEMORY);
+		}
+	}
+
+	trx_start_if_not_started_xa(trx, true);
+	ulint	n_merge_files = 0;
+
+	for (ulint i = 0; i < n_indexes; i++)
+	{
+		if (!dict_index_is_spatial(indexes[i])) {
+			n_merge_files++;
+		}
+	}
+
+	merge_files = static_cast<merge_file_t*>(
+		ut_malloc_nokey(n_merge_files * sizeof *merge_files));
+
+	/* Initialize all the merge file descriptors, so that we
+	don't call row_merge_file_destroy() on uninitialized
+	merge file descriptor */
+
+	for (i = 0; i < n_merge_files; i++) {
+		merge_files[i].fd = OS_FILE_CLOSED;
+		merge_files[i].offset = 0;
+		merge_files[i].n_rec = 0;
+	}
+
+	total_static_cost = COST_BUILD_INDEX_STATIC * n_indexes + COST_READ_CLUSTERED_INDEX;
+	total_dynamic_cost = COST_BUILD_INDEX_DYNAMIC * n_indexes;
+	for (i = 0; i < n_indexes; i++) {
+		if (indexes[i]->type & DICT_FTS) {
+			ibool	opt_doc_id_size = FALSE;
+
+			/* To build FTS index, we would need to extract
+			doc's word, Doc ID, and word's position, so
+			we need to build a "fts sort index" indexing
+			on above three 'fields' */
+			fts_sort_idx = row_merge_create_fts_sort_index(
+				indexes[i], old_table, &opt_doc_id_size);
+
+			row_merge_dup_t*	dup
+				= static_cast<row_merge_dup_t*>(
+					ut_malloc_nokey(sizeof *dup));
+			dup->index = fts_sort_idx;
+			dup->table = table;
+			dup->col_map = col_map;
+			dup->n_dup = 0;
+
+			/* This can fail e.g. if temporal files can't be
+			created */
+			if (!row_fts_psort_info_init(
+					trx, dup, new_table, opt_doc_id_size,
+					&psort_info, &merge_info)) {
+				error = DB_CORRUPTION;
+				goto func_exit;
+			}
+
+			/* We need to ensure that we free the resources
+			allocated */
+			fts_psort_initiated = true;
+		}
+	}
+
+	if (global_system_variables.log_warnings > 2) {
+		sql_print_information("InnoDB: Online DDL : Start reading"
+				      " clustered index of the table"
+				      " and create temporary files");
+	}
+
+	pct_cost = COST_READ_CLUSTERED_INDEX * 100 / (total_static_cost + total_dynamic_cost);
+
+	/* Do not continue if we can't encrypt table pages */
+	if (!old_table->is_readable() ||
+	    !new_table->is_readable()) {
+		error = DB_DECRYPTION_FAILED;
+		ib_push_warning(trx->mysql_thd, DB_DECRYPTION_FAILED,
+			"Table %s is encrypted but encryption service or"
+			" used key_id is not available. "
+			" Can't continue reading table.",
+			!old_table->is_readable() ? old_table->name.m_name :
+				new_table->name.m_name);
+		goto func_exit;
+	}
+
+	if (thd_ddl_threads(trx->mysql_thd) > 1) {
+		/* Divide the table into more ranges than there are
+		threads, so that a thread that finishes early can
+		pick another range. */
+		n_scan_parts = 4 * thd_ddl_threads(trx->mysql_thd);
+		scan_heap = mem_heap_create(1024);
+		scan_bounds = static_cast<const dtuple_t**>(
+			mem_heap_alloc(scan_heap, (n_scan_parts - 1)
+				       * sizeof *scan_bounds));
+		n_scan_parts = row_merge_scan_split(
+			old_table, new_table, indexes, n_indexes, add_v,
+			n_scan_parts, scan_heap, scan_bounds);
+	}
+
+	/* Read clustered index of the table and create files for
+	secondary index entries for merge sort */
+	if (n_scan_parts > 1) {
+		error = row_merge_read_clustered_index_parallel(
+			trx, table, old_table, online, indexes, merge_files,
+			key_numbers, n_indexes, scan_bounds, n_scan_parts,
+			&tmpfd, stage, pct_cost);
+	} else {
+		error = row_merge_read_clustered_index(
+			trx, table, old_table, new_table, online, indexes,
+			fts_sort_idx, psort_info, merge_files, key_numbers,
+			n_indexes, defaults, add_v, col_map, add_autoinc,
+			sequence, block, skip_pk_sort, &tmpfd, stage,
+			pct_cost, crypt_block, eval_table, allow_not_null);
+	}
+
+	if (scan_heap) {
+		mem_heap_free(scan_heap);
+	}
+
+	stage->end_phase_read_pk();
+
+	pct_progress += pct_cost;
+
+	if (global_system_variables.log_warnings > 2) {
+		sql_print_information("InnoDB: Online DDL : End of reading "
+				      "clustered index of the table"
+				      " and create temporary files");
+	}
+
+	for (i = 0; i < n_merge_files; i++) {
+		total_index_blocks += merge_files[i].offset;
+	}
+
+	if (error != DB_SUCCESS) {
+		goto func_exit;
+	}
+
+	DEBUG_SYNC_C("row_merge_after_scan");
+
+	/* Now we have files containing index entries ready for
+	sorting and inserting. */
+
+	if (thd_ddl_threads(trx->mysql_thd) > 1) {
+		/* Sort and load the non-unique secondary indexes in
+		parallel. The clustered index and UNIQUE indexes, which
+		may have to report duplicate keys, as well as FULLTEXT
+		and SPATIAL indexes are built below in this thread. */
+		jobs = static_cast<row_merge_build_job_t*>(
+			ut_malloc_nokey(n_indexes * sizeof *jobs));
+
+		for (ulint k = 0, i = 0; i < n_indexes; i++) {
+			if (dict_index_is_spatial(indexes[i])) {
+				continue;
+			}
+
+			if (!(indexes[i]->type
+			      & (DICT_CLUSTERED | DICT_UNIQUE | DICT_FTS))
+			    && merge_files[k].fd != OS_FILE_CLOSED) {
+				row_merge_build_job_t&	job = jobs[n_jobs++];
+				job.index = indexes[i];
+				job.file = &merge_files[k];
+				job.error = DB_SUCCESS;
+			}
+
+			k++;
+		}
+
+		if (n_jobs > 1) {
+			row_merge_build_ctx_t	ctx = {
+				trx, old_table, table, col_map,
+				thd_innodb_tmpdir(trx->mysql_thd),
+				new_table->space_id, jobs, n_jobs, 0,
+				pct_progress};
+
+			const ulint	n_threads = std::min(
+				thd_ddl_threads(trx->mysql_thd), n_jobs);
+
+			os_thread_id_t*	thread_ids
+				= static_cast<os_thread_id_t*>(
+					ut_malloc_nokey(n_threads
+							* sizeof *thread_ids));
+
+			for (ulint t = 0; t < n_threads; t++) {
+				os_thread_create(row_merge_build_thread, &ctx,
+						 &thread_ids[t]);
+			}
+
+			for (ulint t = 0; t < n_threads; t++) {
+				os_thread_join(thread_ids[t]);
+			}
+
+			ut_free(thread_ids);
+		} else {
+			/* Nothing to do in parallel. */
+			n_jobs = 0;
+		}
+	}
+
+	for (ulint k = 0, i = 0; i < n_indexes; i++) {
+		dict_index_t*	sort_idx = indexes[i];
+
+		if (dict_index_is_spatial(sort_idx)) {
+			continue;
+		}
+
+		if (indexes[i]->type & DICT_FTS) {
+			os_event_t	fts_parallel_merge_event;
+
+			sort_idx = fts_sort_idx;
+
+			fts_parallel_merge_event
+				= merge_info[0].psort_common->merge_event;
+
+			if (FTS_PLL_MERGE) {
+				ulint	trial_count = 0;
+				bool	all_exit = false;
+
+				os_event_reset(fts_parallel_merge_event);
+				row_fts_start_parallel_merge(merge_info);
 wait_again:
 				os_event_wait_time_low(
 					fts_parallel_merge_event, 1000000,
@@ -4833,6 +5826,19 @@ row_merge_build_indexes(
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (row_merge_build_job_t* job
+			   = row_merge_build_find_job(jobs, n_jobs,
+						      indexes[i])) {
+			/* The index was built by row_merge_build_thread() */
+			error = job->error;
+
+			pct_progress += (COST_BUILD_INDEX_STATIC
+					 + (total_dynamic_cost
+					    * merge_files[k].offset
+					    / total_index_blocks))
+				/ (total_static_cost + total_dynamic_cost)
+				* (PCT_COST_MERGESORT_INDEX
+				   + PCT_COST_INSERT_INDEX) * 100;
 		} else if (merge_files[k].fd != OS_FILE_CLOSED) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
@@ -4995,6 +6001,10 @@ row_merge_build_indexes(
 		row_merge_file_destroy(&merge_files[i]);
 	}
 
+	if (jobs != NULL) {
+		ut_free(jobs);
+	}
+
 	if (fts_sort_idx) {
 		dict_mem_index_free(fts_sort_idx);
 	}
@@ -5081,3 +6091,412 @@ row_merge_build_indexes(
 
 	DBUG_RETURN(error);
 }
+
+/** Buffered bulk insert into an empty table. The rows are buffered
+in a sort buffer for each index. Full sort buffers are written as sorted
+runs to temporary files. At the end of the statement, the runs are
+merged and the index trees are built bottom-up by BtrBulk. */
+struct row_merge_bulk_t
+{
+	/** the table that is being inserted into */
+	dict_table_t*		table;
+	/** MySQL table, for reporting duplicate keys */
+	TABLE*			mysql_table;
+	/** number of indexes */
+	ulint			n_index;
+	/** sort buffers, one for each index */
+	row_merge_buf_t**	buf;
+	/** merge files, one for each index */
+	merge_file_t*		files;
+	/** temporary file for merge sort */
+	pfs_os_file_t		tmpfd;
+	/** directory for the temporary files, or NULL for the default */
+	const char*		path;
+	/** file buffer of 3 * srv_sort_buf_size bytes */
+	row_merge_block_t*	block;
+	/** allocation information of block */
+	ut_new_pfx_t		block_pfx;
+	/** buffer for encrypting the temporary files, or NULL */
+	row_merge_block_t*	crypt_block;
+	/** allocation information of crypt_block */
+	ut_new_pfx_t		crypt_pfx;
+	/** largest buffered AUTO_INCREMENT value */
+	ib_uint64_t		autoinc;
+	/** number of buffered rows */
+	ulint			n_rows;
+};
+
+/** Determine if a bulk insert can be used on a table.
+@param[in]	trx	transaction
+@param[in]	table	table that is being inserted into
+@return whether the rows may be buffered and loaded by BtrBulk */
+static
+bool
+row_merge_bulk_eligible(const trx_t* trx, const dict_table_t* table)
+{
+	const dict_index_t*	clust = dict_table_get_first_index(table);
+
+	if (!trx->id || table->is_temporary() || table->no_rollback()
+	    || table->skip_alter_undo || table->versioned()
+	    || table->fts || clust->is_instant()
+	    || dict_table_is_corrupted(table)
+	    || (trx->check_foreigns && !table->foreign_set.empty())) {
+		return(false);
+	}
+
+	for (const dict_index_t* index = clust; index != NULL;
+	     index = dict_table_get_next_index(index)) {
+		if (index->has_virtual() || dict_index_is_spatial(index)
+		    || index->is_corrupted()
+		    || dict_index_is_online_ddl(index)
+		    || index->online_status != ONLINE_INDEX_COMPLETE) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/** Start a bulk insert into an empty table, if the table is eligible.
+The table will be locked exclusively, and a single TRX_UNDO_EMPTY undo
+log record will be written, so that a rollback can empty the table.
+@param[in,out]	trx		transaction
+@param[in,out]	table		table that is being inserted into
+@param[in]	mysql_table	MySQL table, for reporting duplicate keys
+@param[out]	bulk		the bulk insert, or NULL if the rows must be
+				inserted one by one
+@return error code */
+dberr_t
+row_merge_bulk_start(
+	trx_t*			trx,
+	dict_table_t*		table,
+	TABLE*			mysql_table,
+	row_merge_bulk_t**	bulk)
+{
+	*bulk = NULL;
+
+	ut_ad(!srv_read_only_mode);
+
+	if (!row_merge_bulk_eligible(trx, table)) {
+		return(DB_SUCCESS);
+	}
+
+	dberr_t	err = lock_table_for_trx(table, trx, LOCK_X);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	/* With the exclusive table lock, no other transaction can
+	insert records. Check that every index is empty, and discard
+	any PAGE_GARBAGE of purged records from the root pages,
+	because BtrBulk rebuilds the root page from scratch. */
+	ulint	n_index = 0;
+
+	for (dict_index_t* index = dict_table_get_first_index(table);
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+		mtr_t	mtr;
+
+		mtr.start();
+		index->set_modified(mtr);
+		mtr_x_lock(&index->lock, &mtr);
+
+		buf_block_t*	root = btr_root_block_get(
+			index, RW_X_LATCH, &mtr);
+		const bool	empty = root != NULL
+			&& page_is_leaf(root->frame)
+			&& !page_get_n_recs(root->frame);
+
+		if (empty && page_dir_get_n_heap(root->frame)
+		    != PAGE_HEAP_NO_USER_LOW) {
+			btr_page_empty(root, buf_block_get_page_zip(root),
+				       index, 0, &mtr);
+			if (!dict_index_is_clust(index)) {
+				ibuf_reset_free_bits(root);
+			}
+		}
+
+		mtr.commit();
+
+		if (!empty) {
+			return(DB_SUCCESS);
+		}
+
+		n_index++;
+	}
+
+	err = trx_undo_report_empty(trx, table);
+
+	if (err != DB_SUCCESS) {
+		return(err);
+	}
+
+	row_merge_bulk_t*	b = UT_NEW_NOKEY(row_merge_bulk_t());
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	const size_t		block_size = 3 * srv_sort_buf_size;
+
+	b->table = table;
+	b->mysql_table = mysql_table;
+	b->n_index = n_index;
+	b->tmpfd = OS_FILE_CLOSED;
+	b->path = thd_innodb_tmpdir(trx->mysql_thd);
+	b->buf = static_cast<row_merge_buf_t**>(
+		ut_zalloc_nokey(n_index * sizeof *b->buf));
+	b->files = static_cast<merge_file_t*>(
+		ut_zalloc_nokey(n_index * sizeof *b->files));
+	b->block = alloc.allocate_large(block_size, &b->block_pfx);
+
+	if (b->block != NULL && log_tmp_is_encrypted()) {
+		b->crypt_block = alloc.allocate_large(
+			block_size, &b->crypt_pfx);
+		if (b->crypt_block == NULL) {
+			err = DB_OUT_OF_MEMORY;
+		}
+	} else if (b->block == NULL) {
+		err = DB_OUT_OF_MEMORY;
+	}
+
+	ulint	i = 0;
+
+	for (dict_index_t* index = dict_table_get_first_index(table);
+	     index != NULL;
+	     index = dict_table_get_next_index(index), i++) {
+		b->buf[i] = row_merge_buf_create(index);
+		b->files[i].fd = OS_FILE_CLOSED;
+	}
+
+	if (err != DB_SUCCESS) {
+		/* The TRX_UNDO_EMPTY record was already written.
+		The statement will be rolled back. */
+		row_merge_bulk_free(b);
+		return(err);
+	}
+
+	*bulk = b;
+	return(DB_SUCCESS);
+}
+
+/** Sort the buffered entries of an index and write them
+to the merge file of the index.
+@param[in,out]	bulk	bulk insert
+@param[in]	i	index number
+@param[in,out]	trx	transaction
+@return error code */
+static
+dberr_t
+row_merge_bulk_write(row_merge_bulk_t* bulk, ulint i, trx_t* trx)
+{
+	row_merge_buf_t*	buf = bulk->buf[i];
+	merge_file_t*		file = &bulk->files[i];
+	row_merge_dup_t		dup = {
+		buf->index, bulk->mysql_table, NULL, 0};
+
+	row_merge_buf_sort(buf, dict_index_is_unique(buf->index)
+			   ? &dup : NULL);
+
+	if (dup.n_dup) {
+		trx->error_info = buf->index;
+		return(DB_DUPLICATE_KEY);
+	}
+
+	if (!row_merge_file_create_if_needed(file, &bulk->tmpfd,
+					     buf->n_tuples, bulk->path)) {
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	row_merge_buf_write(buf, file, bulk->block);
+
+	if (!row_merge_write(file->fd, file->offset++, bulk->block,
+			     bulk->crypt_block, bulk->table->space_id)) {
+		return(DB_TEMP_FILE_WRITE_FAIL);
+	}
+
+	UNIV_MEM_INVALID(&bulk->block[0], srv_sort_buf_size);
+	bulk->buf[i] = row_merge_buf_empty(buf);
+	return(DB_SUCCESS);
+}
+
+/** Buffer a row for a bulk insert.
+@param[in,out]	bulk	bulk insert
+@param[in]	row	row to insert, including DB_TRX_ID and DB_ROLL_PTR
+@param[in,out]	trx	transaction
+@return error code
+@retval	DB_OVERFLOW	if the row is too long to be buffered;
+			the caller must finish the bulk insert and insert
+			the row directly into the table */
+dberr_t
+row_merge_bulk_add(
+	row_merge_bulk_t*	bulk,
+	const dtuple_t*		row,
+	trx_t*			trx)
+{
+	/* Any record that fits in an index page also fits in
+	the sort buffer. Longer records would be stored off-page. */
+	if (dtuple_get_data_size(row, 0) > srv_page_size / 2) {
+		return(DB_OVERFLOW);
+	}
+
+	for (ulint i = 0; i < bulk->n_index; i++) {
+		dberr_t		err = DB_SUCCESS;
+		doc_id_t	doc_id = 0;
+		mem_heap_t*	v_heap = NULL;
+
+		while (!row_merge_buf_add(bulk->buf[i], NULL, bulk->table,
+					  bulk->table, NULL, row, NULL,
+					  &doc_id, NULL, &err, &v_heap,
+					  NULL, trx)) {
+			if (err != DB_SUCCESS) {
+				return(err);
+			}
+
+			if (!bulk->buf[i]->n_tuples) {
+				ut_ad(!"the row does not fit");
+				return(DB_TOO_BIG_RECORD);
+			}
+
+			/* The sort buffer is full. */
+			err = row_merge_bulk_write(bulk, i, trx);
+
+			if (err != DB_SUCCESS) {
+				return(err);
+			}
+		}
+
+		ut_ad(v_heap == NULL);
+		bulk->files[i].n_rec++;
+	}
+
+	if (unsigned ai = bulk->table->persistent_autoinc) {
+		const dict_col_t*	col = dict_index_get_nth_col(
+			dict_table_get_first_index(bulk->table), ai - 1);
+		const dfield_t*		dfield = dtuple_get_nth_field(
+			row, dict_col_get_no(col));
+
+		if (!dfield_is_null(dfield)) {
+			bulk->autoinc = std::max(
+				bulk->autoinc,
+				row_parse_int(
+					static_cast<const byte*>(
+						dfield->data),
+					dfield->len,
+					dfield->type.mtype,
+					dfield->type.prtype
+					& DATA_UNSIGNED));
+		}
+	}
+
+	bulk->n_rows++;
+	return(DB_SUCCESS);
+}
+
+/** Sort the buffered rows and load them into the indexes of the table,
+and free the bulk insert.
+@param[in,out]	bulk	bulk insert
+@param[in,out]	trx	transaction
+@return error code */
+dberr_t
+row_merge_bulk_finish(row_merge_bulk_t* bulk, trx_t* trx)
+{
+	dict_table_t*	table = bulk->table;
+	dberr_t		err = DB_SUCCESS;
+
+	/* The clustered index is loaded first, so that a duplicate
+	PRIMARY KEY will be reported before any duplicate in a
+	UNIQUE secondary index. */
+	for (ulint i = 0; bulk->n_rows && i < bulk->n_index; i++) {
+		row_merge_buf_t*	buf = bulk->buf[i];
+		merge_file_t*		file = &bulk->files[i];
+		dict_index_t*		index = buf->index;
+		row_merge_dup_t		dup = {
+			index, bulk->mysql_table, NULL, 0};
+		/* DB_TRX_ID and DB_ROLL_PTR were written by the caller,
+		and the TRX_UNDO_EMPTY record covers the rollback.
+		The pages are redo logged, because the table was
+		not created by this transaction. */
+		BtrBulk			btr_bulk(index, trx, NULL);
+
+		if (file->fd == OS_FILE_CLOSED) {
+			/* All entries fit in the sort buffer. */
+			row_merge_buf_sort(buf, dict_index_is_unique(index)
+					   ? &dup : NULL);
+
+			if (dup.n_dup) {
+				err = DB_DUPLICATE_KEY;
+			} else {
+				err = row_merge_insert_index_tuples(
+					index, table, OS_FILE_CLOSED, NULL,
+					buf, &btr_bulk, 0, 0, 0,
+					bulk->crypt_block, table->space_id);
+			}
+		} else {
+			if (buf->n_tuples) {
+				err = row_merge_bulk_write(bulk, i, trx);
+			}
+
+			if (err == DB_SUCCESS) {
+				err = row_merge_sort(
+					trx, &dup, file, bulk->block,
+					&bulk->tmpfd, false, 0, 0,
+					bulk->crypt_block, table->space_id,
+					NULL);
+			}
+
+			if (err == DB_SUCCESS) {
+				err = row_merge_insert_index_tuples(
+					index, table, file->fd, bulk->block,
+					NULL, &btr_bulk, file->n_rec, 0, 0,
+					bulk->crypt_block, table->space_id);
+			}
+		}
+
+		err = btr_bulk.finish(err);
+
+		if (err != DB_SUCCESS) {
+			if (err == DB_DUPLICATE_KEY) {
+				trx->error_info = index;
+			}
+			break;
+		}
+	}
+
+	if (err == DB_SUCCESS && bulk->autoinc) {
+		btr_write_autoinc(dict_table_get_first_index(table),
+				  bulk->autoinc);
+	}
+
+	row_merge_bulk_free(bulk);
+	return(err);
+}
+
+/** Free a bulk insert without loading the buffered rows.
+@param[in,out]	bulk	bulk insert */
+void
+row_merge_bulk_free(row_merge_bulk_t* bulk)
+{
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	const size_t			block_size = 3 * srv_sort_buf_size;
+
+	for (ulint i = 0; i < bulk->n_index; i++) {
+		if (bulk->buf[i] != NULL) {
+			row_merge_buf_free(bulk->buf[i]);
+		}
+		row_merge_file_destroy(&bulk->files[i]);
+	}
+
+	row_merge_file_destroy_low(bulk->tmpfd);
+
+	if (bulk->block != NULL) {
+		alloc.deallocate_large(bulk->block, &bulk->block_pfx,
+				       block_size);
+	}
+
+	if (bulk->crypt_block != NULL) {
+		alloc.deallocate_large(bulk->crypt_block, &bulk->crypt_pfx,
+				       block_size);
+	}
+
+	ut_free(bulk->files);
+	ut_free(bulk->buf);
+	UT_DELETE(bulk);
+}
@@ -994,6 +994,10 @@ row_prebuilt_free(
 
 	ut_free(prebuilt->mysql_template);
 
+	if (prebuilt->bulk_insert) {
+		row_merge_bulk_free(prebuilt->bulk_insert);
+	}
+
 	if (prebuilt->ins_graph) {
 		que_graph_free_recursive(prebuilt->ins_graph);
 	}
@@ -1014,26 +1018,7 @@ row_prebuilt_free(
 		mem_heap_free(prebuilt->old_vers_heap);
 	}
 
-	if (prebuilt->fetch_cache[0] != NULL) {
-		byte*	base = prebuilt->fetch_cache[0] - 4;
-		byte*	ptr = base;
-
-		for (ulint i = 0; i < MYSQL_FETCH_CACHE_SIZE; i++) {
-			ulint	magic1 = mach_read_from_4(ptr);
-			ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-
-			byte*	row = ptr;
-			ut_a(row == prebuilt->fetch_cache[i]);
-			ptr += prebuilt->mysql_row_len;
-
-			ulint	magic2 = mach_read_from_4(ptr);
-			ut_a(magic2 == ROW_PREBUILT_FETCH_MAGIC_N);
-			ptr += 4;
-		}
-
-		ut_free(base);
-	}
+	row_sel_prefetch_cache_free(prebuilt);
 
 	if (prebuilt->rtr_info) {
 		rtr_clean_rtr_info(prebuilt->rtr_info, true);
@@ -1441,6 +1426,49 @@ row_insert_for_mysql(
 		}
 	}
 
+	if (prebuilt->bulk_insert_pending) {
+		prebuilt->bulk_insert_pending = false;
+		ut_ad(!prebuilt->bulk_insert);
+
+		err = row_merge_bulk_start(trx, table, prebuilt->m_mysql_table,
+					   &prebuilt->bulk_insert);
+		if (err != DB_SUCCESS) {
+			goto func_exit;
+		}
+	}
+
+	if (prebuilt->bulk_insert) {
+		if (!dict_index_is_unique(dict_table_get_first_index(table))) {
+			dict_sys_write_row_id(node->sys_buf,
+					      dict_sys_get_new_row_id());
+		}
+
+		trx_write_trx_id(&node->sys_buf[DATA_ROW_ID_LEN], trx->id);
+		trx_write_roll_ptr(&node->sys_buf[DATA_ROW_ID_LEN
+						  + DATA_TRX_ID_LEN],
+				   roll_ptr_t(1) << ROLL_PTR_INSERT_FLAG_POS);
+
+		err = row_merge_bulk_add(prebuilt->bulk_insert, node->row,
+					 trx);
+
+		if (err == DB_OVERFLOW) {
+			/* The row is too long to be buffered. Load the
+			buffered rows, and insert this and any further
+			rows one by one. */
+			err = row_merge_bulk_finish(prebuilt->bulk_insert,
+						    trx);
+			prebuilt->bulk_insert = NULL;
+
+			if (err != DB_SUCCESS) {
+				goto func_exit;
+			}
+		} else if (err != DB_SUCCESS) {
+			goto func_exit;
+		} else {
+			goto inserted;
+		}
+	}
+
 	savept = trx_savept_take(trx);
 
 	thr = que_fork_get_first_thr(prebuilt->ins_graph);
@@ -1559,6 +1587,7 @@ row_insert_for_mysql(
 
 	que_thr_stop_for_mysql_no_error(thr, trx);
 
+inserted:
 	if (table->is_system_db) {
 		srv_stats.n_system_rows_inserted.inc(size_t(trx->id));
 	} else {
@@ -1577,6 +1606,7 @@ row_insert_for_mysql(
 	}
 
 	dict_stats_update_if_needed(table, trx->mysql_thd);
+func_exit:
 	trx->op_info = "";
 
 	if (blob_heap != NULL) {
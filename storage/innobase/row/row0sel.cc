@@ -3686,8 +3686,41 @@ row_sel_dequeue_cached_row_for_mysql(
 	}
 }
 
+/** Free the prefetch cache.
+@param[in,out]	prebuilt	prebuilt struct */
+void row_sel_prefetch_cache_free(row_prebuilt_t* prebuilt)
+{
+	if (prebuilt->fetch_cache == NULL) {
+		return;
+	}
+
+	for (ulint i = 0; i < prebuilt->fetch_cache_size; i++) {
+		const byte*	row = prebuilt->fetch_cache[i];
+
+		ut_a(mach_read_from_4(row - 4) == ROW_PREBUILT_FETCH_MAGIC_N);
+		ut_a(mach_read_from_4(row + prebuilt->mysql_row_len)
+		     == ROW_PREBUILT_FETCH_MAGIC_N);
+	}
+
+	ut_free(prebuilt->fetch_cache);
+	prebuilt->fetch_cache = NULL;
+	prebuilt->fetch_cache_size = 0;
+}
+
+/** Determine the maximum number of rows in the prefetch cache.
+@param[in]	prebuilt	prebuilt struct
+@return maximum value of prebuilt->fetch_cache_limit */
+static ulint row_sel_prefetch_cache_max(const row_prebuilt_t* prebuilt)
+{
+	return std::max<ulint>(
+		MYSQL_FETCH_CACHE_SIZE,
+		std::min<ulint>(MYSQL_FETCH_CACHE_MAX_SIZE,
+				MYSQL_FETCH_CACHE_MAX_BYTES
+				/ (prebuilt->mysql_row_len + 8)));
+}
+
 /********************************************************************//**
-Initialise the prefetch cache. */
+Initialise the prefetch cache for prebuilt->fetch_cache_limit rows. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
@@ -3698,11 +3731,20 @@ row_sel_prefetch_cache_init(
 	ulint	sz;
 	byte*	ptr;
 
-	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
-	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
+	ut_ad(prebuilt->n_fetch_cached == 0);
+
+	row_sel_prefetch_cache_free(prebuilt);
+
+	const ulint	n = prebuilt->fetch_cache_limit;
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	/* Reserve space for the row pointers and the magic numbers. */
+	sz = n * (sizeof *prebuilt->fetch_cache
+		  + prebuilt->mysql_row_len + 8);
+	prebuilt->fetch_cache = static_cast<byte**>(ut_malloc_nokey(sz));
+	prebuilt->fetch_cache_size = n;
+	ptr = reinterpret_cast<byte*>(prebuilt->fetch_cache + n);
+
+	for (i = 0; i < n; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3729,12 +3771,11 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
-
-	if (prebuilt->fetch_cache[0] == NULL) {
-		/* Allocate memory for the fetch cache */
-		ut_ad(prebuilt->n_fetch_cached == 0);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
+	if (prebuilt->fetch_cache_size < prebuilt->fetch_cache_limit) {
+		/* Allocate memory for the fetch cache, or grow it
+		for a longer batch. */
 		row_sel_prefetch_cache_init(prebuilt);
 	}
 
@@ -4217,6 +4258,7 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -4241,6 +4283,7 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
@@ -4252,7 +4295,8 @@ row_search_mvcc(
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_limit) {
 
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -5354,7 +5398,7 @@ row_search_mvcc(
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5406,10 +5450,17 @@ row_search_mvcc(
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit) {
 			goto next_rec;
 		}
 
+		/* The batch filled up. The scan is likely to continue;
+		fetch more rows per call next time, to reduce the number
+		of times the cursor is stored and restored. */
+		prebuilt->fetch_cache_limit = std::min(
+			prebuilt->fetch_cache_limit * 2,
+			row_sel_prefetch_cache_max(prebuilt));
+
 	} else {
 		if (UNIV_UNLIKELY
 		    (prebuilt->template_type == ROW_MYSQL_DUMMY_TEMPLATE)) {
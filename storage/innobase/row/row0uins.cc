@@ -412,6 +412,7 @@ static bool row_undo_ins_parse_undo_rec(undo_node_t* node, bool dict_locked)
 		goto close_table;
 	case TRX_UNDO_INSERT_METADATA:
 	case TRX_UNDO_INSERT_REC:
+	case TRX_UNDO_EMPTY:
 		break;
 	case TRX_UNDO_RENAME_TABLE:
 		dict_table_t* table = node->table;
@@ -443,6 +444,9 @@ static bool row_undo_ins_parse_undo_rec(undo_node_t* node, bool dict_locked)
 		dict_table_close(node->table, dict_locked, FALSE);
 		node->table = NULL;
 		return false;
+	} else if (node->rec_type == TRX_UNDO_EMPTY) {
+		/* The whole table will be emptied in row_undo_ins(). */
+		ut_ad(!node->table->is_temporary());
 	} else {
 		ut_ad(!node->table->skip_alter_undo);
 		clust_index = dict_table_get_first_index(node->table);
@@ -564,6 +568,21 @@ row_undo_ins(
 	ut_ad(dict_index_is_clust(node->index));
 
 	switch (node->rec_type) {
+	case TRX_UNDO_EMPTY:
+		/* Roll back a bulk insert into an empty table. The table
+		is locked exclusively, and none of its rows were undo
+		logged, so we simply empty all the indexes. */
+		log_free_check();
+		for (dict_index_t* index = node->index; index;
+		     index = dict_table_get_next_index(index)) {
+			if (!(index->type & DICT_FTS)) {
+				btr_empty(index);
+			}
+		}
+
+		node->table->stat_n_rows = 0;
+		err = DB_SUCCESS;
+		break;
 	default:
 		ut_ad(!"wrong undo record type");
 	case TRX_UNDO_INSERT_REC:
@@ -378,6 +378,7 @@ static bool row_undo_rec_get(undo_node_t* node)
 		ut_ad(undo == update);
 		/* fall through */
 	case TRX_UNDO_RENAME_TABLE:
+	case TRX_UNDO_EMPTY:
 		ut_ad(undo == insert || undo == update);
 		/* fall through */
 	case TRX_UNDO_INSERT_REC:
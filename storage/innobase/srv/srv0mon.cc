@@ -141,6 +141,16 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_NUM_TABLELOCK},
 
+	{"lock_sys_latch_waits", "lock",
+	 "Number of times lock_sys.latch was waited for in exclusive mode",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOCK_SYS_LATCH_WAITS},
+
+	{"lock_rec_shard_waits", "lock",
+	 "Number of times a record lock hash table shard was waited for",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOCK_REC_SHARD_WAITS},
+
 	{"lock_row_lock_current_waits", "lock",
 	 "Number of row locks currently being waited for"
 	 " (innodb_row_lock_current_waits)",
@@ -431,6 +441,24 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_FLUSH_AVG_PASS},
 
+	{"buffer_flush_instance_stalls", "buffer",
+	 "Number of times the page cleaner did not wait for a slow"
+	 " buffer pool instance.",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_INSTANCE_STALLS},
+
+	{"buffer_flush_instance_max_rate", "buffer",
+	 "Pages per second flushed recently by the page cleaner from"
+	 " the fastest buffer pool instance.",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_INSTANCE_MAX_RATE},
+
+	{"buffer_flush_instance_min_rate", "buffer",
+	 "Pages per second flushed recently by the page cleaner from"
+	 " the slowest buffer pool instance.",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_FLUSH_INSTANCE_MIN_RATE},
+
 	{"buffer_LRU_get_free_loops", "buffer",
 	 "Total loops in LRU get free.",
 	 MONITOR_NONE,
@@ -623,6 +651,30 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_SET_MEMBER, MONITOR_LRU_UNZIP_SEARCH_SCANNED,
 	 MONITOR_LRU_UNZIP_SEARCH_SCANNED_PER_CALL},
 
+	{"buffer_LRU_ghost_added", "buffer",
+	 "Number of evicted pages remembered by"
+	 " innodb_buffer_pool_lru_policy=2q",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GHOST_ADDED},
+
+	{"buffer_LRU_ghost_hits", "buffer",
+	 "Number of pages read into the new sublist of the LRU list"
+	 " because they were evicted recently",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GHOST_HITS},
+
+	{"buffer_LRU_unzip_refetched", "buffer",
+	 "Number of compressed pages decompressed again"
+	 " after their uncompressed frame was evicted",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_UNZIP_REFETCH},
+
+	{"buffer_LRU_unzip_kept", "buffer",
+	 "Number of uncompressed frames skipped in the unzip LRU search"
+	 " because their index is frequently decompressed again",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_UNZIP_KEPT},
+
 	/* ========== Counters for Buffer Page I/O ========== */
 	{"module_buffer_page", "buffer_page_io", "Buffer Page I/O Module",
 	 static_cast<monitor_type_t>(
@@ -863,6 +915,11 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DISPLAY_CURRENT,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_RESUME_COUNT},
 
+	{"purge_batch_size", "purge",
+	 "Number of undo log pages in the current purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_BATCH_SIZE},
+
 	/* ========== Counters for Recovery Module ========== */
 	{"module_log", "recovery", "Recovery Module",
 	 MONITOR_MODULE,
@@ -1038,6 +1095,33 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_INDEX_DISCARD},
 
+	{"index_range_cache_hits", "index",
+	 "Number of records_in_range estimates made from the cached"
+	 " node pointers (innodb_records_in_range_cache)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_INDEX_RANGE_CACHE_HIT},
+
+	{"index_range_cache_dives", "index",
+	 "Number of records_in_range estimates that dived into the index",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_INDEX_RANGE_CACHE_DIVE},
+
+	{"index_range_cache_refreshes", "index",
+	 "Number of times the cached node pointers of an index were rebuilt",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_INDEX_RANGE_CACHE_REFRESH},
+
+	{"index_range_cache_checks", "index",
+	 "Number of cached records_in_range estimates compared to a dive",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_INDEX_RANGE_CACHE_CHECK},
+
+	{"index_range_cache_checks_off", "index",
+	 "Number of compared cached records_in_range estimates that were"
+	 " off by more than a factor of 2",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_INDEX_RANGE_CACHE_CHECK_OFF},
+
 #ifdef BTR_CUR_HASH_ADAPT
 	/* ========== Counters for Adaptive Hash Index ========== */
 	{"module_adaptive_hash", "adaptive_hash_index", "Adaptive Hash Index",
@@ -1089,6 +1173,18 @@ static monitor_info_t	innodb_counter_info[] =
 	 "Number of Adaptive Hash Index rows updated",
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_ROW_UPDATED},
+
+	{"adaptive_hash_auto_disabled", "adaptive_hash_index",
+	 "Number of times the Adaptive Hash Index was disabled for an index"
+	 " (innodb_adaptive_hash_index_auto)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_AUTO_DISABLED},
+
+	{"adaptive_hash_auto_enabled", "adaptive_hash_index",
+	 "Number of times the Adaptive Hash Index was re-enabled for an index"
+	 " (innodb_adaptive_hash_index_auto)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_AUTO_ENABLED},
 #endif /* BTR_CUR_HASH_ADAPT */
 
 	/* ========== Counters for tablespace ========== */
@@ -1153,6 +1249,23 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_SIZE},
 
+	{"ibuf_merge_pending", "change_buffer",
+	 "Pages queued for the change buffer merge threads to read",
+	 static_cast<monitor_type_t>(
+	 MONITOR_EXISTING | MONITOR_DISPLAY_CURRENT),
+	 MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_MERGE_PENDING},
+
+	{"ibuf_merge_thread_pages", "change_buffer",
+	 "Pages read for merging by the change buffer merge threads",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_THREAD_PAGES},
+
+	{"ibuf_contract_on_insert", "change_buffer",
+	 "Number of times a user thread contracted the change buffer"
+	 " when buffering a change",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_IBUF_CONTRACT_ON_INSERT},
+
 	/* ========== Counters for server operations ========== */
 	{"module_innodb", "innodb",
 	 "Counter for general InnoDB server wide operations and properties",
@@ -1378,6 +1491,12 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ALTER_TABLE_LOG_FILES},
 
+	{"ddl_online_log_catchup", "ddl",
+	 "Number of times the online rebuild log was applied while"
+	 " ALTER TABLE was waiting for the exclusive table lock",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ONLINE_LOG_CATCHUP},
+
 	/* ===== Counters for ICP (Index Condition Pushdown) Module ===== */
 	{"module_icp", "icp", "Index Condition Pushdown",
 	 MONITOR_MODULE,
@@ -1979,6 +2098,10 @@ srv_mon_process_existing_counter(
 		value = ibuf->size;
 		break;
 
+	case MONITOR_OVLD_IBUF_MERGE_PENDING:
+		value = ibuf->merge_pending;
+		break;
+
 	case MONITOR_OVLD_SERVER_ACTIVITY:
 		value = srv_get_activity_count();
 		break;
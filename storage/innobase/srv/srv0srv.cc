@@ -155,12 +155,18 @@ ibool	srv_locks_unsafe_for_binlog;
 ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
+/** Size of the online table rebuild log above which the log is applied
+while ALTER TABLE is waiting for the exclusive table lock, or 0 */
+unsigned long long	srv_online_catchup_size;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
+/** innodb_use_io_uring: whether to submit asynchronous I/O through
+io_uring instead of libaio (Linux only) */
+my_bool	srv_use_io_uring;
 my_bool	srv_numa_interleave;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
@@ -256,6 +262,8 @@ ulong	srv_idle_flush_pct;
 ulong	srv_n_read_io_threads;
 /** innodb_write_io_threads */
 ulong	srv_n_write_io_threads;
+/** innodb_recovery_apply_threads */
+ulong	srv_n_recv_apply_threads = 4;
 
 /** innodb_random_read_ahead */
 my_bool	srv_random_read_ahead;
@@ -364,6 +372,20 @@ my_bool		srv_stats_auto_recalc;
 we calculate new statistics (default 0 = current limits) */
 unsigned long long srv_stats_modified_counter;
 
+/** innodb_stats_threads; number of threads for sampling the indexes
+of a table when calculating persistent statistics */
+ulong	srv_stats_threads;
+
+/** innodb_stats_incremental_recalc; maximum number of consecutive
+automatic recalculations of persistent statistics that extrapolate
+from the index sizes instead of sampling the indexes (0=always sample) */
+ulong	srv_stats_incremental_recalc;
+
+/** innodb_records_in_range_cache; maximum number of node pointers per
+index that are cached for estimating the number of records in a range
+(0=always dive into the index) */
+ulong	srv_records_in_range_cache;
+
 /** innodb_stats_traditional; enable traditional statistic calculation
 based on number of configured pages */
 my_bool	srv_stats_sample_traditional;
@@ -1681,7 +1703,7 @@ DECLARE_THREAD(srv_monitor_thread)(void*)
 		if (srv_print_innodb_monitor) {
 			/* Reset mutex_skipped counter everytime
 			srv_print_innodb_monitor changes. This is to
-			ensure we will not be blocked by lock_sys.mutex
+			ensure we will not be blocked by lock_sys.latch
 			for short duration information printing,
 			such as requested by sync_array_print_long_waits() */
 			if (!last_srv_print_monitor) {
@@ -2422,8 +2444,9 @@ static bool srv_purge_should_exit()
 
 /*********************************************************************//**
 Fetch and execute a task from the work queue.
+@param[in]	id	purge worker number, starting from 1
 @return true if a task was executed */
-static bool srv_task_execute()
+static bool srv_task_execute(ulint id)
 {
 	ut_ad(!srv_read_only_mode);
 	ut_ad(srv_force_recovery < SRV_FORCE_NO_BACKGROUND);
@@ -2434,7 +2457,7 @@ static bool srv_task_execute()
 		ut_a(que_node_get_type(thr->child) == QUE_NODE_PURGE);
 		UT_LIST_REMOVE(srv_sys.tasks, thr);
 		mutex_exit(&srv_sys.tasks_mutex);
-		que_run_threads(thr);
+		trx_purge_run_task(thr, id);
 	        purge_sys.n_tasks.fetch_sub(1, std::memory_order_release);
 		return true;
 	}
@@ -2474,15 +2497,23 @@ DECLARE_THREAD(srv_worker_thread)(
 	ut_a(ulong(srv_sys.n_threads_active[SRV_WORKER])
 	     < srv_n_purge_threads);
 
+	const ulint	id = ulint(slot - &srv_sys.sys_threads[SRV_PURGE_SLOT]);
+	ut_a(id > 0 && id < purge_sys_t::MAX_THREADS);
+
 	/* We need to ensure that the worker threads exit after the
 	purge coordinator thread. Otherwise the purge coordinator can
 	end up waiting forever in trx_purge_wait_for_workers_to_complete() */
 
 	do {
+		const ulonglong	start = my_interval_timer();
+
 		srv_suspend_thread(slot);
 		srv_resume_thread(slot);
 
-		if (srv_task_execute()) {
+		purge_sys.thread_stats[id].idle_us
+			+= (my_interval_timer() - start) / 1000;
+
+		if (srv_task_execute(id)) {
 
 			/* If there are tasks in the queue, wakeup
 			the purge coordinator thread. */
@@ -2520,6 +2551,7 @@ srv_do_purge(ulint* n_total_purged)
 
 	static ulint	count = 0;
 	static ulint	n_use_threads = 0;
+	static ulint	batch_size = 0;
 	static uint32_t	rseg_history_len = 0;
 	ulint		old_activity_count = srv_get_activity_count();
 	const ulint	n_threads = srv_n_purge_threads;
@@ -2537,29 +2569,57 @@ srv_do_purge(ulint* n_total_purged)
 		n_use_threads = n_threads;
 	}
 
+	/* The batch size may grow up to this multiple of
+	innodb_purge_batch_size when the history keeps growing. */
+	const ulint	max_batch_size = srv_purge_batch_size * 8;
+
+	if (batch_size < srv_purge_batch_size) {
+		batch_size = srv_purge_batch_size;
+	} else if (batch_size > max_batch_size) {
+		batch_size = max_batch_size;
+	}
+
 	do {
 		if (trx_sys.rseg_history_len > rseg_history_len
 		    || (srv_max_purge_lag > 0
 			&& rseg_history_len > srv_max_purge_lag)) {
 
 			/* History length is now longer than what it was
-			when we took the last snapshot. Use more threads. */
+			when we took the last snapshot. Use more threads
+			and bigger batches. */
 
 			if (n_use_threads < n_threads) {
 				++n_use_threads;
 			}
 
-		} else if (srv_check_activity(old_activity_count)
-			   && n_use_threads > 1) {
+			if (batch_size < max_batch_size) {
+				batch_size = std::min(batch_size * 2,
+						      max_batch_size);
+			}
 
-			/* History length same or smaller since last snapshot,
-			use fewer threads. */
+		} else {
+			/* History length same or smaller since last
+			snapshot, use smaller batches, so that the purge
+			view is refreshed more often. */
 
-			--n_use_threads;
+			if (batch_size > srv_purge_batch_size) {
+				batch_size = std::max(batch_size / 2,
+						      ulint(srv_purge_batch_size));
+			}
 
-			old_activity_count = srv_get_activity_count();
+			if (srv_check_activity(old_activity_count)
+			    && n_use_threads > 1) {
+
+				/* Use fewer threads. */
+
+				--n_use_threads;
+
+				old_activity_count = srv_get_activity_count();
+			}
 		}
 
+		MONITOR_SET(MONITOR_PURGE_BATCH_SIZE, batch_size);
+
 		/* Ensure that the purge threads are less than what
 		was configured. */
 
@@ -2572,7 +2632,7 @@ srv_do_purge(ulint* n_total_purged)
 		}
 
 		n_pages_purged = trx_purge(
-			n_use_threads,
+			n_use_threads, batch_size,
 			!(++count % srv_purge_rseg_truncate_frequency)
 			|| purge_sys.truncate.current);
 
@@ -1369,6 +1369,7 @@ dberr_t srv_start(bool create_new_db)
 			    + 1 /* dict_stats_thread */
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
+			    + 1 /* recv_read_ahead_thread */
 			    + 1 /* trx_rollback_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -1377,6 +1378,7 @@ dberr_t srv_start(bool create_new_db)
 			    + srv_n_write_io_threads
 			    + srv_n_purge_threads
 			    + srv_n_page_cleaners
+			    + srv_n_recv_apply_threads
 			    /* FTS Parallel Sort */
 			    + fts_sort_pll_degree * FTS_NUM_AUX_INDEX
 			      * max_connections;
@@ -1537,6 +1539,8 @@ dberr_t srv_start(bool create_new_db)
 			buf_flush_set_page_cleaner_thread_cnt(srv_n_page_cleaners);
 		}
 
+		buf_flush_compress_threads_create();
+
 #ifdef UNIV_LINUX
 		/* Wait for the setpriority() call to finish. */
 		os_event_wait(recv_sys->flush_end);
@@ -2268,6 +2272,10 @@ dberr_t srv_start(bool create_new_db)
 						   + thread_ids);
 			thread_started[1 + SRV_MAX_N_IO_THREADS] = true;
 			srv_start_state_set(SRV_START_STATE_MASTER);
+
+			if (srv_force_recovery < SRV_FORCE_NO_IBUF_MERGE) {
+				ibuf_merge_threads_create();
+			}
 		}
 	}
 
@@ -175,6 +175,7 @@ void purge_sys_t::create()
   mutex_create(LATCH_ID_PURGE_SYS_PQ, &pq_mutex);
   truncate.current= NULL;
   truncate.last= NULL;
+  memset(thread_stats, 0, sizeof thread_stats);
 }
 
 /** Close the purge subsystem on shutdown. */
@@ -1105,68 +1106,57 @@ trx_purge_fetch_next_rec(
 }
 
 /** Run a purge batch.
+The undo log records are partitioned by table_id, so that each purge
+thread owns a distinct set of tables and the threads do not contend
+for the same dict_table_t and index pages.
 @param n_purge_threads	number of purge threads
+@param batch_size	number of undo log pages to handle in the batch
 @return number of undo log pages handled in the batch */
 static
 ulint
-trx_purge_attach_undo_recs(ulint n_purge_threads)
+trx_purge_attach_undo_recs(ulint n_purge_threads, ulint batch_size)
 {
 	que_thr_t*	thr;
 	ulint		i;
 	ulint		n_pages_handled = 0;
 	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys.query->thrs);
+	purge_node_t*	nodes[purge_sys_t::MAX_THREADS];
 
 	ut_a(n_purge_threads > 0);
+	ut_a(n_purge_threads <= purge_sys_t::MAX_THREADS);
 
 	purge_sys.head = purge_sys.tail;
 
-#ifdef UNIV_DEBUG
 	i = 0;
-	/* Debug code to validate some pre-requisites and reset done flag. */
 	for (thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
 	     thr != NULL && i < n_purge_threads;
 	     thr = UT_LIST_GET_NEXT(thrs, thr), ++i) {
 
-		purge_node_t*		node;
+		ut_a(!thr->is_active);
 
 		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
+		purge_node_t*	node = (purge_node_t*) thr->child;
 
-		ut_ad(que_node_get_type(node) == QUE_NODE_PURGE);
+		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
 		ut_ad(node->undo_recs == NULL);
 		ut_ad(!node->in_progress);
 		ut_d(node->in_progress = true);
+		nodes[i] = node;
 	}
 
 	/* There should never be fewer nodes than threads, the inverse
 	however is allowed because we only use purge threads as needed. */
-	ut_ad(i == n_purge_threads);
-#endif
-
-	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
+	ut_a(n_thrs > 0 && i == n_purge_threads);
 
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
-	i = 0;
+	/* The records are fetched to a scratch heap, and copied to the
+	heap of the purge node that owns the table. */
+	mem_heap_t*	heap = mem_heap_create(srv_page_size);
 
-	const ulint batch_size = srv_purge_batch_size;
+	i = 0;
 
 	while (UNIV_LIKELY(srv_undo_sources) || !srv_fast_shutdown) {
-		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
-
-		ut_a(!thr->is_active);
-
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
-
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
 
@@ -1174,40 +1164,61 @@ trx_purge_attach_undo_recs(ulint n_purge_threads)
 			purge_sys.head = purge_sys.tail;
 		}
 
+		roll_ptr_t	roll_ptr;
+
 		/* Fetch the next record, and advance the purge_sys.tail. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
-
-		if (purge_rec->undo_rec != NULL) {
-
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
+		trx_undo_rec_t*	undo_rec = trx_purge_fetch_next_rec(
+			&roll_ptr, &n_pages_handled, heap);
 
-			ib_vector_push(node->undo_recs, purge_rec);
+		if (undo_rec == NULL) {
+			break;
+		}
 
-			if (n_pages_handled >= batch_size) {
+		purge_node_t*	node;
 
-				break;
-			}
+		if (undo_rec == &trx_purge_dummy_rec) {
+			node = nodes[i++ % n_purge_threads];
 		} else {
-			break;
+			ulint		type;
+			ulint		cmpl_info;
+			bool		updated_extern;
+			undo_no_t	undo_no;
+			table_id_t	table_id;
+
+			trx_undo_rec_get_pars(undo_rec, &type, &cmpl_info,
+					      &updated_extern, &undo_no,
+					      &table_id);
+
+			node = nodes[table_id % n_purge_threads];
+			undo_rec = trx_undo_rec_copy(undo_rec, node->heap);
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		trx_purge_rec_t*	purge_rec = static_cast<trx_purge_rec_t*>(
+			mem_heap_alloc(node->heap, sizeof(*purge_rec)));
+
+		purge_rec->undo_rec = undo_rec;
+		purge_rec->roll_ptr = roll_ptr;
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys.query->thrs);
+		if (node->undo_recs == NULL) {
+			node->undo_recs = ib_vector_create(
+				ib_heap_allocator_create(node->heap),
+				sizeof(trx_purge_rec_t),
+				batch_size);
+		} else {
+			ut_a(!ib_vector_is_empty(node->undo_recs));
 		}
 
-		ut_a(thr != NULL);
+		ib_vector_push(node->undo_recs, purge_rec);
+
+		mem_heap_empty(heap);
+
+		if (n_pages_handled >= batch_size) {
+			break;
+		}
 	}
 
+	mem_heap_free(heap);
+
 	ut_ad(purge_sys.head <= purge_sys.tail);
 
 	return(n_pages_handled);
@@ -1273,6 +1284,26 @@ trx_purge_wait_for_workers_to_complete()
 	ut_a(srv_get_task_queue_length() == 0);
 }
 
+/** Run a purge task and account for it in purge_sys.thread_stats.
+@param[in,out]	thr	purge query thread
+@param[in]	id	purge thread: 0=coordinator, 1.. = worker */
+void trx_purge_run_task(que_thr_t* thr, ulint id)
+{
+	ut_ad(id < purge_sys_t::MAX_THREADS);
+
+	purge_node_t*	node = static_cast<purge_node_t*>(thr->child);
+	ut_ad(que_node_get_type(node) == QUE_NODE_PURGE);
+	purge_sys_t::thread_stats_t&	stats = purge_sys.thread_stats[id];
+
+	if (node->undo_recs) {
+		stats.n_recs += ib_vector_size(node->undo_recs);
+	}
+
+	const ulonglong	start = my_interval_timer();
+	que_run_threads(thr);
+	stats.busy_us += (my_interval_timer() - start) / 1000;
+}
+
 /*******************************************************************//**
 This function runs a purge batch.
 @return number of undo log pages handled in the batch */
@@ -1281,6 +1312,8 @@ trx_purge(
 /*======*/
 	ulint	n_purge_threads,	/*!< in: number of purge tasks
 					to submit to the work queue */
+	ulint	batch_size,		/*!< in: number of undo log pages
+					to handle in the batch */
 	bool	truncate)		/*!< in: truncate history if true */
 {
 	que_thr_t*	thr = NULL;
@@ -1304,7 +1337,8 @@ trx_purge(
 #endif /* UNIV_DEBUG */
 
 	/* Fetch the UNDO recs that need to be purged. */
-	n_pages_handled = trx_purge_attach_undo_recs(n_purge_threads);
+	n_pages_handled = trx_purge_attach_undo_recs(n_purge_threads,
+						     batch_size);
 	purge_sys.n_tasks.store(n_purge_threads - 1, std::memory_order_relaxed);
 
 	/* Submit tasks to workers queue if using multi-threaded purge. */
@@ -1316,10 +1350,15 @@ trx_purge(
 
 	thr = que_fork_scheduler_round_robin(purge_sys.query, thr);
 
-	que_run_threads(thr);
+	trx_purge_run_task(thr, 0);
+
+	const ulonglong	start = my_interval_timer();
 
 	trx_purge_wait_for_workers_to_complete();
 
+	purge_sys.thread_stats[0].idle_us
+		+= (my_interval_timer() - start) / 1000;
+
 	ut_ad(purge_sys.n_tasks.load(std::memory_order_relaxed) == 0);
 
 	if (truncate) {
@@ -2043,6 +2043,105 @@ dberr_t trx_undo_report_rename(trx_t* trx, const dict_table_t* table)
 	return err;
 }
 
+/** Write a TRX_UNDO_EMPTY undo log record.
+@param[in]	trx	transaction
+@param[in]	table	table that is being bulk loaded
+@param[in,out]	block	undo page
+@param[in,out]	mtr	mini-transaction
+@return byte offset of the undo log record
+@retval 0 in case of failure */
+static
+ulint
+trx_undo_page_report_empty(
+	const trx_t*		trx,
+	const dict_table_t*	table,
+	buf_block_t*		block,
+	mtr_t*			mtr)
+{
+	byte*	ptr_first_free  = TRX_UNDO_PAGE_HDR + TRX_UNDO_PAGE_FREE
+		+ block->frame;
+	ulint	first_free = mach_read_from_2(ptr_first_free);
+	ut_ad(first_free >= TRX_UNDO_PAGE_HDR + TRX_UNDO_PAGE_HDR_SIZE);
+	ut_ad(first_free <= srv_page_size);
+	byte* start = block->frame + first_free;
+	const size_t fixed = 2 + 1 + 11 + 11 + 2;
+
+	if (trx_undo_left(block, start) < fixed) {
+		ut_ad(first_free > TRX_UNDO_PAGE_HDR
+		      + TRX_UNDO_PAGE_HDR_SIZE);
+		return 0;
+	}
+
+	byte* ptr = start + 2;
+	*ptr++ = TRX_UNDO_EMPTY;
+	ptr += mach_u64_write_much_compressed(ptr, trx->undo_no);
+	ptr += mach_u64_write_much_compressed(ptr, table->id);
+	mach_write_to_2(ptr, first_free);
+	ptr += 2;
+	ulint offset = page_offset(ptr);
+	mach_write_to_2(start, offset);
+	mach_write_to_2(ptr_first_free, offset);
+
+	trx_undof_page_add_undo_rec_log(block, first_free, offset, mtr);
+	return first_free;
+}
+
+/** Report that a bulk insert into an empty table is starting.
+Rollback of the TRX_UNDO_EMPTY record will empty the table.
+@param[in,out]	trx	transaction
+@param[in]	table	empty table, locked exclusively by trx
+@return	DB_SUCCESS or error code */
+dberr_t trx_undo_report_empty(trx_t* trx, dict_table_t* table)
+{
+	ut_ad(!trx->read_only);
+	ut_ad(trx->id);
+	ut_ad(!table->is_temporary());
+
+	mtr_t		mtr;
+	dberr_t		err;
+	mtr.start();
+	if (buf_block_t* block = trx_undo_assign(trx, &err, &mtr)) {
+		trx_undo_t*	undo = trx->rsegs.m_redo.undo;
+		ut_ad(err == DB_SUCCESS);
+		ut_ad(undo);
+		for (ut_d(int loop_count = 0);;) {
+			ut_ad(++loop_count < 2);
+			ut_ad(undo->last_page_no == block->page.id.page_no());
+
+			if (ulint offset = trx_undo_page_report_empty(
+				    trx, table, block, &mtr)) {
+				undo->withdraw_clock = buf_withdraw_clock;
+				undo->top_page_no = undo->last_page_no;
+				undo->top_offset  = offset;
+				undo->top_undo_no = trx->undo_no++;
+				undo->guess_block = block;
+				ut_ad(!undo->empty());
+
+				/* The rows will not be undo logged.
+				Register the table for
+				trx_update_mod_tables_timestamp(). */
+				trx->mod_tables.insert(
+					trx_mod_tables_t::value_type(
+						table, undo->top_undo_no));
+				err = DB_SUCCESS;
+				break;
+			} else {
+				mtr.commit();
+				mtr.start();
+				block = trx_undo_add_page(undo, &mtr);
+				if (!block) {
+					err = DB_OUT_OF_FILE_SPACE;
+					break;
+				}
+			}
+		}
+
+		mtr.commit();
+	}
+
+	return err;
+}
+
 /***********************************************************************//**
 Writes information to an undo log about an insert, update, or a delete marking
 of a clustered index record. This information is used in a rollback of the
@@ -530,6 +530,10 @@ trx_resurrect_table_locks(
 	page_t*			undo_page;
 	trx_undo_rec_t*		undo_rec;
 	table_id_set		tables;
+	/* tables that were bulk loaded while empty; rolling back
+	TRX_UNDO_EMPTY will empty them, so they must be locked
+	exclusively until then */
+	table_id_set		empty_tables;
 
 	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE) ||
 	      trx_state_eq(trx, TRX_STATE_PREPARED));
@@ -568,6 +572,10 @@ trx_resurrect_table_locks(
 			&updated_extern, &undo_no, &table_id);
 		tables.insert(table_id);
 
+		if (type == TRX_UNDO_EMPTY) {
+			empty_tables.insert(table_id);
+		}
+
 		undo_rec = trx_undo_get_prev_rec(
 			undo_rec, undo->hdr_page_no,
 			undo->hdr_offset, false, &mtr);
@@ -592,11 +600,16 @@ trx_resurrect_table_locks(
 					trx_mod_tables_t::value_type(table,
 								     0));
 			}
-			lock_table_ix_resurrect(table, trx);
+			const bool	empty = empty_tables.find(*i)
+				!= empty_tables.end();
+
+			lock_table_resurrect(table, trx,
+					     empty ? LOCK_X : LOCK_IX);
 
 			DBUG_LOG("ib_trx",
 				 "resurrect " << ib::hex(trx->id)
-				 << " IX lock on " << table->name);
+				 << (empty ? " X" : " IX")
+				 << " lock on " << table->name);
 
 			dict_table_close(table, FALSE, FALSE);
 		}
@@ -1899,7 +1912,7 @@ trx_print_low(
 
 /**********************************************************************//**
 Prints info about a transaction.
-The caller must hold lock_sys.mutex.
+The caller must hold lock_sys.latch.
 When possible, use trx_print() instead. */
 void
 trx_print_latched(
@@ -1919,7 +1932,7 @@ trx_print_latched(
 
 /**********************************************************************//**
 Prints info about a transaction.
-Acquires and releases lock_sys.mutex. */
+Acquires and releases lock_sys.latch. */
 void
 trx_print(
 /*======*/
@@ -2217,7 +2230,7 @@ static my_bool trx_get_trx_by_xid_callback(rw_trx_hash_element_t *element,
 /**
   Finds PREPARED XA transaction by xid.
 
-  trx may have been committed, unless the caller is holding lock_sys.mutex.
+  trx may have been committed, unless the caller is holding lock_sys.latch.
 
   @param[in]  xid  X/Open XA transaction identifier
 
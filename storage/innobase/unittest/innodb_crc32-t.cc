@@ -0,0 +1,229 @@
+/*****************************************************************************
+
+Copyright (c) 2019, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file unittest/innodb_crc32-t.cc
+Known-answer test of ut_crc32().
+
+ut_crc32() is compared to a byte-wise CRC-32C for every length up to
+a few pages of the 3-way path, from every misaligned start, and around
+the block lengths where ut_crc32_hw() switches between the interleaved
+and the sequential loops.
+*******************************************************/
+
+#include "univ.i"
+#include "ut0crc32.h"
+#include "ut0byte.h"
+
+#include <my_sys.h>
+#include <tap.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/** The reflected CRC-32C polynomial */
+static const uint32_t	CRC32C_POLY = 0x82f63b78;
+
+/** Length of the interleaved blocks of ut_crc32_hw() */
+static const ulint	CRC32_LONG = 4096;
+/** Length of the shorter interleaved blocks of ut_crc32_hw() */
+static const ulint	CRC32_SHORT = 256;
+
+/** Lengths to test exhaustively from every start offset */
+static const ulint	MAX_LEN = 4096;
+/** Number of lengths to test on both sides of a block boundary */
+static const ulint	AROUND = 16;
+/** Block boundaries of the 3-way path */
+static const ulint	boundaries[] = {
+	3 * CRC32_SHORT,
+	2 * 3 * CRC32_SHORT,
+	3 * CRC32_LONG,
+	3 * CRC32_LONG + 3 * CRC32_SHORT,
+	2 * 3 * CRC32_LONG,
+	2 * 3 * CRC32_LONG + 3 * CRC32_SHORT
+};
+
+/** Size of the test buffer */
+static const ulint	BUF_LEN = 2 * 3 * CRC32_LONG + 3 * CRC32_SHORT
+	+ AROUND + 8;
+
+/** Update a CRC-32C one byte at a time, one bit at a time.
+@param[in]	crc	CRC so far, not inverted
+@param[in]	b	byte
+@return the updated CRC, not inverted */
+static
+uint32_t
+crc32c_byte(
+	uint32_t	crc,
+	byte		b)
+{
+	crc ^= b;
+
+	for (int i = 0; i < 8; i++) {
+		crc = (crc >> 1) ^ (CRC32C_POLY & (0U - (crc & 1)));
+	}
+
+	return(crc);
+}
+
+/** Compute a CRC-32C byte by byte.
+@param[in]	buf	data
+@param[in]	len	length of the data
+@return CRC-32C of the data */
+static
+uint32_t
+crc32c_ref(
+	const byte*	buf,
+	ulint		len)
+{
+	uint32_t	crc = 0xFFFFFFFFU;
+
+	while (len--) {
+		crc = crc32c_byte(crc, *buf++);
+	}
+
+	return(~crc);
+}
+
+/** Compare ut_crc32() to crc32c_ref() for every length up to MAX_LEN.
+@param[in]	buf	data, 8-byte aligned
+@param[in]	offset	start offset from buf
+@return whether all lengths matched */
+static
+bool
+test_all_lengths(
+	const byte*	buf,
+	ulint		offset)
+{
+	const byte*	start = buf + offset;
+	uint32_t	crc = 0xFFFFFFFFU;
+
+	for (ulint len = 0;; len++) {
+		uint32_t	c = ut_crc32(start, len);
+
+		if (c != ~crc) {
+			diag("offset %lu length %lu: %08x, expected %08x",
+			     offset, len, c, ~crc);
+			return(false);
+		}
+
+		if (len == MAX_LEN) {
+			return(true);
+		}
+
+		crc = crc32c_byte(crc, start[len]);
+	}
+}
+
+/** Compare ut_crc32() to crc32c_ref() around a block boundary,
+from every start offset.
+@param[in]	buf		data, 8-byte aligned
+@param[in]	boundary	length of data where the loops switch
+@return whether all lengths matched */
+static
+bool
+test_boundary(
+	const byte*	buf,
+	ulint		boundary)
+{
+	for (ulint offset = 0; offset < 8; offset++) {
+		const byte*	start = buf + offset;
+		ulint		len = boundary - AROUND;
+		uint32_t	crc = ~crc32c_ref(start, len);
+
+		for (;; len++) {
+			uint32_t	c = ut_crc32(start, len);
+
+			if (c != ~crc) {
+				diag("offset %lu length %lu: %08x,"
+				     " expected %08x", offset, len, c, ~crc);
+				return(false);
+			}
+
+			if (len == boundary + AROUND) {
+				break;
+			}
+
+			crc = crc32c_byte(crc, start[len]);
+		}
+	}
+
+	return(true);
+}
+
+int main(int, char** argv)
+{
+	MY_INIT(argv[0]);
+
+	plan(5 + 8 + int(UT_ARR_SIZE(boundaries)));
+
+	ut_crc32_init();
+	diag("%s", ut_crc32_implementation);
+
+	/* Check the reference against the published check value and
+	the test vectors of RFC 3720 B.4. */
+	byte	v[32];
+
+	ok(crc32c_ref(reinterpret_cast<const byte*>("123456789"), 9)
+	   == 0xe3069283, "reference check value");
+
+	memset(v, 0, sizeof v);
+	ok(ut_crc32(v, sizeof v) == 0x8a9136aa
+	   && crc32c_ref(v, sizeof v) == 0x8a9136aa, "32 bytes of zeroes");
+
+	memset(v, 0xff, sizeof v);
+	ok(ut_crc32(v, sizeof v) == 0x62a8ab43
+	   && crc32c_ref(v, sizeof v) == 0x62a8ab43, "32 bytes of ones");
+
+	for (ulint i = 0; i < sizeof v; i++) {
+		v[i] = byte(i);
+	}
+	ok(ut_crc32(v, sizeof v) == 0x46dd794e
+	   && crc32c_ref(v, sizeof v) == 0x46dd794e, "32 incrementing bytes");
+
+	for (ulint i = 0; i < sizeof v; i++) {
+		v[i] = byte(31 - i);
+	}
+	ok(ut_crc32(v, sizeof v) == 0x113fdb5c
+	   && crc32c_ref(v, sizeof v) == 0x113fdb5c, "32 decrementing bytes");
+
+	byte*	raw = static_cast<byte*>(malloc(BUF_LEN + 64));
+	byte*	buf = static_cast<byte*>(ut_align(raw, 64));
+	uint32_t	rnd = 1;
+
+	for (ulint i = 0; i < BUF_LEN; i++) {
+		rnd = rnd * 1103515245 + 12345;
+		buf[i] = byte(rnd >> 16);
+	}
+
+	for (ulint offset = 0; offset < 8; offset++) {
+		ok(test_all_lengths(buf, offset),
+		   "lengths 0 to %lu from offset %lu", MAX_LEN, offset);
+	}
+
+	for (ulint i = 0; i < UT_ARR_SIZE(boundaries); i++) {
+		ok(test_boundary(buf, boundaries[i]),
+		   "lengths %lu to %lu", boundaries[i] - AROUND,
+		   boundaries[i] + AROUND);
+	}
+
+	free(raw);
+
+	my_end(0);
+	return(exit_status());
+}